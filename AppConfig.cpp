@@ -0,0 +1,130 @@
+#include "AppConfig.h"
+#include "ValidationSink.h"
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+
+AppConfig AppConfig::FromCommandLine( int argc, char** argv )
+{
+	AppConfig config;
+	if( const char* device = std::getenv( "VULKAN_DEVICE" ) )
+		config.deviceOverride = device;
+
+	auto nextValue = [&]( int& i ) -> const char*
+	{
+		if( i + 1 >= argc )
+			throw std::runtime_error( std::string( "Missing value for " ) + argv[i] );
+		return argv[++i];
+	};
+
+	bool readbackPathSet = false;
+	for( int i = 1; i < argc; ++i )
+	{
+		if( std::strcmp( argv[i], "--headless" ) == 0 )
+			config.headless = true;
+		else if( std::strcmp( argv[i], "--frames" ) == 0 )
+			config.frameCount = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--readback" ) == 0 )
+			config.readbackFrame = std::stoll( nextValue( i ) );
+		else if( std::strcmp( argv[i], "--readback-path" ) == 0 )
+		{
+			config.readbackPath = nextValue( i );
+			readbackPathSet = true;
+		}
+		else if( std::strcmp( argv[i], "--device" ) == 0 )
+			config.deviceOverride = nextValue( i );
+		else if( std::strcmp( argv[i], "--frames-in-flight" ) == 0 )
+			config.framesInFlight = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--present-policy" ) == 0 )
+			config.presentPolicy = ParsePresentPolicy( nextValue( i ) );
+		else if( std::strcmp( argv[i], "--max-fps" ) == 0 )
+			config.maxFps = std::stod( nextValue( i ) );
+		else if( std::strcmp( argv[i], "--validation-severity" ) == 0 )
+			config.validationSeverities = ParseValidationSeverities( nextValue( i ) );
+		else if( std::strcmp( argv[i], "--validation-types" ) == 0 )
+			config.validationTypes = ParseValidationTypes( nextValue( i ) );
+		else if( std::strcmp( argv[i], "--validation-repeat" ) == 0 )
+			config.validationRepeatLimit = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--pipeline-cache" ) == 0 )
+			config.pipelineCachePath = nextValue( i );
+		else if( std::strcmp( argv[i], "--no-pipeline-cache" ) == 0 )
+			config.pipelineCachePath.clear();
+		else if( std::strcmp( argv[i], "--pipeline-threads" ) == 0 )
+			config.pipelineBuildThreads = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--pipeline-build-report" ) == 0 )
+			config.pipelineBuildReport = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--instances" ) == 0 )
+			config.instanceCount = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--draw-calls" ) == 0 )
+			config.drawCalls = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--mesh-triangles" ) == 0 )
+			config.meshTriangles = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--mesh" ) == 0 )
+			config.meshPath = nextValue( i );
+		else if( std::strcmp( argv[i], "--lod-threshold" ) == 0 )
+			config.lodThreshold = std::stof( nextValue( i ) );
+		else if( std::strcmp( argv[i], "--gpu-cull" ) == 0 )
+			config.gpuCull = true;
+		else if( std::strcmp( argv[i], "--no-bindless" ) == 0 )
+			config.bindless = false;
+		else if( std::strcmp( argv[i], "--uniform-ring-kb" ) == 0 )
+			config.uniformRingKB = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--texture-dir" ) == 0 )
+			config.textureDir = nextValue( i );
+		else if( std::strcmp( argv[i], "--texture-budget" ) == 0 )
+			config.textureBudgetMB = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--texture-threads" ) == 0 )
+			config.textureThreads = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--record-threads" ) == 0 )
+			config.recordThreads = static_cast<uint32_t>( std::stoul( nextValue( i ) ) );
+		else if( std::strcmp( argv[i], "--record-benchmark" ) == 0 )
+			config.recordBenchmarkDraws = std::stoull( nextValue( i ) );
+		else if( std::strcmp( argv[i], "--gpu-profile" ) == 0 )
+			config.gpuProfilePath = nextValue( i );
+		else if( std::strcmp( argv[i], "--bench-report" ) == 0 )
+			config.benchReportPath = nextValue( i );
+		else if( std::strcmp( argv[i], "--cpu-trace" ) == 0 )
+			config.cpuTracePath = nextValue( i );
+		else if( std::strcmp( argv[i], "--render-graph-dump" ) == 0 )
+			config.renderGraphDumpPath = nextValue( i );
+		else if( std::strcmp( argv[i], "--render-graph-test" ) == 0 )
+			config.renderGraphTest = true;
+		else if( std::strcmp( argv[i], "--no-host-allocator" ) == 0 )
+			config.hostAllocator = false;
+		else if( std::strcmp( argv[i], "--host-alloc-report" ) == 0 )
+			config.hostAllocatorReport = true;
+		else if( std::strcmp( argv[i], "--stress-allocator" ) == 0 )
+			config.allocatorStressOps = std::stoull( nextValue( i ) );
+		else
+			throw std::runtime_error( std::string( "Unknown argument: " ) + argv[i] );
+	}
+
+	// low-latency: CPU tidak boleh jalan duluan, input frame berikutnya baru di-sample setelah frame ini selesai di GPU
+	if( config.presentPolicy == PresentPolicy::LowLatency )
+		config.framesInFlight = 1;
+
+	if( config.framesInFlight < 1 || config.framesInFlight > MaxFramesInFlight )
+		throw std::runtime_error( "--frames-in-flight must be between 1 and " + std::to_string( MaxFramesInFlight ) );
+
+	// readback cuma dari target offscreen mode headless, di mode window opsinya tidak dipakai sama sekali
+	if( !config.headless && ( config.readbackFrame >= 0 || readbackPathSet ) )
+		throw std::runtime_error( "--readback and --readback-path require --headless" );
+
+	if( config.headless && config.readbackFrame >= static_cast<int64_t>( config.frameCount ) )
+		throw std::runtime_error( "--readback frame must be smaller than --frames" );
+
+	// index buffer nya uint16: center + meshTriangles + 1 vertex
+	if( config.meshTriangles < 1 || config.meshTriangles > 65534 )
+		throw std::runtime_error( "--mesh-triangles must be between 1 and 65534" );
+
+	if( config.drawCalls < 1 )
+		throw std::runtime_error( "--draw-calls must be at least 1" );
+
+	if( config.uniformRingKB < 1 )
+		throw std::runtime_error( "--uniform-ring-kb must be at least 1" );
+
+	if( !( config.lodThreshold >= 0.0f ) )
+		throw std::runtime_error( "--lod-threshold must not be negative" );
+
+	return config;
+}
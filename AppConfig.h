@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "PresentPolicy.h"
+
+struct AppConfig
+{
+public:
+	static AppConfig FromCommandLine( int argc, char** argv );
+
+public:
+	// --- HEADLESS ---
+	// tanpa GLFW window dan tanpa surface, render ke VkImage offscreen (buat CI / lavapipe)
+	bool headless = false;
+	uint32_t frameCount = 3;				// jumlah frame yang di render di headless mode
+	int64_t readbackFrame = -1;				// frame ke-N yang di copy ke file, -1 = tidak ada readback
+	std::string readbackPath = "frame.ppm";
+	// ----------------
+
+	// --- DEVICE SELECTION ---
+	// kosong = device dengan score tertinggi, angka = index vkEnumeratePhysicalDevices, selain itu = potongan nama device
+	// default dari env VULKAN_DEVICE, --device menimpa
+	std::string deviceOverride;
+	// ------------------------
+
+	// --- FRAME LOOP ---
+	// lebih banyak frame in flight = throughput naik, latency juga naik
+	uint32_t framesInFlight = 2;
+	static constexpr uint32_t MaxFramesInFlight = 3;
+	// ------------------
+
+	// --- PRESENTATION ---
+	PresentPolicy presentPolicy = PresentPolicy::Throughput;	// low-latency memaksa framesInFlight = 1
+	double maxFps = 0.0;					// frame limiter, 0 = tanpa limit
+	// --------------------
+
+	// --- VALIDATION ---
+	// cuma berlaku di build tanpa NDEBUG (validation layer aktif), lihat ValidationSink
+	VkDebugUtilsMessageSeverityFlagsEXT validationSeverities = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+	VkDebugUtilsMessageTypeFlagsEXT validationTypes = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+	uint32_t validationRepeatLimit = 3;		// pesan dengan id yang sama ditulis sekian kali, sisanya cuma dihitung
+	// ------------------
+
+	// --- PIPELINE CACHE ---
+	std::string pipelineCachePath = "pipeline_cache.bin";	// kosong = tidak pakai cache di disk
+	// ----------------------
+
+	// --- PIPELINE BUILD ---
+	uint32_t pipelineBuildThreads = 0;		// 0 = std::thread::hardware_concurrency()
+	uint32_t pipelineBuildReport = 0;		// > 0: build sekian varian pipeline serial vs paralel, lalu print waktunya
+	// ----------------------
+
+	// --- GEOMETRY ---
+	uint32_t instanceCount = 1;				// jumlah instance mesh
+	uint32_t drawCalls = 1;					// instance dibagi rata ke sekian vkCmdDrawIndexed
+	uint32_t meshTriangles = 1;				// 1 = segitiga semula, > 1 = lingkaran (triangle fan) dengan sekian segitiga
+	bool gpuCull = false;					// frustum culling per instance di compute shader + indirect draw (butuh Shaders/cull.spv)
+	std::string meshPath;					// tidak kosong = file .mesh (Tools/MeshConverter) menggantikan segitiga / lingkaran
+	float lodThreshold = 1.0f;				// --mesh: LOD paling kasar yang error nya di layar <= sekian pixel, 0 = selalu LOD 0
+	// ----------------
+
+	// --- DESCRIPTORS ---
+	// true = bindless kalau device support descriptor indexing, selain itu (atau --no-bindless) set klasik per frame
+	bool bindless = true;
+	uint32_t uniformRingKB = 64;			// uniform/storage ring per frame in flight (set 1, dynamic offset)
+	// -------------------
+
+	// --- TEXTURES ---
+	// tidak kosong = semua .ppm / .tga di folder ini di-stream (decode di worker thread, mip di GPU)
+	std::string textureDir;
+	uint32_t textureBudgetMB = 256;			// image full resolusi di atas budget ini di-evict (LRU), tail kecil tidak dihitung
+	uint32_t textureThreads = 0;			// thread decode, 0 = hardware_concurrency() - 1
+	// ----------------
+
+	// --- COMMAND RECORDING ---
+	uint32_t recordThreads = 0;				// 0 = record langsung di primary, > 0 = secondary paralel dengan sekian thread
+	uint64_t recordBenchmarkDraws = 0;		// > 0: benchmark recording sekian draw, bukan render loop
+	// -------------------------
+
+	// --- PROFILING ---
+	std::string gpuProfilePath;				// tidak kosong = timestamp per pass, ditulis ke file ini (.json / .csv) saat keluar
+	std::string benchReportPath;			// tidak kosong = startup per fase, frame time, memory ditulis ke file ini (JSON)
+	std::string cpuTracePath;				// tidak kosong = CPU zone ditulis ke file ini (trace_event JSON), hanya build tanpa NDEBUG
+	std::string renderGraphDumpPath;		// tidak kosong = hasil compile render graph (pass, barrier, aliasing) ditulis ke file ini
+	bool renderGraphTest = false;			// self test render graph (aliasing + barrier alias) di device ini, bukan render loop
+	// -----------------
+
+	// --- DEVICE MEMORY ---
+	uint64_t allocatorStressOps = 0;		// > 0: jalankan stress test allocator sekian operasi, bukan render loop
+	// ---------------------
+
+	// --- HOST MEMORY ---
+	bool hostAllocator = true;				// false (--no-host-allocator) = VkAllocationCallbacks nullptr, allocator bawaan driver
+	bool hostAllocatorReport = false;		// counter per scope + peak + leak dicetak saat keluar
+	// -------------------
+};
@@ -0,0 +1,68 @@
+#!/bin/sh
+# Benchmark headless: startup cold/warm per fase, frame time, memory, untuk beberapa ukuran scene.
+# Hasilnya satu file JSON (default bench_results.json) yang bisa dibandingkan dengan Bench/compare.py.
+# Dipanggil dari `make bench`.
+# usage: sh Bench/bench.sh [output.json]
+#
+# env:
+#   BIN     binary yang dijalankan (default ./VulkanBench)
+#   FRAMES  jumlah frame per run (default 300)
+#   SCENES  daftar "instances:drawCalls:meshTriangles" dipisah spasi
+#   VK_ICD_FILENAMES / VK_DRIVER_FILES  kalau kosong, pakai lavapipe kalau ketemu
+
+set -e
+
+BIN=${BIN:-./VulkanBench}
+FRAMES=${FRAMES:-300}
+SCENES=${SCENES:-"1:1:1 1024:1:1 1024:256:1 4096:64:64 16384:1024:16"}
+OUT=${1:-bench_results.json}
+
+# hasil harus bisa dibandingkan antar mesin: pakai lavapipe (software) kecuali driver sudah dipilih
+if [ -z "$VK_ICD_FILENAMES" ] && [ -z "$VK_DRIVER_FILES" ]; then
+	for icd in /usr/share/vulkan/icd.d/lvp_icd*.json /etc/vulkan/icd.d/lvp_icd*.json; do
+		if [ -f "$icd" ]; then
+			VK_ICD_FILENAMES=$icd
+			VK_DRIVER_FILES=$icd
+			export VK_ICD_FILENAMES VK_DRIVER_FILES
+			break
+		fi
+	done
+fi
+echo "bench: driver ${VK_DRIVER_FILES:-${VK_ICD_FILENAMES:-(system default)}}"
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+COMMIT=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+{
+	echo "{"
+	echo "\"commit\": \"$COMMIT\", \"frames\": $FRAMES,"
+	echo "\"runs\": ["
+} > "$WORK/results.json"
+
+first=1
+for scene in $SCENES; do
+	instances=$(echo "$scene" | cut -d: -f1)
+	draws=$(echo "$scene" | cut -d: -f2)
+	triangles=$(echo "$scene" | cut -d: -f3)
+
+	# cold: pipeline cache dihapus dulu, warm: cache dari run cold barusan
+	rm -f "$WORK/pipeline_cache.bin"
+	for startup in cold warm; do
+		name="i${instances}_d${draws}_t${triangles}_${startup}"
+		echo "bench: $name"
+		"$BIN" --headless --frames "$FRAMES" --instances "$instances" --draw-calls "$draws" --mesh-triangles "$triangles" \
+			--pipeline-cache "$WORK/pipeline_cache.bin" --bench-report "$WORK/$name.json" > "$WORK/$name.log" 2>&1 \
+			|| { cat "$WORK/$name.log"; exit 1; }
+
+		[ $first -eq 1 ] || echo "," >> "$WORK/results.json"
+		first=0
+		echo "{ \"name\": \"$name\", \"report\":" >> "$WORK/results.json"
+		cat "$WORK/$name.json" >> "$WORK/results.json"
+		echo "}" >> "$WORK/results.json"
+	done
+done
+
+echo "]}" >> "$WORK/results.json"
+cp "$WORK/results.json" "$OUT"
+echo "bench: results written to $OUT"
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+# Bandingkan dua hasil Bench/bench.sh, exit 1 kalau ada metrik yang lebih buruk dari threshold.
+# usage: python3 Bench/compare.py baseline.json current.json [threshold_percent=10]
+
+import json
+import sys
+
+# (section, key, lebih besar = lebih baik)
+METRICS = [
+	( "startup", "totalMs", False ),
+	( "frames", "fps", True ),
+	( "frames", "p50Ms", False ),
+	( "frames", "p99Ms", False ),
+	( "memory", "devicePeakBytes", False ),
+	( "memory", "hostPeakBytes", False ),
+]
+
+
+def load( path ):
+	with open( path ) as f:
+		return { run["name"]: run["report"] for run in json.load( f )["runs"] }
+
+
+def main():
+	if len( sys.argv ) < 3:
+		print( "usage: compare.py baseline.json current.json [threshold_percent]" )
+		return 2
+
+	baseline = load( sys.argv[1] )
+	current = load( sys.argv[2] )
+	threshold = float( sys.argv[3] ) if len( sys.argv ) > 3 else 10.0
+
+	regressions = 0
+	for name in sorted( set( baseline ) & set( current ) ):
+		for section, key, higherIsBetter in METRICS:
+			old = baseline[name][section][key]
+			new = current[name][section][key]
+			if old == 0:
+				continue
+			change = ( new - old ) / old * 100.0
+			worse = -change if higherIsBetter else change
+			flag = ""
+			if worse > threshold:
+				flag = "  <-- REGRESSION"
+				regressions += 1
+			print( f"{name:28} {section}.{key:16} {old:14.3f} -> {new:14.3f} ({change:+6.1f}%){flag}" )
+
+	missing = set( baseline ) ^ set( current )
+	if missing:
+		print( "runs only in one file: " + ", ".join( sorted( missing ) ) )
+
+	print( f"{regressions} regression(s) above {threshold}%" )
+	return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+	sys.exit( main() )
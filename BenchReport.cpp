@@ -0,0 +1,93 @@
+#include "BenchReport.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#if defined( __unix__ )
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	// nearest-rank, values harus sudah urut
+	double Percentile( const std::vector<double>& values, double p )
+	{
+		if( values.empty() )
+			return 0.0;
+		const size_t rank = static_cast<size_t>( p / 100.0 * static_cast<double>( values.size() - 1 ) + 0.5 );
+		return values[std::min( rank, values.size() - 1 )];
+	}
+
+	// 0 kalau platform nya tidak didukung
+	uint64_t PeakHostMemoryBytes()
+	{
+#if defined( __unix__ )
+		rusage usage{};
+		if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+			return static_cast<uint64_t>( usage.ru_maxrss ) * 1024;	// Linux: kilobyte
+#endif
+		return 0;
+	}
+}
+
+void BenchReport::Start()
+{
+	start = lastMark = Clock::now();
+	phases.clear();
+	frameTimes.clear();
+	loopMs = 0.0;
+}
+
+void BenchReport::Mark( const char* phase )
+{
+	const auto now = Clock::now();
+	const std::chrono::duration<double, std::milli> elapsed = now - lastMark;
+	phases.emplace_back( phase, elapsed.count() );
+	lastMark = now;
+}
+
+void BenchReport::WriteJson( std::ostream& out, const BenchScene& scene, const DeviceAllocatorStats& memory ) const
+{
+	double startupMs = 0.0;
+	for( const auto& phase : phases )
+		startupMs += phase.second;
+
+	// frame pertama (pipeline/driver warm-up) tidak ikut statistik steady state
+	std::vector<double> sorted( frameTimes.size() > 1 ? frameTimes.begin() + 1 : frameTimes.end(), frameTimes.end() );
+	std::sort( sorted.begin(), sorted.end() );
+	double sum = 0.0;
+	for( double ms : sorted )
+		sum += ms;
+	const double avgMs = sorted.empty() ? 0.0 : sum / static_cast<double>( sorted.size() );
+
+	out << "{\n"
+		<< "\t\"scene\": { \"device\": \"" << scene.deviceName << "\", \"instances\": " << scene.instances
+		<< ", \"drawCalls\": " << scene.drawCalls << ", \"triangles\": " << scene.triangles
+		<< ", \"framesInFlight\": " << scene.framesInFlight << ", \"recordThreads\": " << scene.recordThreads
+		<< ", \"gpuCull\": " << ( scene.gpuCull ? "true" : "false" ) << " },\n";
+
+	out << "\t\"startup\": { \"pipelineCache\": \"" << ( scene.pipelineCacheWarm ? "warm" : "cold" ) << "\", \"totalMs\": " << startupMs << ", \"phases\": {";
+	for( size_t i = 0; i < phases.size(); ++i )
+		out << ( i == 0 ? " " : ", " ) << "\"" << phases[i].first << "\": " << phases[i].second;
+	out << " } },\n";
+
+	out << "\t\"frames\": { \"count\": " << frameTimes.size()
+		<< ", \"firstMs\": " << ( frameTimes.empty() ? 0.0 : frameTimes.front() )
+		<< ", \"fps\": " << ( loopMs > 0.0 ? static_cast<double>( frameTimes.size() ) * 1000.0 / loopMs : 0.0 )
+		<< ", \"avgMs\": " << avgMs << ", \"p50Ms\": " << Percentile( sorted, 50.0 )
+		<< ", \"p95Ms\": " << Percentile( sorted, 95.0 ) << ", \"p99Ms\": " << Percentile( sorted, 99.0 )
+		<< ", \"maxMs\": " << ( sorted.empty() ? 0.0 : sorted.back() ) << " },\n";
+
+	out << "\t\"memory\": { \"devicePeakBytes\": " << memory.peakUsedBytes << ", \"deviceBlockBytes\": " << memory.blockBytes
+		<< ", \"hostPeakBytes\": " << PeakHostMemoryBytes() << " }\n"
+		<< "}\n";
+}
+
+void BenchReport::WriteFile( const std::string& path, const BenchScene& scene, const DeviceAllocatorStats& memory ) const
+{
+	std::ofstream out( path );
+	if( !out )
+		throw std::runtime_error( "Failed to open bench report " + path );
+
+	WriteJson( out, scene, memory );
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DeviceAllocator.h"
+
+// Keterangan run yang ikut ditulis ke report, supaya dua report bisa dibandingkan
+struct BenchScene
+{
+public:
+	std::string deviceName;
+	uint32_t instances = 0;
+	uint32_t drawCalls = 0;
+	uint64_t triangles = 0;
+	uint32_t framesInFlight = 0;
+	uint32_t recordThreads = 0;
+	bool gpuCull = false;
+	bool pipelineCacheWarm = false;
+};
+
+// Hasil benchmark satu run: waktu startup per fase, frame time, memory high-water.
+// Tidak tergantung CpuTrace, jadi tetap jalan di build NDEBUG.
+class BenchReport
+{
+public:
+	void Start();
+	// waktu fase = sejak Mark() sebelumnya (atau Start())
+	void Mark( const char* phase );
+
+	void AddFrame( double frameMs ) { frameTimes.push_back( frameMs ); }
+	// wall time seluruh loop termasuk vkDeviceWaitIdle di akhir, buat frames/sec
+	void SetLoopTime( double loopMs ) { this->loopMs = loopMs; }
+
+	void WriteJson( std::ostream& out, const BenchScene& scene, const DeviceAllocatorStats& memory ) const;
+	void WriteFile( const std::string& path, const BenchScene& scene, const DeviceAllocatorStats& memory ) const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point start;
+	Clock::time_point lastMark;
+	std::vector<std::pair<std::string, double>> phases;
+	std::vector<double> frameTimes;
+	double loopMs = 0.0;
+};
@@ -0,0 +1,321 @@
+#include "BindlessDescriptors.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "HostAllocator.h"
+
+void BindlessDescriptors::Init( VkDevice device, const VkPhysicalDeviceLimits& limits, bool descriptorIndexing,
+	DeviceAllocator& allocator, UploadManager& uploads, uint32_t framesInFlight, uint32_t maxTextures, uint32_t maxBuffers )
+{
+	this->device = device;
+	this->bindless = descriptorIndexing;
+	this->framesInFlight = framesInFlight;
+	this->allocator = &allocator;
+
+	// limit update-after-bind biasanya jauh lebih besar, tapi butuh vkGetPhysicalDeviceProperties2. Pakai limit klasik saja.
+	maxTextures = std::min( { maxTextures, limits.maxPerStageDescriptorSampledImages, limits.maxDescriptorSetSampledImages } );
+	maxBuffers = std::min( { maxBuffers, limits.maxPerStageDescriptorStorageBuffers, limits.maxDescriptorSetStorageBuffers } );
+	// fallback: tiap perubahan menulis ulang seluruh array, jadi dibatasi lebih kecil
+	if( !bindless )
+	{
+		maxTextures = std::min( maxTextures, 1024U );
+		maxBuffers = std::min( maxBuffers, 1024U );
+	}
+	textures.assign( maxTextures, { VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED } );
+	buffers.assign( maxBuffers, VkDescriptorBufferInfo{ VK_NULL_HANDLE, 0, 0 } );
+
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_LINEAR;
+	samplerInfo.minFilter = VK_FILTER_LINEAR;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+	if( vkCreateSampler( device, &samplerInfo, HostAllocator::Callbacks(), &linearSampler ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create sampler!" );
+
+	// Set layout
+	// ----------
+	VkDescriptorSetLayoutBinding bindings[3]{};
+	bindings[0].binding = TextureBinding;
+	bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	bindings[0].descriptorCount = maxTextures;
+	bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+	bindings[1].binding = SamplerBinding;
+	bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+	bindings[1].descriptorCount = 1;
+	bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+	bindings[1].pImmutableSamplers = &linearSampler;
+	bindings[2].binding = BufferBinding;
+	bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	bindings[2].descriptorCount = maxBuffers;
+	bindings[2].stageFlags = VK_SHADER_STAGE_ALL;
+
+	// UNUSED_WHILE_PENDING: slot yang tidak dibaca frame yang sedang jalan boleh diupdate kapan saja
+	const VkDescriptorBindingFlagsEXT arrayFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+		VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+	const VkDescriptorBindingFlagsEXT bindingFlags[3] = { arrayFlags, 0, arrayFlags };
+
+	VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo{};
+	bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+	bindingFlagsInfo.bindingCount = 3;
+	bindingFlagsInfo.pBindingFlags = bindingFlags;
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = 3;
+	layoutInfo.pBindings = bindings;
+	if( bindless )
+	{
+		layoutInfo.pNext = &bindingFlagsInfo;
+		layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+	}
+	if( vkCreateDescriptorSetLayout( device, &layoutInfo, HostAllocator::Callbacks(), &layout ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create bindless descriptor set layout!" );
+	// ----------
+
+	if( bindless )
+	{
+		const VkDescriptorPoolSize poolSizes[] = {
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, maxTextures },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER, 1 },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, maxBuffers }
+		};
+		VkDescriptorPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+		poolInfo.maxSets = 1;
+		poolInfo.poolSizeCount = 3;
+		poolInfo.pPoolSizes = poolSizes;
+		if( vkCreateDescriptorPool( device, &poolInfo, HostAllocator::Callbacks(), &pool ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create bindless descriptor pool!" );
+
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = pool;
+		allocInfo.descriptorSetCount = 1;
+		allocInfo.pSetLayouts = &layout;
+		if( vkAllocateDescriptorSets( device, &allocInfo, &set ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to allocate bindless descriptor set!" );
+	}
+	else
+	{
+		fallbackAllocator.Init( device, framesInFlight, {
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, maxTextures * framesInFlight },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER, framesInFlight },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, maxBuffers * framesInFlight } } );
+		for( uint32_t i = 0; i < framesInFlight; ++i )
+			frameSets.push_back( fallbackAllocator.Allocate( layout ) );
+		// belum pernah ditulis: tiap set ditulis di BeginFrame pertama nya
+		frameSetVersions.assign( framesInFlight, UINT64_MAX );
+		CreateDummyResources( allocator, uploads );
+	}
+
+	std::cout << "descriptors: " << ( bindless ? "bindless (descriptor indexing)" : "fallback (classic set per frame)" )
+		<< ", " << maxTextures << " textures, " << maxBuffers << " buffers" << std::endl;
+}
+
+void BindlessDescriptors::CleanUp()
+{
+	if( bindless )
+		vkDestroyDescriptorPool( device, pool, HostAllocator::Callbacks() );
+	else
+	{
+		fallbackAllocator.CleanUp();
+		vkDestroyImageView( device, dummyView, HostAllocator::Callbacks() );
+		vkDestroyImage( device, dummyImage, HostAllocator::Callbacks() );
+		allocator->Free( dummyImageMemory );
+		vkDestroyBuffer( device, dummyBuffer, HostAllocator::Callbacks() );
+		allocator->Free( dummyBufferMemory );
+	}
+	vkDestroyDescriptorSetLayout( device, layout, HostAllocator::Callbacks() );
+	vkDestroySampler( device, linearSampler, HostAllocator::Callbacks() );
+
+	pool = VK_NULL_HANDLE;
+	set = VK_NULL_HANDLE;
+	frameSets.clear();
+	layout = VK_NULL_HANDLE;
+	linearSampler = VK_NULL_HANDLE;
+}
+
+uint32_t BindlessDescriptors::Slots::Acquire( uint32_t capacity )
+{
+	if( !freeList.empty() )
+	{
+		const uint32_t index = freeList.back();
+		freeList.pop_back();
+		return index;
+	}
+	if( used == capacity )
+		throw std::runtime_error( "Bindless descriptor array is full!" );
+	return used++;
+}
+
+uint32_t BindlessDescriptors::AddTexture( VkImageView view, VkImageLayout imageLayout )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	const uint32_t index = textureSlots.Acquire( TextureCapacity() );
+	textures[index] = { view, imageLayout };
+	if( bindless )
+		WriteTexture( set, index, view, imageLayout );
+	++version;
+	return index;
+}
+
+uint32_t BindlessDescriptors::AddBuffer( VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	const uint32_t index = bufferSlots.Acquire( BufferCapacity() );
+	buffers[index] = { buffer, offset, range };
+	if( bindless )
+		WriteBuffer( set, index, buffers[index] );
+	++version;
+	return index;
+}
+
+void BindlessDescriptors::RemoveTexture( uint32_t index )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	textures[index] = { VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED };
+	textureSlots.pendingFree.emplace_back( frameCounter, index );
+	++version;
+}
+
+void BindlessDescriptors::RemoveBuffer( uint32_t index )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	buffers[index] = { VK_NULL_HANDLE, 0, 0 };
+	bufferSlots.pendingFree.emplace_back( frameCounter, index );
+	++version;
+}
+
+void BindlessDescriptors::BeginFrame( uint32_t frameIndex )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	++frameCounter;
+
+	// index yang di-remove framesInFlight frame lalu sudah tidak dibaca GPU lagi
+	for( Slots* slots : { &textureSlots, &bufferSlots } )
+	{
+		while( !slots->pendingFree.empty() && slots->pendingFree.front().first + framesInFlight < frameCounter )
+		{
+			slots->freeList.push_back( slots->pendingFree.front().second );
+			slots->pendingFree.pop_front();
+		}
+	}
+
+	if( !bindless && frameSetVersions[frameIndex] != version )
+		RewriteFallbackSet( frameIndex );
+}
+
+void BindlessDescriptors::Bind( VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t frameIndex ) const
+{
+	const VkDescriptorSet bound = bindless ? set : frameSets[frameIndex];
+	vkCmdBindDescriptorSets( commandBuffer, bindPoint, pipelineLayout, 0, 1, &bound, 0, nullptr );
+}
+
+void BindlessDescriptors::WriteTexture( VkDescriptorSet target, uint32_t index, VkImageView view, VkImageLayout imageLayout ) const
+{
+	VkDescriptorImageInfo imageInfo{};
+	imageInfo.imageView = view;
+	imageInfo.imageLayout = imageLayout;
+
+	VkWriteDescriptorSet write{};
+	write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.dstSet = target;
+	write.dstBinding = TextureBinding;
+	write.dstArrayElement = index;
+	write.descriptorCount = 1;
+	write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	write.pImageInfo = &imageInfo;
+	vkUpdateDescriptorSets( device, 1, &write, 0, nullptr );
+}
+
+void BindlessDescriptors::WriteBuffer( VkDescriptorSet target, uint32_t index, const VkDescriptorBufferInfo& info ) const
+{
+	VkWriteDescriptorSet write{};
+	write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.dstSet = target;
+	write.dstBinding = BufferBinding;
+	write.dstArrayElement = index;
+	write.descriptorCount = 1;
+	write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	write.pBufferInfo = &info;
+	vkUpdateDescriptorSets( device, 1, &write, 0, nullptr );
+}
+
+void BindlessDescriptors::RewriteFallbackSet( uint32_t frameIndex )
+{
+	// tanpa PARTIALLY_BOUND semua elemen array harus valid: slot kosong diisi dummy
+	std::vector<VkDescriptorImageInfo> imageInfos( textures.size() );
+	for( size_t i = 0; i < textures.size(); ++i )
+	{
+		const bool empty = textures[i].first == VK_NULL_HANDLE;
+		imageInfos[i].imageView = empty ? dummyView : textures[i].first;
+		imageInfos[i].imageLayout = empty ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : textures[i].second;
+	}
+	std::vector<VkDescriptorBufferInfo> bufferInfos( buffers.size() );
+	for( size_t i = 0; i < buffers.size(); ++i )
+		bufferInfos[i] = buffers[i].buffer != VK_NULL_HANDLE ? buffers[i] : VkDescriptorBufferInfo{ dummyBuffer, 0, VK_WHOLE_SIZE };
+
+	VkWriteDescriptorSet writes[2]{};
+	writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writes[0].dstSet = frameSets[frameIndex];
+	writes[0].dstBinding = TextureBinding;
+	writes[0].descriptorCount = static_cast<uint32_t>( imageInfos.size() );
+	writes[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	writes[0].pImageInfo = imageInfos.data();
+	writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writes[1].dstSet = frameSets[frameIndex];
+	writes[1].dstBinding = BufferBinding;
+	writes[1].descriptorCount = static_cast<uint32_t>( bufferInfos.size() );
+	writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	writes[1].pBufferInfo = bufferInfos.data();
+	vkUpdateDescriptorSets( device, 2, writes, 0, nullptr );
+
+	frameSetVersions[frameIndex] = version;
+}
+
+void BindlessDescriptors::CreateDummyResources( DeviceAllocator& allocator, UploadManager& uploads )
+{
+	// 1x1 texel putih, layout nya diurus UploadManager (transisi ke SHADER_READ_ONLY di akhir upload)
+	VkImageCreateInfo imageInfo{};
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+	imageInfo.extent = { 1, 1, 1 };
+	imageInfo.mipLevels = 1;
+	imageInfo.arrayLayers = 1;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	if( vkCreateImage( device, &imageInfo, HostAllocator::Callbacks(), &dummyImage ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create dummy image!" );
+	dummyImageMemory = allocator.AllocateForImage( dummyImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = dummyImage;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewInfo.format = imageInfo.format;
+	viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+	if( vkCreateImageView( device, &viewInfo, HostAllocator::Callbacks(), &dummyView ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create dummy image view!" );
+
+	const uint32_t white = 0xffffffff;
+	uploads.UploadImage( dummyImage, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 }, imageInfo.extent, &white, sizeof( white ) );
+
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = 256;
+	bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	if( vkCreateBuffer( device, &bufferInfo, HostAllocator::Callbacks(), &dummyBuffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create dummy buffer!" );
+	dummyBufferMemory = allocator.AllocateForBuffer( dummyBuffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "DescriptorAllocator.h"
+#include "DeviceAllocator.h"
+#include "UploadManager.h"
+
+// Semua texture dan storage buffer dalam satu descriptor set (set 0):
+//   binding 0 = texture2D textures[]  (SAMPLED_IMAGE)
+//   binding 1 = sampler linearSampler (immutable)
+//   binding 2 = buffer buffers[]      (STORAGE_BUFFER)
+// Shader memilih resource lewat index (push constant / instance data), jadi set nya cukup di-bind
+// sekali per command buffer, tidak ada alokasi/bind descriptor per draw.
+//
+// Dengan VK_EXT_descriptor_indexing: satu set, UPDATE_AFTER_BIND + PARTIALLY_BOUND, diupdate di tempat.
+// Tanpa: fallback satu set klasik per frame in flight (dari DescriptorAllocator), slot kosong diisi
+// resource dummy, set frame itu ditulis ulang di BeginFrame() kalau ada perubahan.
+class BindlessDescriptors
+{
+public:
+	static constexpr uint32_t InvalidIndex = UINT32_MAX;
+	static constexpr uint32_t TextureBinding = 0;
+	static constexpr uint32_t SamplerBinding = 1;
+	static constexpr uint32_t BufferBinding = 2;
+
+	void Init( VkDevice device, const VkPhysicalDeviceLimits& limits, bool descriptorIndexing,
+		DeviceAllocator& allocator, UploadManager& uploads, uint32_t framesInFlight,
+		uint32_t maxTextures = 16384, uint32_t maxBuffers = 16384 );
+	void CleanUp();
+
+	bool IsBindless() const { return bindless; }
+	VkDescriptorSetLayout GetLayout() const { return layout; }
+
+	// index stabil sampai Remove*(), aman dipanggil dari thread mana saja.
+	// Isi slot yang sudah dipakai tidak pernah ditimpa (frame yang sedang jalan mungkin membaca nya):
+	// ganti resource = Add yang baru lalu Remove yang lama.
+	uint32_t AddTexture( VkImageView view, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL );
+	uint32_t AddBuffer( VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE );
+	// index baru dipakai ulang setelah framesInFlight frame (frame yang masih jalan mungkin masih membaca nya)
+	void RemoveTexture( uint32_t index );
+	void RemoveBuffer( uint32_t index );
+
+	// dipanggil setelah fence frame ini ditunggu, sekali per frame yang benar-benar di-submit
+	// (umur slot yang di-remove dihitung dari sini)
+	void BeginFrame( uint32_t frameIndex );
+	void Bind( VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t frameIndex ) const;
+
+	uint32_t TextureCapacity() const { return static_cast<uint32_t>( textures.size() ); }
+	uint32_t BufferCapacity() const { return static_cast<uint32_t>( buffers.size() ); }
+
+private:
+	// satu array (texture atau buffer): free list + index yang menunggu frame lama selesai
+	struct Slots
+	{
+		std::vector<uint32_t> freeList;
+		std::deque<std::pair<uint64_t, uint32_t>> pendingFree;	// (frame saat di-remove, index)
+		uint32_t used = 0;									// index tertinggi yang pernah dipakai + 1
+
+		uint32_t Acquire( uint32_t capacity );
+	};
+
+	void WriteTexture( VkDescriptorSet set, uint32_t index, VkImageView view, VkImageLayout imageLayout ) const;
+	void WriteBuffer( VkDescriptorSet set, uint32_t index, const VkDescriptorBufferInfo& info ) const;
+	void RewriteFallbackSet( uint32_t frameIndex );
+	void CreateDummyResources( DeviceAllocator& allocator, UploadManager& uploads );
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	bool bindless = false;
+	uint32_t framesInFlight = 1;
+
+	VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+	VkSampler linearSampler = VK_NULL_HANDLE;
+
+	// bindless: satu pool + satu set
+	VkDescriptorPool pool = VK_NULL_HANDLE;
+	VkDescriptorSet set = VK_NULL_HANDLE;
+
+	// --- FALLBACK ---
+	DescriptorAllocator fallbackAllocator;
+	std::vector<VkDescriptorSet> frameSets;
+	std::vector<uint64_t> frameSetVersions;
+	uint64_t version = 0;									// naik tiap ada perubahan
+	DeviceAllocator* allocator = nullptr;
+	VkImage dummyImage = VK_NULL_HANDLE;
+	DeviceAllocation dummyImageMemory;
+	VkImageView dummyView = VK_NULL_HANDLE;
+	VkBuffer dummyBuffer = VK_NULL_HANDLE;
+	DeviceAllocation dummyBufferMemory;
+	// ----------------
+
+	mutable std::mutex mutex;
+	uint64_t frameCounter = 0;
+	std::vector<std::pair<VkImageView, VkImageLayout>> textures;	// VK_NULL_HANDLE = kosong
+	std::vector<VkDescriptorBufferInfo> buffers;					// buffer VK_NULL_HANDLE = kosong
+	Slots textureSlots;
+	Slots bufferSlots;
+};
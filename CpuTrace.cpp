@@ -0,0 +1,164 @@
+#include "CpuTrace.h"
+
+#ifndef NDEBUG
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	struct Event
+	{
+		const char* name;
+		uint64_t startNs;
+		uint64_t endNs;
+	};
+
+	// Buffer satu thread: linked list chunk, cuma thread pemilik yang menulis.
+	// count dan next di-publish dengan release supaya Write() dari thread lain aman membaca.
+	struct Chunk
+	{
+		static constexpr uint32_t Capacity = 4096;
+		Event events[Capacity];
+		std::atomic<uint32_t> count{ 0 };
+		std::atomic<Chunk*> next{ nullptr };
+	};
+
+	struct ThreadBuffer
+	{
+		uint32_t threadId = 0;
+		std::string threadName;
+		Chunk* head = nullptr;
+		Chunk* tail = nullptr;
+		std::vector<std::unique_ptr<Chunk>> chunks;		// cuma buat ownership
+	};
+
+	std::atomic<bool> enabled{ false };
+	const auto epoch = std::chrono::steady_clock::now();
+
+	// registry cuma di-lock saat thread pertama kali mencatat zone (dan saat Write)
+	std::mutex registryMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+	ThreadBuffer& LocalBuffer()
+	{
+		// buffer dimiliki registry, jadi tetap hidup walaupun thread nya sudah selesai
+		thread_local ThreadBuffer* buffer = nullptr;
+		if( buffer == nullptr )
+		{
+			auto created = std::make_unique<ThreadBuffer>();
+			created->chunks.push_back( std::make_unique<Chunk>() );
+			created->head = created->tail = created->chunks.back().get();
+
+			std::lock_guard<std::mutex> lock( registryMutex );
+			created->threadId = static_cast<uint32_t>( registry.size() + 1 );
+			buffer = created.get();
+			registry.push_back( std::move( created ) );
+		}
+		return *buffer;
+	}
+
+	void WriteEscaped( std::ostream& out, const std::string& text )
+	{
+		for( char c : text )
+		{
+			if( c == '"' || c == '\\' )
+				out << '\\';
+			out << c;
+		}
+	}
+}
+
+void CpuTrace::Enable()
+{
+	enabled.store( true, std::memory_order_relaxed );
+}
+
+bool CpuTrace::IsEnabled()
+{
+	return enabled.load( std::memory_order_relaxed );
+}
+
+void CpuTrace::SetThreadName( const char* name )
+{
+	LocalBuffer().threadName = name;
+}
+
+void CpuTrace::Record( const char* name, uint64_t startNs, uint64_t endNs )
+{
+	ThreadBuffer& buffer = LocalBuffer();
+
+	Chunk* chunk = buffer.tail;
+	uint32_t index = chunk->count.load( std::memory_order_relaxed );
+	if( index == Chunk::Capacity )
+	{
+		buffer.chunks.push_back( std::make_unique<Chunk>() );
+		Chunk* fresh = buffer.chunks.back().get();
+		chunk->next.store( fresh, std::memory_order_release );
+		buffer.tail = chunk = fresh;
+		index = 0;
+	}
+
+	chunk->events[index] = { name, startNs, endNs };
+	chunk->count.store( index + 1, std::memory_order_release );
+}
+
+uint64_t CpuTrace::Now()
+{
+	return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - epoch ).count() );
+}
+
+void CpuTrace::Write( const std::string& path )
+{
+	std::ofstream out( path );
+	if( !out )
+		throw std::runtime_error( "Failed to open trace output " + path );
+
+	std::lock_guard<std::mutex> lock( registryMutex );
+
+	// ts dan dur dalam mikrodetik, fixed 3 desimal (resolusi ns). Precision default 6 digit
+	// jadi notasi eksponen setelah ~1 detik dan zone per frame menumpuk di grid 100 us
+	out << std::fixed << std::setprecision( 3 );
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first = true;
+	size_t eventCount = 0;
+	for( const auto& buffer : registry )
+	{
+		if( !buffer->threadName.empty() )
+		{
+			out << ( first ? "" : ",\n" ) << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+				<< ",\"args\":{\"name\":\"";
+			WriteEscaped( out, buffer->threadName );
+			out << "\"}}";
+			first = false;
+		}
+
+		for( const Chunk* chunk = buffer->head; chunk != nullptr; chunk = chunk->next.load( std::memory_order_acquire ) )
+		{
+			const uint32_t count = chunk->count.load( std::memory_order_acquire );
+			for( uint32_t i = 0; i < count; ++i )
+			{
+				const Event& e = chunk->events[i];
+				out << ( first ? "" : ",\n" ) << "{\"name\":\"";
+				WriteEscaped( out, e.name );
+				out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+					<< ",\"ts\":" << static_cast<double>( e.startNs ) / 1000.0
+					<< ",\"dur\":" << static_cast<double>( e.endNs - e.startNs ) / 1000.0 << "}";
+				first = false;
+				++eventCount;
+			}
+		}
+	}
+	out << "\n]}\n";
+
+	std::cout << "cpu trace: " << eventCount << " zones from " << registry.size() << " threads written to " << path << std::endl;
+}
+
+#endif
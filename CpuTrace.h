@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// CPU zone untuk trace_event JSON (chrome://tracing / Perfetto).
+// Tiap thread menulis ke buffer thread_local miliknya sendiri tanpa lock,
+// Write() membaca semua buffer saat shutdown.
+// Build dengan NDEBUG: TRACE_ZONE hilang total dan CpuTrace cuma stub kosong.
+#ifndef NDEBUG
+
+class CpuTrace
+{
+public:
+	static constexpr bool Available = true;
+
+	// zone baru dicatat setelah Enable()
+	static void Enable();
+	static bool IsEnabled();
+	static void SetThreadName( const char* name );
+	// name harus string literal (yang disimpan cuma pointer nya)
+	static void Record( const char* name, uint64_t startNs, uint64_t endNs );
+	static uint64_t Now();
+	static void Write( const std::string& path );
+};
+
+class CpuTraceZone
+{
+public:
+	explicit CpuTraceZone( const char* name )
+		:
+		name( name ),
+		active( CpuTrace::IsEnabled() ),
+		start( active ? CpuTrace::Now() : 0 )
+	{
+	}
+	~CpuTraceZone()
+	{
+		if( active )
+			CpuTrace::Record( name, start, CpuTrace::Now() );
+	}
+	CpuTraceZone( const CpuTraceZone& ) = delete;
+	CpuTraceZone& operator=( const CpuTraceZone& ) = delete;
+
+private:
+	const char* name;
+	bool active;
+	uint64_t start;
+};
+
+#define CPU_TRACE_CONCAT_( a, b ) a##b
+#define CPU_TRACE_CONCAT( a, b ) CPU_TRACE_CONCAT_( a, b )
+#define TRACE_ZONE( name ) CpuTraceZone CPU_TRACE_CONCAT( traceZone, __LINE__ )( name )
+
+#else
+
+class CpuTrace
+{
+public:
+	static constexpr bool Available = false;
+
+	static void Enable() {}
+	static bool IsEnabled() { return false; }
+	static void SetThreadName( const char* ) {}
+	static void Write( const std::string& ) {}
+};
+
+#define TRACE_ZONE( name ) ( (void)0 )
+
+#endif
@@ -0,0 +1,88 @@
+#include "DescriptorAllocator.h"
+#include <stdexcept>
+
+#include "HostAllocator.h"
+
+void DescriptorAllocator::Init( VkDevice device, uint32_t setsPerPool, const std::vector<VkDescriptorPoolSize>& poolSizes )
+{
+	this->device = device;
+	this->setsPerPool = setsPerPool;
+	this->poolSizes = poolSizes;
+}
+
+void DescriptorAllocator::CleanUp()
+{
+	if( currentPool != VK_NULL_HANDLE )
+		usedPools.push_back( currentPool );
+	for( VkDescriptorPool pool : usedPools )
+		vkDestroyDescriptorPool( device, pool, HostAllocator::Callbacks() );
+	for( VkDescriptorPool pool : freePools )
+		vkDestroyDescriptorPool( device, pool, HostAllocator::Callbacks() );
+
+	currentPool = VK_NULL_HANDLE;
+	usedPools.clear();
+	freePools.clear();
+}
+
+VkDescriptorSet DescriptorAllocator::Allocate( VkDescriptorSetLayout layout )
+{
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorSetCount = 1;
+	allocInfo.pSetLayouts = &layout;
+
+	// percobaan kedua selalu di pool baru yang kosong
+	for( int attempt = 0; attempt < 2; ++attempt )
+	{
+		if( currentPool == VK_NULL_HANDLE )
+		{
+			if( !freePools.empty() )
+			{
+				currentPool = freePools.back();
+				freePools.pop_back();
+			}
+			else
+				currentPool = CreatePool();
+		}
+
+		allocInfo.descriptorPool = currentPool;
+		VkDescriptorSet set;
+		const VkResult result = vkAllocateDescriptorSets( device, &allocInfo, &set );
+		if( result == VK_SUCCESS )
+			return set;
+		if( result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL )
+			break;
+
+		usedPools.push_back( currentPool );
+		currentPool = VK_NULL_HANDLE;
+	}
+	throw std::runtime_error( "Failed to allocate descriptor set!" );
+}
+
+void DescriptorAllocator::Reset()
+{
+	if( currentPool != VK_NULL_HANDLE )
+		usedPools.push_back( currentPool );
+	currentPool = VK_NULL_HANDLE;
+
+	for( VkDescriptorPool pool : usedPools )
+	{
+		vkResetDescriptorPool( device, pool, 0 );
+		freePools.push_back( pool );
+	}
+	usedPools.clear();
+}
+
+VkDescriptorPool DescriptorAllocator::CreatePool() const
+{
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.maxSets = setsPerPool;
+	poolInfo.poolSizeCount = static_cast<uint32_t>( poolSizes.size() );
+	poolInfo.pPoolSizes = poolSizes.data();
+
+	VkDescriptorPool pool;
+	if( vkCreateDescriptorPool( device, &poolInfo, HostAllocator::Callbacks(), &pool ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create descriptor pool!" );
+	return pool;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+// Allocator descriptor set klasik (tanpa descriptor indexing).
+// Set diambil dari pool yang sedang aktif, kalau pool penuh pindah ke pool kosong / bikin pool baru.
+// Set tidak di-free satu per satu, Reset() mengembalikan semua pool sekaligus.
+class DescriptorAllocator
+{
+public:
+	// poolSizes = jumlah descriptor per pool (bukan per set)
+	void Init( VkDevice device, uint32_t setsPerPool, const std::vector<VkDescriptorPoolSize>& poolSizes );
+	void CleanUp();
+
+	VkDescriptorSet Allocate( VkDescriptorSetLayout layout );
+	// semua set yang pernah di-allocate jadi invalid, caller harus pastikan GPU sudah selesai memakainya
+	void Reset();
+
+	size_t PoolCount() const { return usedPools.size() + freePools.size() + ( currentPool != VK_NULL_HANDLE ? 1 : 0 ); }
+
+private:
+	VkDescriptorPool CreatePool() const;
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	uint32_t setsPerPool = 0;
+	std::vector<VkDescriptorPoolSize> poolSizes;
+
+	VkDescriptorPool currentPool = VK_NULL_HANDLE;
+	std::vector<VkDescriptorPool> usedPools;		// penuh, menunggu Reset()
+	std::vector<VkDescriptorPool> freePools;		// sudah di-reset, siap dipakai lagi
+};
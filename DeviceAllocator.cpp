@@ -0,0 +1,413 @@
+#include "DeviceAllocator.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "HostAllocator.h"
+
+namespace
+{
+	VkDeviceSize AlignUp( VkDeviceSize value, VkDeviceSize alignment )
+	{
+		return ( value + alignment - 1 ) / alignment * alignment;
+	}
+}
+
+void DeviceAllocator::Init( VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize blockSize )
+{
+	this->device = device;
+	this->blockSize = blockSize;
+
+	vkGetPhysicalDeviceMemoryProperties( physicalDevice, &memoryProperties );
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties( physicalDevice, &properties );
+	bufferImageGranularity = properties.limits.bufferImageGranularity;
+	maxMemoryAllocationCount = properties.limits.maxMemoryAllocationCount;
+}
+
+void DeviceAllocator::CleanUp()
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	for( auto& block : blocks )
+	{
+		if( !block->dedicated && !block->tlsf.IsEmpty() )
+			std::cerr << "device allocator: " << block->tlsf.AllocationCount() << " allocation(s) still alive in memory type "
+				<< block->memoryTypeIndex << std::endl;
+		vkFreeMemory( device, block->memory, HostAllocator::Callbacks() );
+	}
+	blocks.clear();
+}
+
+DeviceAllocation DeviceAllocator::Allocate( const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, ResourceKind kind )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	const uint32_t memoryTypeIndex = FindMemoryType( requirements.memoryTypeBits, properties );
+	// granularity 1 = linear dan optimal boleh bersebelahan, jadi pakai block yang sama saja
+	if( bufferImageGranularity <= 1 )
+		kind = ResourceKind::Linear;
+
+	DeviceAllocation allocation;
+
+	// Alokasi besar: VkDeviceMemory sendiri, supaya tidak menghabiskan block
+	// ----------------------------------------------------------------------
+	if( requirements.size > blockSize / 2 )
+	{
+		DeviceMemoryBlock* block = CreateBlock( memoryTypeIndex, kind, requirements.size, true );
+		allocation.memory = block->memory;
+		allocation.offset = 0;
+		allocation.size = requirements.size;
+		allocation.mapped = block->mapped;
+		allocation.block = block;
+	}
+	// ----------------------------------------------------------------------
+	else
+	{
+		TlsfAllocator::Range range{};
+		DeviceMemoryBlock* target = nullptr;
+		for( auto& block : blocks )
+		{
+			if( block->memoryTypeIndex != memoryTypeIndex || block->kind != kind || block->dedicated )
+				continue;
+			if( block->tlsf.Allocate( requirements.size, requirements.alignment, range ) )
+			{
+				target = block.get();
+				break;
+			}
+		}
+
+		if( target == nullptr )
+		{
+			target = CreateBlock( memoryTypeIndex, kind, blockSize, false );
+			if( !target->tlsf.Allocate( requirements.size, requirements.alignment, range ) )
+				throw std::runtime_error( "Failed to sub-allocate from a fresh memory block!" );
+		}
+
+		allocation.memory = target->memory;
+		allocation.offset = range.offset;
+		allocation.size = range.size;
+		allocation.mapped = target->mapped != nullptr ? static_cast<char*>( target->mapped ) + range.offset : nullptr;
+		allocation.block = target;
+		allocation.region = range.handle;
+	}
+
+	usedBytes += allocation.size;
+	peakUsedBytes = std::max( peakUsedBytes, usedBytes );
+
+	return allocation;
+}
+
+DeviceAllocation DeviceAllocator::AllocateForBuffer( VkBuffer buffer, VkMemoryPropertyFlags properties )
+{
+	VkMemoryRequirements requirements;
+	vkGetBufferMemoryRequirements( device, buffer, &requirements );
+
+	DeviceAllocation allocation = Allocate( requirements, properties, ResourceKind::Linear );
+	vkBindBufferMemory( device, buffer, allocation.memory, allocation.offset );
+	return allocation;
+}
+
+DeviceAllocation DeviceAllocator::AllocateForImage( VkImage image, VkMemoryPropertyFlags properties, ResourceKind kind )
+{
+	VkMemoryRequirements requirements;
+	vkGetImageMemoryRequirements( device, image, &requirements );
+
+	DeviceAllocation allocation = Allocate( requirements, properties, kind );
+	vkBindImageMemory( device, image, allocation.memory, allocation.offset );
+	return allocation;
+}
+
+void DeviceAllocator::Free( DeviceAllocation& allocation )
+{
+	if( allocation.block == nullptr )
+		return;
+
+	std::lock_guard<std::mutex> lock( mutex );
+
+	usedBytes -= allocation.size;
+
+	DeviceMemoryBlock* block = allocation.block;
+	if( block->dedicated )
+		DestroyBlock( block );
+	else
+	{
+		block->tlsf.Free( allocation.region );
+
+		// simpan satu block kosong per pool supaya alloc/free bolak-balik tidak vkAllocateMemory terus
+		if( block->tlsf.IsEmpty() )
+		{
+			const bool hasOtherEmpty = std::any_of( blocks.begin(), blocks.end(), [block]( const std::unique_ptr<DeviceMemoryBlock>& other )
+				{
+					return other.get() != block && !other->dedicated &&
+						other->memoryTypeIndex == block->memoryTypeIndex && other->kind == block->kind && other->tlsf.IsEmpty();
+				} );
+			if( hasOtherEmpty )
+				DestroyBlock( block );
+		}
+	}
+
+	allocation = DeviceAllocation{};
+}
+
+uint32_t DeviceAllocator::FindMemoryType( uint32_t typeFilter, VkMemoryPropertyFlags properties ) const
+{
+	for( uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i )
+	{
+		if( ( typeFilter & ( 1U << i ) ) && ( memoryProperties.memoryTypes[i].propertyFlags & properties ) == properties )
+			return i;
+	}
+
+	throw std::runtime_error( "Failed to find suitable memory type!" );
+}
+
+DeviceAllocatorStats DeviceAllocator::GetStats()
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	DeviceAllocatorStats stats;
+	stats.memoryAllocationCount = static_cast<uint32_t>( blocks.size() );
+	for( auto& block : blocks )
+	{
+		stats.blockBytes += block->size;
+		if( block->dedicated )
+		{
+			++stats.dedicatedCount;
+			++stats.allocationCount;
+			stats.usedBytes += block->size;
+		}
+		else
+		{
+			++stats.blockCount;
+			stats.allocationCount += block->tlsf.AllocationCount();
+			stats.usedBytes += block->tlsf.UsedBytes();
+			stats.freeBytes += block->tlsf.FreeBytes();
+			stats.largestFreeRegion = std::max( stats.largestFreeRegion, block->tlsf.LargestFreeRegion() );
+		}
+	}
+	if( stats.freeBytes > 0 )
+		stats.fragmentation = 1.0f - static_cast<float>( stats.largestFreeRegion ) / static_cast<float>( stats.freeBytes );
+
+	stats.peakUsedBytes = peakUsedBytes;
+	return stats;
+}
+
+void DeviceAllocator::PrintStats( std::ostream& out )
+{
+	const DeviceAllocatorStats stats = GetStats();
+	out << "device allocator: " << stats.memoryAllocationCount << "/" << maxMemoryAllocationCount << " VkDeviceMemory, "
+		<< stats.blockCount << " blocks + " << stats.dedicatedCount << " dedicated, "
+		<< stats.allocationCount << " allocations, "
+		<< stats.usedBytes / 1024 << "/" << stats.blockBytes / 1024 << " KiB used (peak " << stats.peakUsedBytes / 1024 << " KiB), "
+		<< "largest free " << stats.largestFreeRegion / 1024 << " KiB, fragmentation " << stats.fragmentation * 100.0f << "%"
+		<< std::endl;
+}
+
+void DeviceAllocator::StressTest( uint64_t operationCount, uint32_t seed )
+{
+	constexpr size_t maxLive = 4096;
+	constexpr uint64_t validateInterval = 250000;
+
+	// per-frame pool sementara: region nya sengaja sedikit lebih kecil dari isi satu frame, jadi overflow ikut teruji
+	constexpr uint32_t frameCount = 3;
+	constexpr VkDeviceSize frameBytes = 1ULL << 20;
+	constexpr uint64_t frameInterval = 2000;
+	LinearFramePool framePool;
+	framePool.Init( device, *this, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, frameCount, frameBytes );
+	uint32_t frameIndex = 0;
+	VkDeviceSize frameEnd = 0;			// akhir alokasi terakhir, relatif ke awal region frame sekarang
+	uint64_t frameAllocations = 0;
+	uint64_t frameOverflows = 0;
+
+	std::mt19937 rng( seed );
+	std::vector<DeviceAllocation> live;
+	live.reserve( maxLive );
+	uint64_t allocations = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for( uint64_t i = 0; i < operationCount; ++i )
+	{
+		if( live.empty() || ( live.size() < maxLive && rng() % 2 == 0 ) )
+		{
+			// ukuran 64 B .. 128 KiB (distribusi log), alignment 256 B .. 4 KiB
+			VkMemoryRequirements requirements{};
+			const VkDeviceSize base = 64ULL << ( rng() % 11 );
+			requirements.size = base + rng() % base;
+			requirements.alignment = 256ULL << ( rng() % 5 );
+			requirements.memoryTypeBits = ~0U;
+			const ResourceKind kind = rng() % 2 == 0 ? ResourceKind::Linear : ResourceKind::Optimal;
+
+			live.push_back( Allocate( requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, kind ) );
+			if( live.back().offset % requirements.alignment != 0 )
+				throw std::runtime_error( "Allocator stress test: misaligned allocation!" );
+			++allocations;
+		}
+		else
+		{
+			const size_t index = rng() % live.size();
+			Free( live[index] );
+			live[index] = live.back();
+			live.pop_back();
+		}
+
+		// per-frame pool: satu bump allocate per operasi, pindah ke region frame berikutnya tiap frameInterval operasi
+		if( ( i + 1 ) % frameInterval == 0 )
+		{
+			frameIndex = ( frameIndex + 1 ) % frameCount;
+			framePool.BeginFrame( frameIndex );
+			frameEnd = 0;
+		}
+		{
+			// ukuran 16 B .. 2 KiB, alignment 16 .. 256 B
+			const VkDeviceSize size = 16ULL << ( rng() % 8 );
+			const VkDeviceSize alignment = 16ULL << ( rng() % 5 );
+			const FrameAllocation slice = framePool.Allocate( size, alignment );
+			if( slice.mapped == nullptr )
+				++frameOverflows;
+			else
+			{
+				const VkDeviceSize regionStart = frameBytes * frameIndex;
+				if( slice.offset % alignment != 0 || slice.offset < regionStart + frameEnd || slice.offset + size > regionStart + frameBytes )
+					throw std::runtime_error( "Allocator stress test: per-frame allocation outside its region after " + std::to_string( i + 1 ) + " operations!" );
+				frameEnd = slice.offset + size - regionStart;
+				++frameAllocations;
+			}
+		}
+
+		if( ( i + 1 ) % validateInterval == 0 )
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			for( auto& block : blocks )
+			{
+				if( !block->dedicated && !block->tlsf.Validate() )
+					throw std::runtime_error( "Allocator stress test: corrupt block after " + std::to_string( i + 1 ) + " operations!" );
+			}
+		}
+	}
+	const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << "allocator stress: " << operationCount << " operations (" << allocations << " allocations, "
+		<< frameAllocations << " per-frame allocations, " << frameOverflows << " per-frame overflows) in "
+		<< elapsed.count() << " ms, " << elapsed.count() * 1.0e6 / static_cast<double>( operationCount ) << " ns/op" << std::endl;
+	PrintStats( std::cout );
+
+	for( auto& allocation : live )
+		Free( allocation );
+	framePool.CleanUp();
+}
+
+DeviceMemoryBlock* DeviceAllocator::CreateBlock( uint32_t memoryTypeIndex, ResourceKind kind, VkDeviceSize size, bool dedicated )
+{
+	if( maxMemoryAllocationCount != 0 && blocks.size() >= maxMemoryAllocationCount )
+		throw std::runtime_error( "maxMemoryAllocationCount reached!" );
+
+	auto block = std::make_unique<DeviceMemoryBlock>();
+	block->size = size;
+	block->memoryTypeIndex = memoryTypeIndex;
+	block->kind = kind;
+	block->dedicated = dedicated;
+
+	VkMemoryAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+	if( vkAllocateMemory( device, &allocInfo, HostAllocator::Callbacks(), &block->memory ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to allocate device memory block!" );
+
+	// host-visible: map sekali seumur hidup block
+	if( memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT )
+	{
+		if( vkMapMemory( device, block->memory, 0, VK_WHOLE_SIZE, 0, &block->mapped ) != VK_SUCCESS )
+		{
+			vkFreeMemory( device, block->memory, HostAllocator::Callbacks() );
+			throw std::runtime_error( "Failed to map device memory block!" );
+		}
+	}
+
+	if( !dedicated )
+		block->tlsf.Init( size );
+
+	blocks.push_back( std::move( block ) );
+	return blocks.back().get();
+}
+
+void DeviceAllocator::DestroyBlock( DeviceMemoryBlock* block )
+{
+	vkFreeMemory( device, block->memory, HostAllocator::Callbacks() );
+	blocks.erase( std::find_if( blocks.begin(), blocks.end(), [block]( const std::unique_ptr<DeviceMemoryBlock>& b ) { return b.get() == block; } ) );
+}
+
+// Linear per-frame pool
+// ---------------------
+void LinearFramePool::Init( VkDevice device, DeviceAllocator& allocator, VkBufferUsageFlags usage, uint32_t framesInFlight,
+	VkDeviceSize bytesPerFrame, VkDeviceSize tailBytes )
+{
+	this->device = device;
+	this->allocator = &allocator;
+	this->framesInFlight = framesInFlight;
+	this->bytesPerFrame = bytesPerFrame;
+	bufferSize = bytesPerFrame * framesInFlight + tailBytes;
+
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = bufferSize;
+	bufferInfo.usage = usage;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	if( vkCreateBuffer( device, &bufferInfo, HostAllocator::Callbacks(), &buffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create per-frame pool buffer!" );
+	// coherent: tulisan CPU langsung kelihatan di submit berikutnya, tanpa vkFlushMappedMemoryRanges
+	memory = allocator.AllocateForBuffer( buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+	mapped = static_cast<char*>( memory.mapped );
+
+	frameBase = 0;
+	head.store( 0, std::memory_order_relaxed );
+}
+
+void LinearFramePool::CleanUp()
+{
+	vkDestroyBuffer( device, buffer, HostAllocator::Callbacks() );
+	allocator->Free( memory );
+	buffer = VK_NULL_HANDLE;
+	mapped = nullptr;
+}
+
+void LinearFramePool::BeginFrame( uint32_t frameIndex )
+{
+	// dipanggil setelah fence frame ini signaled, jadi isi region nya sudah tidak dipakai GPU
+	frameBase = bytesPerFrame * ( frameIndex % framesInFlight );
+	head.store( 0, std::memory_order_relaxed );
+}
+
+FrameAllocation LinearFramePool::Allocate( VkDeviceSize size, VkDeviceSize alignment )
+{
+	alignment = std::max<VkDeviceSize>( alignment, 1 );
+
+	// CAS, bukan fetch_add: alignment per alokasi beda-beda, dan head tidak boleh maju kalau region nya penuh
+	VkDeviceSize current = head.load( std::memory_order_relaxed );
+	VkDeviceSize offset;
+	do
+	{
+		// alignment dihitung dari awal buffer (offset bind), bukan dari awal region
+		offset = AlignUp( frameBase + current, alignment ) - frameBase;
+		if( offset + size > bytesPerFrame )
+			return FrameAllocation();
+	} while( !head.compare_exchange_weak( current, offset + size, std::memory_order_relaxed ) );
+
+	FrameAllocation allocation;
+	allocation.buffer = buffer;
+	allocation.offset = frameBase + offset;
+	allocation.size = size;
+	allocation.mapped = mapped + allocation.offset;
+	return allocation;
+}
+
+VkDeviceSize LinearFramePool::FrameBytesUsed() const
+{
+	return head.load( std::memory_order_relaxed );
+}
+// ---------------------
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+#include "TlsfAllocator.h"
+
+// Linear = buffer dan image LINEAR, Optimal = image OPTIMAL.
+// Dua jenis ini tidak pernah ditaruh di VkDeviceMemory yang sama, jadi bufferImageGranularity
+// otomatis terpenuhi tanpa padding per alokasi.
+enum class ResourceKind
+{
+	Linear,
+	Optimal
+};
+
+// Satu VkDeviceMemory yang dibagi-bagi
+struct DeviceMemoryBlock
+{
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	VkDeviceSize size = 0;
+	void* mapped = nullptr;
+	uint32_t memoryTypeIndex = 0;
+	ResourceKind kind = ResourceKind::Linear;
+	bool dedicated = false;		// satu alokasi saja, tidak pakai TLSF
+	TlsfAllocator tlsf;
+};
+
+// Hasil sub-alokasi. memory + offset langsung dipakai di vkBind*Memory.
+struct DeviceAllocation
+{
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	VkDeviceSize offset = 0;
+	VkDeviceSize size = 0;
+	void* mapped = nullptr;		// tidak nullptr kalau memory type nya HOST_VISIBLE (persistently mapped)
+
+	// buat Free(), jangan diubah
+	DeviceMemoryBlock* block = nullptr;
+	uint32_t region = TlsfAllocator::InvalidHandle;
+};
+
+struct DeviceAllocatorStats
+{
+	uint32_t memoryAllocationCount = 0;		// VkDeviceMemory yang hidup (dibandingkan dengan maxMemoryAllocationCount)
+	uint32_t blockCount = 0;
+	uint32_t dedicatedCount = 0;
+	uint32_t allocationCount = 0;
+	VkDeviceSize blockBytes = 0;			// total VkDeviceMemory general pool + dedicated
+	VkDeviceSize usedBytes = 0;
+	VkDeviceSize freeBytes = 0;
+	VkDeviceSize largestFreeRegion = 0;
+	float fragmentation = 0.0f;				// 1 - largestFreeRegion / freeBytes, 0 = tidak terfragmentasi
+	VkDeviceSize peakUsedBytes = 0;
+};
+
+// Device memory sub-allocator:
+//  - general pool: block besar per (memory type, ResourceKind), sub-alokasi pakai TLSF
+//  - alokasi besar (> setengah block) dapat VkDeviceMemory sendiri (dedicated)
+// Data per frame (uniform, dll) lewat LinearFramePool di bawah, memory nya diambil dari sini
+class DeviceAllocator
+{
+public:
+	void Init( VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize blockSize = 64ULL << 20 );
+	void CleanUp();
+
+	// --- GENERAL POOL ---
+	DeviceAllocation Allocate( const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, ResourceKind kind );
+	DeviceAllocation AllocateForBuffer( VkBuffer buffer, VkMemoryPropertyFlags properties );
+	DeviceAllocation AllocateForImage( VkImage image, VkMemoryPropertyFlags properties, ResourceKind kind = ResourceKind::Optimal );
+	void Free( DeviceAllocation& allocation );
+	// --------------------
+
+	uint32_t FindMemoryType( uint32_t typeFilter, VkMemoryPropertyFlags properties ) const;
+	const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return memoryProperties; }
+
+	DeviceAllocatorStats GetStats();
+	void PrintStats( std::ostream& out );
+
+	// alokasi/free acak sebanyak operationCount di general pool (validasi TLSF secara berkala),
+	// diselingi bump allocate + reset frame di LinearFramePool sementara (cek alignment dan batas region)
+	void StressTest( uint64_t operationCount, uint32_t seed = 1 );
+
+private:
+	DeviceMemoryBlock* CreateBlock( uint32_t memoryTypeIndex, ResourceKind kind, VkDeviceSize size, bool dedicated );
+	void DestroyBlock( DeviceMemoryBlock* block );
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	VkPhysicalDeviceMemoryProperties memoryProperties{};
+	VkDeviceSize blockSize = 0;
+	VkDeviceSize bufferImageGranularity = 1;
+	uint32_t maxMemoryAllocationCount = 0;
+
+	std::mutex mutex;
+	std::vector<std::unique_ptr<DeviceMemoryBlock>> blocks;
+	VkDeviceSize usedBytes = 0;
+	VkDeviceSize peakUsedBytes = 0;
+};
+
+// Hasil LinearFramePool::Allocate(), valid sampai BeginFrame() berikutnya untuk frame yang sama
+struct FrameAllocation
+{
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VkDeviceSize offset = 0;	// dari awal buffer, langsung dipakai sebagai offset bind / dynamic offset
+	VkDeviceSize size = 0;
+	void* mapped = nullptr;		// nullptr = region frame penuh (overflow)
+};
+
+// Linear per-frame pool: satu VkBuffer HOST_VISIBLE | HOST_COHERENT yang di-map terus, dibagi framesInFlight
+// region sama besar. Allocate() = bump atomic di region frame sekarang (aman dari beberapa thread recording),
+// region nya di-reset di BeginFrame() setelah fence frame itu ditunggu. Tidak ada free per alokasi.
+class LinearFramePool
+{
+public:
+	// tailBytes: ruang ekstra di belakang region terakhir, tidak pernah dialokasikan
+	// (misal descriptor dynamic dengan range tetap yang dimulai dari offset mana saja di region)
+	void Init( VkDevice device, DeviceAllocator& allocator, VkBufferUsageFlags usage, uint32_t framesInFlight,
+		VkDeviceSize bytesPerFrame, VkDeviceSize tailBytes = 0 );
+	void CleanUp();
+
+	void BeginFrame( uint32_t frameIndex );
+	// region frame penuh: FrameAllocation kosong (mapped nullptr), bukan exception
+	FrameAllocation Allocate( VkDeviceSize size, VkDeviceSize alignment );
+
+	VkBuffer GetBuffer() const { return buffer; }
+	VkDeviceSize BufferSize() const { return bufferSize; }
+	VkDeviceSize BytesPerFrame() const { return bytesPerFrame; }
+	// byte terpakai di region frame sekarang (termasuk padding alignment), maksimal BytesPerFrame()
+	VkDeviceSize FrameBytesUsed() const;
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	DeviceAllocator* allocator = nullptr;
+	uint32_t framesInFlight = 1;
+	VkDeviceSize bytesPerFrame = 0;
+	VkDeviceSize bufferSize = 0;
+
+	VkBuffer buffer = VK_NULL_HANDLE;
+	DeviceAllocation memory;
+	char* mapped = nullptr;
+
+	VkDeviceSize frameBase = 0;				// awal region frame yang sedang ditulis
+	std::atomic<VkDeviceSize> head{ 0 };	// relatif ke frameBase, tidak pernah lewat bytesPerFrame
+};
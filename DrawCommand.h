@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+
+// Satu draw di draw list frame, argumennya sama dengan vkCmdDrawIndexed
+struct DrawCommand
+{
+public:
+	uint32_t indexCount = 3;
+	uint32_t instanceCount = 1;
+	uint32_t firstIndex = 0;
+	int32_t vertexOffset = 0;
+	uint32_t firstInstance = 0;
+};
@@ -0,0 +1,59 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <thread>
+
+void FramePacer::Init( double maxFps )
+{
+	period = maxFps > 0.0
+		? std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double>( 1.0 / maxFps ) )
+		: Clock::duration::zero();
+	nextFrame = Clock::now();
+	latencies.clear();
+}
+
+void FramePacer::Limit()
+{
+	if( period == Clock::duration::zero() )
+		return;
+
+	const auto now = Clock::now();
+	if( now < nextFrame )
+	{
+		std::this_thread::sleep_until( nextFrame );
+		nextFrame += period;
+	}
+	else
+		nextFrame = now + period;
+}
+
+void FramePacer::MarkInputSampled()
+{
+	inputSampled = Clock::now();
+	hasInputSample = true;
+}
+
+void FramePacer::MarkPresented()
+{
+	if( !hasInputSample )
+		return;
+
+	const std::chrono::duration<double, std::milli> latency = Clock::now() - inputSampled;
+	latencies.push_back( latency.count() );
+	hasInputSample = false;
+}
+
+void FramePacer::PrintStats( std::ostream& out ) const
+{
+	if( latencies.empty() )
+		return;
+
+	std::vector<double> sorted = latencies;
+	std::sort( sorted.begin(), sorted.end() );
+	double sum = 0.0;
+	for( double ms : sorted )
+		sum += ms;
+
+	out << "input -> present latency: avg " << sum / static_cast<double>( sorted.size() ) << " ms, p50 "
+		<< sorted[sorted.size() / 2] << " ms, p99 " << sorted[( sorted.size() - 1 ) * 99 / 100] << " ms, max "
+		<< sorted.back() << " ms (" << sorted.size() << " frames)" << std::endl;
+}
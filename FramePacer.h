@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Frame limiter + pengukuran latency input sample -> present (waktu CPU, sampai vkQueuePresentKHR return).
+// Latency sampai foton keluar di layar butuh VK_KHR_present_wait / VK_GOOGLE_display_timing, belum dipakai.
+class FramePacer
+{
+public:
+	// 0 = tanpa limit
+	void Init( double maxFps );
+
+	// tidur sampai jadwal frame berikutnya. Kalau sudah telat, jadwal di-reset (tidak ada burst buat mengejar)
+	void Limit();
+
+	void MarkInputSampled();
+	void MarkPresented();
+
+	void PrintStats( std::ostream& out ) const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	Clock::duration period{};
+	Clock::time_point nextFrame{};
+	Clock::time_point inputSampled{};
+	bool hasInputSample = false;
+	std::vector<double> latencies;		// ms
+};
@@ -0,0 +1,266 @@
+#include "GpuCulling.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include "HostAllocator.h"
+#include "ShaderBlob.h"
+
+namespace
+{
+	constexpr uint32_t WorkgroupSize = 64;	// local_size_x di Shaders/cull.comp
+}
+
+void GpuCulling::Init( VkDevice device, VkPipelineCache pipelineCache, DeviceAllocator& allocator, UploadManager& uploads,
+	const std::vector<CullObject>& objects, PFN_vkCmdDrawIndexedIndirectCountKHR drawIndirectCount, uint32_t maxDrawIndirectCount )
+{
+	this->device = device;
+	this->allocator = &allocator;
+	this->uploads = &uploads;
+	this->drawIndirectCount = drawIndirectCount;
+	this->maxDrawIndirectCount = std::max( 1U, maxDrawIndirectCount );
+
+	// dipadatkan cuma kalau semua survivor muat di satu draw indirect count
+	compact = drawIndirectCount != nullptr && objects.size() <= this->maxDrawIndirectCount;
+	pushConstants.objectCount = static_cast<uint32_t>( objects.size() );
+	pushConstants.compact = compact ? 1U : 0U;
+
+	// default: clip space Vulkan (-1..1, -1..1, 0..1)
+	const float clipSpace[6][4] = {
+		{ 1.0f, 0.0f, 0.0f, 1.0f }, { -1.0f, 0.0f, 0.0f, 1.0f },
+		{ 0.0f, 1.0f, 0.0f, 1.0f }, { 0.0f, -1.0f, 0.0f, 1.0f },
+		{ 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f, 1.0f }
+	};
+	SetFrustum( clipSpace );
+
+	CreateBuffers( objects );
+	CreateDescriptors();
+	CreatePipeline( pipelineCache );
+
+	std::cout << "gpu culling: " << objects.size() << " objects, "
+		<< ( compact ? "compacted + vkCmdDrawIndexedIndirectCountKHR" :
+			this->maxDrawIndirectCount > 1 ? "fallback multi draw indirect" : "fallback single draw indirect" )
+		<< std::endl;
+}
+
+void GpuCulling::CleanUp()
+{
+	vkDestroyPipeline( device, pipeline, HostAllocator::Callbacks() );
+	vkDestroyPipelineLayout( device, pipelineLayout, HostAllocator::Callbacks() );
+	vkDestroyDescriptorPool( device, descriptorPool, HostAllocator::Callbacks() );
+	vkDestroyDescriptorSetLayout( device, descriptorSetLayout, HostAllocator::Callbacks() );
+
+	vkDestroyBuffer( device, countBuffer, HostAllocator::Callbacks() );
+	allocator->Free( countMemory );
+	vkDestroyBuffer( device, indirectBuffer, HostAllocator::Callbacks() );
+	allocator->Free( indirectMemory );
+	vkDestroyBuffer( device, objectBuffer, HostAllocator::Callbacks() );
+	allocator->Free( objectMemory );
+}
+
+void GpuCulling::SetFrustum( const float planes[6][4] )
+{
+	std::memcpy( clipPlanes, planes, sizeof( clipPlanes ) );
+	UpdatePlanes();
+}
+
+void GpuCulling::SetViewTransform( const float scale[2], const float offset[2] )
+{
+	viewScale[0] = scale[0];
+	viewScale[1] = scale[1];
+	viewOffset[0] = offset[0];
+	viewOffset[1] = offset[1];
+	UpdatePlanes();
+}
+
+void GpuCulling::UpdatePlanes()
+{
+	// a * ( s.x * x + o.x ) + b * ( s.y * y + o.y ) + c * z + d
+	//   = ( a * s.x ) x + ( b * s.y ) y + c z + ( d + a * o.x + b * o.y )
+	// lalu dinormalisasi, supaya jarak ke plane sebanding dengan radius sphere di ruang object
+	for( int p = 0; p < 6; ++p )
+	{
+		const float* clip = clipPlanes[p];
+		float* plane = pushConstants.planes[p];
+		plane[0] = clip[0] * viewScale[0];
+		plane[1] = clip[1] * viewScale[1];
+		plane[2] = clip[2];
+		plane[3] = clip[3] + clip[0] * viewOffset[0] + clip[1] * viewOffset[1];
+
+		const float length = std::sqrt( plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2] );
+		if( length > 0.0f )
+		{
+			for( int i = 0; i < 4; ++i )
+				plane[i] /= length;
+		}
+	}
+}
+
+void GpuCulling::RecordCull( VkCommandBuffer cmd )
+{
+	if( compact )
+	{
+		vkCmdFillBuffer( cmd, countBuffer, 0, sizeof( uint32_t ), 0 );
+
+		// di dalam pass: fill -> atomic add di shader
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		vkCmdPipelineBarrier( cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			0, 1, &barrier, 0, nullptr, 0, nullptr );
+	}
+
+	vkCmdBindPipeline( cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline );
+	vkCmdBindDescriptorSets( cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr );
+	vkCmdPushConstants( cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof( PushConstants ), &pushConstants );
+	vkCmdDispatch( cmd, ( pushConstants.objectCount + WorkgroupSize - 1 ) / WorkgroupSize, 1, 1 );
+}
+
+void GpuCulling::RecordDraws( VkCommandBuffer cmd ) const
+{
+	constexpr uint32_t stride = sizeof( VkDrawIndexedIndirectCommand );
+
+	if( compact )
+	{
+		drawIndirectCount( cmd, indirectBuffer, 0, countBuffer, 0, pushConstants.objectCount, stride );
+		return;
+	}
+
+	for( uint32_t first = 0; first < pushConstants.objectCount; first += maxDrawIndirectCount )
+	{
+		const uint32_t count = std::min( maxDrawIndirectCount, pushConstants.objectCount - first );
+		vkCmdDrawIndexedIndirect( cmd, indirectBuffer, static_cast<VkDeviceSize>( first ) * stride, count, stride );
+	}
+}
+
+void GpuCulling::CreateBuffers( const std::vector<CullObject>& objects )
+{
+	auto createBuffer = [this]( VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer& buffer, DeviceAllocation& allocation )
+	{
+		VkBufferCreateInfo bufferInfo{};
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size = size;
+		bufferInfo.usage = usage;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		if( vkCreateBuffer( device, &bufferInfo, HostAllocator::Callbacks(), &buffer ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create culling buffer!" );
+		allocation = allocator->AllocateForBuffer( buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+	};
+
+	const VkDeviceSize objectSize = sizeof( CullObject ) * std::max<size_t>( 1, objects.size() );
+	createBuffer( objectSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, objectBuffer, objectMemory );
+	createBuffer( sizeof( VkDrawIndexedIndirectCommand ) * std::max<size_t>( 1, objects.size() ),
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, indirectBuffer, indirectMemory );
+	createBuffer( sizeof( uint32_t ), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		countBuffer, countMemory );
+
+	if( !objects.empty() )
+		uploads->UploadBuffer( objectBuffer, 0, objects.data(), sizeof( CullObject ) * objects.size(),
+			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT );
+}
+
+void GpuCulling::CreateDescriptors()
+{
+	// binding 0 = object, 1 = command, 2 = count
+	VkDescriptorSetLayoutBinding bindings[3]{};
+	for( uint32_t i = 0; i < 3; ++i )
+	{
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = 3;
+	layoutInfo.pBindings = bindings;
+
+	if( vkCreateDescriptorSetLayout( device, &layoutInfo, HostAllocator::Callbacks(), &descriptorSetLayout ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create culling descriptor set layout!" );
+
+	VkDescriptorPoolSize poolSize{};
+	poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSize.descriptorCount = 3;
+
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.maxSets = 1;
+	poolInfo.poolSizeCount = 1;
+	poolInfo.pPoolSizes = &poolSize;
+
+	if( vkCreateDescriptorPool( device, &poolInfo, HostAllocator::Callbacks(), &descriptorPool ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create culling descriptor pool!" );
+
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool = descriptorPool;
+	allocInfo.descriptorSetCount = 1;
+	allocInfo.pSetLayouts = &descriptorSetLayout;
+
+	if( vkAllocateDescriptorSets( device, &allocInfo, &descriptorSet ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to allocate culling descriptor set!" );
+
+	const VkDescriptorBufferInfo bufferInfos[3] = {
+		{ objectBuffer, 0, VK_WHOLE_SIZE },
+		{ indirectBuffer, 0, VK_WHOLE_SIZE },
+		{ countBuffer, 0, VK_WHOLE_SIZE }
+	};
+	VkWriteDescriptorSet writes[3]{};
+	for( uint32_t i = 0; i < 3; ++i )
+	{
+		writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[i].dstSet = descriptorSet;
+		writes[i].dstBinding = i;
+		writes[i].descriptorCount = 1;
+		writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		writes[i].pBufferInfo = &bufferInfos[i];
+	}
+	vkUpdateDescriptorSets( device, 3, writes, 0, nullptr );
+}
+
+void GpuCulling::CreatePipeline( VkPipelineCache pipelineCache )
+{
+	VkPushConstantRange pushRange{};
+	pushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	pushRange.offset = 0;
+	pushRange.size = sizeof( PushConstants );
+
+	VkPipelineLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	layoutInfo.setLayoutCount = 1;
+	layoutInfo.pSetLayouts = &descriptorSetLayout;
+	layoutInfo.pushConstantRangeCount = 1;
+	layoutInfo.pPushConstantRanges = &pushRange;
+
+	if( vkCreatePipelineLayout( device, &layoutInfo, HostAllocator::Callbacks(), &pipelineLayout ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create culling pipeline layout!" );
+
+	const ShaderBlob blob = ShaderBlob::Load( "cull.spv" );
+
+	VkShaderModuleCreateInfo moduleInfo{};
+	moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	moduleInfo.codeSize = blob.Size();
+	moduleInfo.pCode = blob.Code();
+
+	VkShaderModule module;
+	if( vkCreateShaderModule( device, &moduleInfo, HostAllocator::Callbacks(), &module ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create culling shader module!" );
+
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	pipelineInfo.stage.module = module;
+	pipelineInfo.stage.pName = "main";
+	pipelineInfo.layout = pipelineLayout;
+
+	const VkResult result = vkCreateComputePipelines( device, pipelineCache, 1, &pipelineInfo, HostAllocator::Callbacks(), &pipeline );
+	vkDestroyShaderModule( device, module, HostAllocator::Callbacks() );
+	if( result != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create culling pipeline!" );
+}
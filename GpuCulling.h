@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+#include "DeviceAllocator.h"
+#include "UploadManager.h"
+
+// Satu object yang di-cull, layout sama dengan CullObject di Shaders/cull.comp (std430)
+struct CullObject
+{
+	float sphere[4];		// xyz = center, w = radius
+	uint32_t indexCount;
+	uint32_t firstIndex;
+	int32_t vertexOffset;
+	uint32_t firstInstance;
+};
+
+// Frustum culling di compute shader, hasilnya VkDrawIndexedIndirectCommand di GPU.
+//  - ada VK_KHR_draw_indirect_count: survivor dipadatkan + draw count, lalu vkCmdDrawIndexedIndirectCountKHR
+//  - tidak ada (device Vulkan 1.0): satu command per object, yang di-cull instanceCount = 0,
+//    lalu vkCmdDrawIndexedIndirect (multi draw kalau multiDrawIndirect didukung)
+class GpuCulling
+{
+public:
+	// drawIndirectCount = nullptr kalau extension nya tidak ada.
+	// maxDrawIndirectCount = 1 kalau multiDrawIndirect tidak didukung.
+	void Init( VkDevice device, VkPipelineCache pipelineCache, DeviceAllocator& allocator, UploadManager& uploads,
+		const std::vector<CullObject>& objects, PFN_vkCmdDrawIndexedIndirectCountKHR drawIndirectCount, uint32_t maxDrawIndirectCount );
+	void CleanUp();
+
+	// plane (a, b, c, d) di clip space: titik di dalam kalau ax + by + cz + d >= 0
+	void SetFrustum( const float planes[6][4] );
+	// view transform yang sama dengan FrameUniforms (clip.xy = posisi.xy * scale + offset), dipanggil tiap frame.
+	// Plane di-transform balik ke ruang object (sphere di CullObject) sebelum di-push ke shader.
+	void SetViewTransform( const float scale[2], const float offset[2] );
+
+	// di luar render pass, sebelum RecordDraws() di command buffer yang sama.
+	// Barrier ke/dari draw (indirect + count buffer) diurus caller (render graph).
+	void RecordCull( VkCommandBuffer commandBuffer );
+	// di dalam render pass, pipeline graphics dan vertex/index buffer sudah di-bind
+	void RecordDraws( VkCommandBuffer commandBuffer ) const;
+
+	bool IsCompacting() const { return compact; }
+	VkBuffer GetIndirectBuffer() const { return indirectBuffer; }
+	VkBuffer GetCountBuffer() const { return countBuffer; }
+
+private:
+	void CreateBuffers( const std::vector<CullObject>& objects );
+	void CreateDescriptors();
+	void CreatePipeline( VkPipelineCache pipelineCache );
+	void UpdatePlanes();
+
+private:
+	struct PushConstants
+	{
+		float planes[6][4];
+		uint32_t objectCount;
+		uint32_t compact;
+	};
+
+	VkDevice device = VK_NULL_HANDLE;
+	DeviceAllocator* allocator = nullptr;
+	UploadManager* uploads = nullptr;
+	PFN_vkCmdDrawIndexedIndirectCountKHR drawIndirectCount = nullptr;
+	uint32_t maxDrawIndirectCount = 1;
+	bool compact = false;
+	float clipPlanes[6][4] = {};
+	float viewScale[2] = { 1.0f, 1.0f };
+	float viewOffset[2] = { 0.0f, 0.0f };
+	PushConstants pushConstants{};
+
+	// --- BUFFERS ---
+	VkBuffer objectBuffer = VK_NULL_HANDLE;
+	DeviceAllocation objectMemory;
+	VkBuffer indirectBuffer = VK_NULL_HANDLE;		// VkDrawIndexedIndirectCommand[objectCount]
+	DeviceAllocation indirectMemory;
+	VkBuffer countBuffer = VK_NULL_HANDLE;
+	DeviceAllocation countMemory;
+	// ---------------
+
+	VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+	VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+	VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+	VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+	VkPipeline pipeline = VK_NULL_HANDLE;
+};
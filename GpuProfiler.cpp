@@ -0,0 +1,200 @@
+#include "GpuProfiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include "HostAllocator.h"
+
+void GpuProfiler::Init( VkDevice device, const VkPhysicalDeviceProperties& properties, uint32_t timestampValidBits, uint32_t framesInFlight )
+{
+	this->device = device;
+
+	// timestampComputeAndGraphics = false artinya tidak semua queue graphics/compute punya timestamp,
+	// jadi yang dicek timestampValidBits queue yang benar-benar dipakai
+	enabled = timestampValidBits > 0 && properties.limits.timestampPeriod > 0.0f;
+	if( !enabled )
+	{
+		std::cout << "gpu profiler: timestamps not supported on this queue, disabled" << std::endl;
+		return;
+	}
+
+	nsPerTick = static_cast<double>( properties.limits.timestampPeriod );
+	timestampMask = timestampValidBits >= 64 ? ~0ULL : ( ( 1ULL << timestampValidBits ) - 1 );
+
+	VkQueryPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	poolInfo.queryCount = MaxPasses * 2;
+
+	frames.resize( framesInFlight );
+	for( auto& frame : frames )
+	{
+		if( vkCreateQueryPool( device, &poolInfo, HostAllocator::Callbacks(), &frame.pool ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create timestamp query pool!" );
+		frame.passes.reserve( MaxPasses );
+	}
+	results.resize( MaxPasses * 2 );
+}
+
+void GpuProfiler::CleanUp()
+{
+	for( auto& frame : frames )
+		vkDestroyQueryPool( device, frame.pool, HostAllocator::Callbacks() );
+	frames.clear();
+}
+
+void GpuProfiler::BeginFrame( VkCommandBuffer commandBuffer, uint32_t frameIndex )
+{
+	if( !enabled )
+		return;
+
+	currentFrame = frameIndex;
+	CollectResults( frameIndex );
+
+	frames[frameIndex].passes.clear();
+	vkCmdResetQueryPool( commandBuffer, frames[frameIndex].pool, 0, MaxPasses * 2 );
+}
+
+void GpuProfiler::BeginPass( VkCommandBuffer commandBuffer, const char* name, VkPipelineStageFlagBits stage )
+{
+	if( !enabled )
+		return;
+
+	FrameQueries& frame = frames[currentFrame];
+	if( frame.passes.size() >= MaxPasses || frame.pendingEnd )
+		throw std::runtime_error( "GPU profiler: too many passes or nested BeginPass!" );
+
+	const uint32_t query = static_cast<uint32_t>( frame.passes.size() ) * 2;
+	frame.passes.push_back( FindOrAddPass( name ) );
+	frame.pendingEnd = true;
+	vkCmdWriteTimestamp( commandBuffer, stage, frame.pool, query );
+}
+
+void GpuProfiler::EndPass( VkCommandBuffer commandBuffer, VkPipelineStageFlagBits stage )
+{
+	if( !enabled )
+		return;
+
+	FrameQueries& frame = frames[currentFrame];
+	const uint32_t query = static_cast<uint32_t>( frame.passes.size() ) * 2 - 1;
+	frame.pendingEnd = false;
+	vkCmdWriteTimestamp( commandBuffer, stage, frame.pool, query );
+}
+
+void GpuProfiler::Flush()
+{
+	if( !enabled )
+		return;
+
+	for( uint32_t i = 0; i < frames.size(); ++i )
+	{
+		CollectResults( i );
+		frames[i].passes.clear();
+	}
+}
+
+std::vector<GpuPassStats> GpuProfiler::GetStats() const
+{
+	std::vector<GpuPassStats> stats;
+	stats.reserve( history.size() );
+
+	std::vector<double> sorted;
+	for( const auto& pass : history )
+	{
+		GpuPassStats s;
+		s.name = pass.name;
+		s.lastMs = pass.lastMs;
+		s.samples = pass.samples;
+		if( !pass.window.empty() )
+		{
+			sorted = pass.window;
+			std::sort( sorted.begin(), sorted.end() );
+			s.minMs = sorted.front();
+			s.avgMs = std::accumulate( sorted.begin(), sorted.end(), 0.0 ) / static_cast<double>( sorted.size() );
+			s.p99Ms = sorted[std::min( sorted.size() - 1, sorted.size() * 99 / 100 )];
+		}
+		stats.push_back( s );
+	}
+	return stats;
+}
+
+void GpuProfiler::WriteJson( std::ostream& out ) const
+{
+	out << "{\n\t\"enabled\": " << ( enabled ? "true" : "false" ) << ",\n\t\"passes\": [";
+	const auto stats = GetStats();
+	for( size_t i = 0; i < stats.size(); ++i )
+	{
+		const auto& s = stats[i];
+		out << ( i == 0 ? "\n" : ",\n" )
+			<< "\t\t{ \"name\": \"" << s.name << "\", \"samples\": " << s.samples
+			<< ", \"lastMs\": " << s.lastMs << ", \"minMs\": " << s.minMs
+			<< ", \"avgMs\": " << s.avgMs << ", \"p99Ms\": " << s.p99Ms << " }";
+	}
+	out << "\n\t]\n}\n";
+}
+
+void GpuProfiler::WriteCsv( std::ostream& out ) const
+{
+	out << "pass,samples,last_ms,min_ms,avg_ms,p99_ms\n";
+	for( const auto& s : GetStats() )
+		out << s.name << "," << s.samples << "," << s.lastMs << "," << s.minMs << "," << s.avgMs << "," << s.p99Ms << "\n";
+}
+
+void GpuProfiler::WriteFile( const std::string& path ) const
+{
+	std::ofstream out( path );
+	if( !out )
+		throw std::runtime_error( "Failed to open profiler output " + path );
+
+	const bool csv = path.size() >= 4 && path.compare( path.size() - 4, 4, ".csv" ) == 0;
+	if( csv )
+		WriteCsv( out );
+	else
+		WriteJson( out );
+}
+
+void GpuProfiler::CollectResults( uint32_t frameIndex )
+{
+	FrameQueries& frame = frames[frameIndex];
+	if( frame.passes.empty() )
+		return;
+
+	// tanpa WAIT_BIT: fence slot ini sudah ditunggu, kalau masih NOT_READY frame nya dilewati saja
+	const uint32_t queryCount = static_cast<uint32_t>( frame.passes.size() ) * 2;
+	if( vkGetQueryPoolResults( device, frame.pool, 0, queryCount, queryCount * sizeof( uint64_t ), results.data(),
+		sizeof( uint64_t ), VK_QUERY_RESULT_64_BIT ) != VK_SUCCESS )
+		return;
+
+	for( size_t i = 0; i < frame.passes.size(); ++i )
+	{
+		const uint64_t begin = results[i * 2] & timestampMask;
+		const uint64_t end = results[i * 2 + 1] & timestampMask;
+		const double ms = static_cast<double>( ( end - begin ) & timestampMask ) * nsPerTick / 1.0e6;
+
+		PassHistory& pass = history[frame.passes[i]];
+		if( pass.window.size() < WindowSize )
+			pass.window.push_back( ms );
+		else
+			pass.window[pass.next] = ms;
+		pass.next = ( pass.next + 1 ) % WindowSize;
+		pass.lastMs = ms;
+		++pass.samples;
+	}
+}
+
+uint32_t GpuProfiler::FindOrAddPass( const char* name )
+{
+	for( size_t i = 0; i < history.size(); ++i )
+	{
+		if( history[i].name == name )
+			return static_cast<uint32_t>( i );
+	}
+
+	PassHistory pass;
+	pass.name = name;
+	pass.window.reserve( WindowSize );
+	history.push_back( std::move( pass ) );
+	return static_cast<uint32_t>( history.size() - 1 );
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct GpuPassStats
+{
+	std::string name;
+	double lastMs = 0.0;
+	double minMs = 0.0;
+	double avgMs = 0.0;
+	double p99Ms = 0.0;
+	uint64_t samples = 0;		// total frame yang terukur (window rolling nya cuma WindowSize terakhir)
+};
+
+// Timestamp query per pass. Satu VkQueryPool per frame in flight, hasilnya dibaca di BeginFrame()
+// frame berikutnya yang pakai slot yang sama (fence nya sudah signaled, jadi tidak pernah menunggu GPU).
+// Kalau queue tidak punya timestamp (timestampValidBits == 0) semua fungsi jadi no-op.
+class GpuProfiler
+{
+public:
+	static constexpr uint32_t MaxPasses = 32;
+	static constexpr size_t WindowSize = 256;	// sample per pass untuk min/avg/p99
+
+public:
+	// timestampValidBits dari VkQueueFamilyProperties queue yang dipakai untuk submit
+	void Init( VkDevice device, const VkPhysicalDeviceProperties& properties, uint32_t timestampValidBits, uint32_t framesInFlight );
+	void CleanUp();
+
+	bool IsEnabled() const { return enabled; }
+
+	// di awal command buffer frame ini (di luar render pass), setelah fence frame tsb signaled
+	void BeginFrame( VkCommandBuffer commandBuffer, uint32_t frameIndex );
+	// pasangan timestamp di sekitar satu pass, nama yang sama = pass yang sama di statistik
+	void BeginPass( VkCommandBuffer commandBuffer, const char* name, VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT );
+	void EndPass( VkCommandBuffer commandBuffer, VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT );
+	// ambil hasil semua frame yang belum dibaca, panggil setelah vkDeviceWaitIdle di shutdown
+	void Flush();
+
+	// buat ditampilkan di app
+	std::vector<GpuPassStats> GetStats() const;
+
+	void WriteJson( std::ostream& out ) const;
+	void WriteCsv( std::ostream& out ) const;
+	// .csv -> CSV, selain itu JSON
+	void WriteFile( const std::string& path ) const;
+
+private:
+	void CollectResults( uint32_t frameIndex );
+	uint32_t FindOrAddPass( const char* name );
+
+private:
+	struct PassHistory
+	{
+		std::string name;
+		std::vector<double> window;		// ring buffer, ukuran maksimal WindowSize
+		size_t next = 0;
+		double lastMs = 0.0;
+		uint64_t samples = 0;
+	};
+
+	struct FrameQueries
+	{
+		VkQueryPool pool = VK_NULL_HANDLE;
+		std::vector<uint32_t> passes;	// pass ke-i pakai query 2i dan 2i+1
+		bool pendingEnd = false;
+	};
+
+	VkDevice device = VK_NULL_HANDLE;
+	bool enabled = false;
+	double nsPerTick = 1.0;
+	uint64_t timestampMask = ~0ULL;
+
+	std::vector<FrameQueries> frames;
+	uint32_t currentFrame = 0;
+	std::vector<PassHistory> history;
+	std::vector<uint64_t> results;
+};
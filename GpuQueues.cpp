@@ -0,0 +1,215 @@
+#include "GpuQueues.h"
+#include <iostream>
+#include <stdexcept>
+
+#include "HostAllocator.h"
+
+void GpuQueues::Init( VkDevice device, const QueueFamilyIndices& indices )
+{
+	this->device = device;
+
+	const uint32_t families[QueueCount] = {
+		indices.GetGraphicsFamilyValue(),
+		indices.GetComputeFamilyValue(),
+		indices.GetTransferFamilyValue()
+	};
+
+	for( size_t i = 0; i < QueueCount; ++i )
+	{
+		Slot& slot = slots[i];
+		slot.family = families[i];
+		vkGetDeviceQueue( device, slot.family, 0, &slot.queue );
+
+		// satu family = satu VkQueue (index 0), jadi mutex nya ikut slot pertama yang pakai family tsb
+		slot.mutex = &mutexes[i];
+		for( size_t j = 0; j < i; ++j )
+		{
+			if( slots[j].queue == slot.queue )
+			{
+				slot.mutex = slots[j].mutex;
+				break;
+			}
+		}
+
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.queueFamilyIndex = slot.family;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+		if( vkCreateCommandPool( device, &poolInfo, HostAllocator::Callbacks(), &slot.immediatePool ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create immediate command pool!" );
+	}
+
+	std::cout << "queues: graphics family " << GetFamily( QueueType::Graphics )
+		<< ", compute family " << GetFamily( QueueType::Compute ) << ( IsDedicated( QueueType::Compute ) ? " (async)" : " (shared)" )
+		<< ", transfer family " << GetFamily( QueueType::Transfer ) << ( IsDedicated( QueueType::Transfer ) ? " (dedicated)" : " (shared)" )
+		<< std::endl;
+}
+
+void GpuQueues::CleanUp()
+{
+	for( auto& slot : slots )
+	{
+		vkDestroyCommandPool( device, slot.immediatePool, HostAllocator::Callbacks() );
+		slot = Slot{};
+	}
+}
+
+bool GpuQueues::IsDedicated( QueueType type ) const
+{
+	return !SameFamily( type, QueueType::Graphics );
+}
+
+void GpuQueues::Submit( QueueType type, const VkSubmitInfo& submitInfo, VkFence fence )
+{
+	const Slot& slot = slots[Index( type )];
+	std::lock_guard<std::mutex> lock( *slot.mutex );
+
+	if( vkQueueSubmit( slot.queue, 1, &submitInfo, fence ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to submit command buffer!" );
+}
+
+VkResult GpuQueues::Present( VkQueue presentQueue, const VkPresentInfoKHR& presentInfo )
+{
+	// present queue biasanya sama dengan graphics queue, jadi ikut dikunci
+	for( const auto& slot : slots )
+	{
+		if( slot.queue == presentQueue )
+		{
+			std::lock_guard<std::mutex> lock( *slot.mutex );
+			return vkQueuePresentKHR( presentQueue, &presentInfo );
+		}
+	}
+	return vkQueuePresentKHR( presentQueue, &presentInfo );
+}
+
+void GpuQueues::SubmitImmediate( QueueType type, const std::function<void( VkCommandBuffer )>& record )
+{
+	const Slot& slot = slots[Index( type )];
+
+	VkCommandBuffer commandBuffer;
+	{
+		std::lock_guard<std::mutex> lock( *slot.mutex );
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = slot.immediatePool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = 1;
+
+		if( vkAllocateCommandBuffers( device, &allocInfo, &commandBuffer ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to allocate immediate command buffer!" );
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer( commandBuffer, &beginInfo );
+		record( commandBuffer );
+		vkEndCommandBuffer( commandBuffer );
+	}
+
+	VkFenceCreateInfo fenceInfo{};
+	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	VkFence fence;
+	if( vkCreateFence( device, &fenceInfo, HostAllocator::Callbacks(), &fence ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create immediate fence!" );
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	Submit( type, submitInfo, fence );
+
+	// tunggu fence, bukan vkQueueWaitIdle: kerja queue lain (frame yang sedang jalan) tidak ikut ditunggu
+	vkWaitForFences( device, 1, &fence, VK_TRUE, UINT64_MAX );
+	vkDestroyFence( device, fence, HostAllocator::Callbacks() );
+
+	std::lock_guard<std::mutex> lock( *slot.mutex );
+	vkFreeCommandBuffers( device, slot.immediatePool, 1, &commandBuffer );
+}
+
+// Ownership transfer
+// ------------------
+void GpuQueues::Release( VkCommandBuffer commandBuffer, const BufferHandoff& handoff ) const
+{
+	const bool sameFamily = SameFamily( handoff.src, handoff.dst );
+
+	VkBufferMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.srcAccessMask = handoff.srcAccess;
+	// release: dstAccessMask diabaikan, visibility diurus barrier acquire di queue tujuan
+	barrier.dstAccessMask = sameFamily ? handoff.dstAccess : 0;
+	barrier.srcQueueFamilyIndex = sameFamily ? VK_QUEUE_FAMILY_IGNORED : GetFamily( handoff.src );
+	barrier.dstQueueFamilyIndex = sameFamily ? VK_QUEUE_FAMILY_IGNORED : GetFamily( handoff.dst );
+	barrier.buffer = handoff.buffer;
+	barrier.offset = handoff.offset;
+	barrier.size = handoff.size;
+
+	vkCmdPipelineBarrier( commandBuffer, handoff.srcStage,
+		sameFamily ? handoff.dstStage : static_cast<VkPipelineStageFlags>( VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT ),
+		0, 0, nullptr, 1, &barrier, 0, nullptr );
+}
+
+void GpuQueues::Acquire( VkCommandBuffer commandBuffer, const BufferHandoff& handoff ) const
+{
+	if( SameFamily( handoff.src, handoff.dst ) )
+		return;
+
+	VkBufferMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = handoff.dstAccess;
+	barrier.srcQueueFamilyIndex = GetFamily( handoff.src );
+	barrier.dstQueueFamilyIndex = GetFamily( handoff.dst );
+	barrier.buffer = handoff.buffer;
+	barrier.offset = handoff.offset;
+	barrier.size = handoff.size;
+
+	// srcStage = stage wait semaphore submit ini (pWaitDstStageMask), supaya acquire nya ter-chain setelah copy
+	// di queue asal. TOP_OF_PIPE tidak ter-chain dengan wait itu, barrier bisa jalan sebelum copy selesai
+	vkCmdPipelineBarrier( commandBuffer, handoff.dstStage, handoff.dstStage,
+		0, 0, nullptr, 1, &barrier, 0, nullptr );
+}
+
+void GpuQueues::Release( VkCommandBuffer commandBuffer, const ImageHandoff& handoff ) const
+{
+	const bool sameFamily = SameFamily( handoff.src, handoff.dst );
+
+	// layout transition ditulis sama persis di release dan acquire, jalannya sekali saja
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.srcAccessMask = handoff.srcAccess;
+	barrier.dstAccessMask = sameFamily ? handoff.dstAccess : 0;
+	barrier.oldLayout = handoff.oldLayout;
+	barrier.newLayout = handoff.newLayout;
+	barrier.srcQueueFamilyIndex = sameFamily ? VK_QUEUE_FAMILY_IGNORED : GetFamily( handoff.src );
+	barrier.dstQueueFamilyIndex = sameFamily ? VK_QUEUE_FAMILY_IGNORED : GetFamily( handoff.dst );
+	barrier.image = handoff.image;
+	barrier.subresourceRange = handoff.range;
+
+	vkCmdPipelineBarrier( commandBuffer, handoff.srcStage,
+		sameFamily ? handoff.dstStage : static_cast<VkPipelineStageFlags>( VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT ),
+		0, 0, nullptr, 0, nullptr, 1, &barrier );
+}
+
+void GpuQueues::Acquire( VkCommandBuffer commandBuffer, const ImageHandoff& handoff ) const
+{
+	if( SameFamily( handoff.src, handoff.dst ) )
+		return;
+
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = handoff.dstAccess;
+	barrier.oldLayout = handoff.oldLayout;
+	barrier.newLayout = handoff.newLayout;
+	barrier.srcQueueFamilyIndex = GetFamily( handoff.src );
+	barrier.dstQueueFamilyIndex = GetFamily( handoff.dst );
+	barrier.image = handoff.image;
+	barrier.subresourceRange = handoff.range;
+
+	// srcStage sama dengan versi buffer: layout transition nya juga harus menunggu copy
+	vkCmdPipelineBarrier( commandBuffer, handoff.dstStage, handoff.dstStage,
+		0, 0, nullptr, 0, nullptr, 1, &barrier );
+}
+// ------------------
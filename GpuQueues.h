@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <functional>
+#include <mutex>
+
+#include "QueueFamilyIndices.h"
+
+enum class QueueType
+{
+	Graphics,
+	Compute,
+	Transfer,
+	Count
+};
+
+// Resource yang pindah dari satu queue ke queue lain.
+// Release() di-record di command buffer queue asal, Acquire() di command buffer queue tujuan,
+// dan submit tujuan harus menunggu (semaphore) submit asal dengan pWaitDstStageMask yang mencakup dstStage.
+// Kalau family nya sama, Release() jadi barrier biasa dan Acquire() tidak melakukan apa-apa.
+struct BufferHandoff
+{
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VkDeviceSize offset = 0;
+	VkDeviceSize size = VK_WHOLE_SIZE;
+	QueueType src = QueueType::Transfer;
+	QueueType dst = QueueType::Graphics;
+	VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	VkAccessFlags srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
+	VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+	VkAccessFlags dstAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+};
+
+struct ImageHandoff
+{
+	VkImage image = VK_NULL_HANDLE;
+	VkImageSubresourceRange range{ VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS };
+	VkImageLayout oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	VkImageLayout newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	QueueType src = QueueType::Transfer;
+	QueueType dst = QueueType::Graphics;
+	VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	VkAccessFlags srcAccess = VK_ACCESS_TRANSFER_WRITE_BIT;
+	VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	VkAccessFlags dstAccess = VK_ACCESS_SHADER_READ_BIT;
+};
+
+// Graphics, async compute, dan transfer queue.
+// Queue yang family nya fallback ke graphics berbagi VkQueue (dan mutex) yang sama,
+// jadi Submit() aman dipanggil dari thread mana saja.
+class GpuQueues
+{
+public:
+	void Init( VkDevice device, const QueueFamilyIndices& indices );
+	void CleanUp();
+
+	VkQueue Get( QueueType type ) const { return slots[Index( type )].queue; }
+	uint32_t GetFamily( QueueType type ) const { return slots[Index( type )].family; }
+	// true kalau queue ini beda family dengan graphics (kerja nya bisa overlap dengan rendering)
+	bool IsDedicated( QueueType type ) const;
+
+	// --- SUBMIT ---
+	void Submit( QueueType type, const VkSubmitInfo& submitInfo, VkFence fence );
+	VkResult Present( VkQueue presentQueue, const VkPresentInfoKHR& presentInfo );
+	// record lewat callback, submit, lalu tunggu selesai. Buat kerja sekali jalan (bukan per frame).
+	void SubmitImmediate( QueueType type, const std::function<void( VkCommandBuffer )>& record );
+	// --------------
+
+	// --- OWNERSHIP TRANSFER ---
+	void Release( VkCommandBuffer commandBuffer, const BufferHandoff& handoff ) const;
+	void Acquire( VkCommandBuffer commandBuffer, const BufferHandoff& handoff ) const;
+	void Release( VkCommandBuffer commandBuffer, const ImageHandoff& handoff ) const;
+	void Acquire( VkCommandBuffer commandBuffer, const ImageHandoff& handoff ) const;
+	// --------------------------
+
+private:
+	static size_t Index( QueueType type ) { return static_cast<size_t>( type ); }
+	bool SameFamily( QueueType a, QueueType b ) const { return GetFamily( a ) == GetFamily( b ); }
+
+private:
+	static constexpr size_t QueueCount = static_cast<size_t>( QueueType::Count );
+
+	struct Slot
+	{
+		VkQueue queue = VK_NULL_HANDLE;
+		uint32_t family = 0;
+		std::mutex* mutex = nullptr;				// VkQueue yang sama = mutex yang sama
+		VkCommandPool immediatePool = VK_NULL_HANDLE;	// dijaga mutex yang sama juga
+	};
+
+	VkDevice device = VK_NULL_HANDLE;
+	Slot slots[QueueCount];
+	std::mutex mutexes[QueueCount];
+};
@@ -1,64 +1,300 @@
 #include "HelloTriangleApp.h"
 #include <algorithm>
 #include <fstream>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+
+HelloTriangleApp::HelloTriangleApp( const AppConfig& config )
+	:
+	config( config )
+{
+}
 
 void HelloTriangleApp::Run()
 {
-	InitWindow();
-	InitVulkan();
-	MainLoop();
-	CleanUp();
+	if( !config.cpuTracePath.empty() )
+	{
+		if( CpuTrace::Available )
+		{
+			CpuTrace::Enable();
+			CpuTrace::SetThreadName( "main" );
+		}
+		else
+			std::cout << "cpu trace: compiled out (NDEBUG), " << config.cpuTracePath << " is not written" << std::endl;
+	}
+
+	bench.Start();
+	{
+		TRACE_ZONE( "InitWindow" );
+		InitWindow();
+		bench.Mark( "InitWindow" );
+	}
+	{
+		TRACE_ZONE( "InitVulkan" );
+		InitVulkan();
+	}
+	{
+		TRACE_ZONE( "MainLoop" );
+		if( config.allocatorStressOps > 0 )
+			deviceAllocator.StressTest( config.allocatorStressOps );
+		else if( config.renderGraphTest )
+			RenderGraph::SelfTest( device, deviceAllocator, std::cout );
+		else if( config.recordBenchmarkDraws > 0 )
+			RunRecordBenchmark( config.recordBenchmarkDraws );
+		else
+			MainLoop();
+	}
+	{
+		TRACE_ZONE( "CleanUp" );
+		CleanUp();
+	}
+
+	if( CpuTrace::IsEnabled() )
+		CpuTrace::Write( config.cpuTracePath );
 }
 
 void HelloTriangleApp::InitWindow()
 {
+	if( config.headless ) return;
+
 	glfwInit();
 	glfwWindowHint( GLFW_CLIENT_API, GLFW_NO_API );
-	glfwWindowHint( GLFW_RESIZABLE, GLFW_FALSE );
+	glfwWindowHint( GLFW_RESIZABLE, GLFW_TRUE );
 
 	window = glfwCreateWindow( ScreenWidth, ScreenHeight, "Learning Vulkan", nullptr, nullptr );
+	glfwSetWindowUserPointer( window, this );
+	glfwSetFramebufferSizeCallback( window, FramebufferResizeCallback );
 }
 
 void HelloTriangleApp::InitVulkan()
 {
+	// bench.Mark() setelah tiap fase: waktu startup per fase buat --bench-report
 	InitInstance();
+	bench.Mark( "InitInstance" );
 	SetupDebugMessenger();
 	CreateSurface();
+	bench.Mark( "CreateSurface" );
 	PickPhysicalDevice();
+	bench.Mark( "PickPhysicalDevice" );
 	CreateLogicalDevice();
-	CreateSwapChain();
+	bench.Mark( "CreateLogicalDevice" );
+	deviceAllocator.Init( device, physicalDevice );
+	uploads.Init( device, deviceAllocator, queues );
+	bindless.Init( device, physicalDeviceInfo.properties.limits, descriptorIndexingEnabled, deviceAllocator, uploads, config.framesInFlight );
+	uniformRing.Init( device, physicalDeviceInfo.properties.limits, deviceAllocator, config.framesInFlight, static_cast<VkDeviceSize>( config.uniformRingKB ) * 1024 );
+	bench.Mark( "InitAllocators" );
+	if( config.headless )
+		CreateOffscreenTargets();
+	else
+		CreateSwapChain();
+	bench.Mark( "CreateSwapChain" );
 	CreateImageViews();
+	CreateRenderPass();
+	bench.Mark( "CreateImageViews" );
+
+	if( !config.meshPath.empty() )
+	{
+		LoadMesh();
+		bench.Mark( "LoadMesh" );
+	}
+	pipelineCache.Init( device, physicalDeviceInfo.properties, config.pipelineCachePath );
+	pipelineBuilder.Init( device, pipelineCache.Get(), config.pipelineBuildThreads );
+	CreateGraphicsPipeline();
+	bench.Mark( "SubmitGraphicsPipeline" );
+
+	CreateFramebuffers();
+	CreateCommandPool();
+	CreateCommandBuffers();
+	if( !config.gpuProfilePath.empty() )
+	{
+		profiler.Init( device, physicalDeviceInfo.properties,
+			physicalDeviceInfo.queueFamilies[queues.GetFamily( QueueType::Graphics )].timestampValidBits, config.framesInFlight );
+	}
+	CreateGeometryBuffers();
+	if( !config.textureDir.empty() )
+		LoadTextures();
+	if( config.recordThreads > 0 )
+		recorder.Init( device, queues.GetFamily( QueueType::Graphics ), config.framesInFlight, config.recordThreads );
+	CreateSyncObjects();
+	BuildRenderGraph();
+	bench.Mark( "CreateFrameResources" );
+
+	// frame pertama butuh pipeline ini, baru di sini kita tunggu
+	graphicsPipeline = graphicsPipelineFuture.get();
+	bench.Mark( "WaitGraphicsPipeline" );
+	// durasi di worker (Submit -> pipeline jadi), bukan sampai get(): kerja main thread di antaranya tidak ikut terhitung
+	pipelineCache.ReportStartupTiming( graphicsPipelineMs );
 }
 
 void HelloTriangleApp::MainLoop()
 {
-	while( !glfwWindowShouldClose( window ) )
-		glfwPollEvents();
+	// frame time = durasi DrawFrame, termasuk nunggu fence (jadi ikut GPU bound)
+	const auto loopStart = std::chrono::steady_clock::now();
+	auto timedDrawFrame = [this]
+	{
+		const auto frameStart = std::chrono::steady_clock::now();
+		DrawFrame();
+		const std::chrono::duration<double, std::milli> frameTime = std::chrono::steady_clock::now() - frameStart;
+		bench.AddFrame( frameTime.count() );
+	};
+
+	framePacer.Init( config.maxFps );
+	if( config.headless )
+	{
+		for( uint32_t frame = 0; frame < config.frameCount; ++frame )
+		{
+			framePacer.Limit();
+			framePacer.MarkInputSampled();
+			timedDrawFrame();
+		}
+	}
+	else
+	{
+		while( !glfwWindowShouldClose( window ) )
+		{
+			framePacer.Limit();
+			// low-latency: tunggu GPU selesai frame sebelumnya dulu, baru sample input.
+			// Tanpa ini input di-sample lalu nganggur selama DrawFrame nunggu fence.
+			if( config.presentPolicy == PresentPolicy::LowLatency )
+			{
+				TRACE_ZONE( "WaitBeforeInput" );
+				vkWaitForFences( device, 1, &inFlightFences[currentFrame], VK_TRUE, std::numeric_limits<uint64_t>::max() );
+			}
+			glfwPollEvents();
+			framePacer.MarkInputSampled();
+			timedDrawFrame();
+		}
+	}
+
+	// cuma di shutdown, bukan di steady state
+	vkDeviceWaitIdle( device );
+	const std::chrono::duration<double, std::milli> loopTime = std::chrono::steady_clock::now() - loopStart;
+	bench.SetLoopTime( loopTime.count() );
+
+	if( uploads.GetStats().batchCount > 0 )
+		uploads.PrintStats( std::cout );
+	framePacer.PrintStats( std::cout );
+	uniformRing.PrintStats( std::cout );
+	if( !config.textureDir.empty() )
+		textureStreamer.PrintStats( std::cout );
+
+	if( profiler.IsEnabled() )
+	{
+		profiler.Flush();
+		for( const auto& pass : profiler.GetStats() )
+			std::cout << "gpu " << pass.name << ": avg " << pass.avgMs << " ms, min " << pass.minMs << " ms, p99 " << pass.p99Ms
+				<< " ms (" << pass.samples << " frames)" << std::endl;
+		profiler.WriteFile( config.gpuProfilePath );
+	}
+
+	if( !config.benchReportPath.empty() )
+	{
+		BenchScene scene;
+		scene.deviceName = physicalDeviceInfo.properties.deviceName;
+		scene.instances = std::max( 1U, config.instanceCount );
+		scene.drawCalls = static_cast<uint32_t>( drawList.size() );
+		scene.triangles = 0;
+		for( const DrawCommand& draw : drawList )
+			scene.triangles += static_cast<uint64_t>( draw.indexCount / 3 ) * draw.instanceCount;
+		scene.framesInFlight = config.framesInFlight;
+		scene.recordThreads = config.recordThreads;
+		scene.gpuCull = config.gpuCull;
+		scene.pipelineCacheWarm = pipelineCache.IsWarm();
+		bench.WriteFile( config.benchReportPath, scene, deviceAllocator.GetStats() );
+		std::cout << "bench report written to " << config.benchReportPath << std::endl;
+	}
 }
 
 void HelloTriangleApp::CleanUp()
 {
-	for( auto& imageView : swapchainImageViews )
-		vkDestroyImageView( device, imageView, nullptr );
+	for( uint32_t i = 0; i < config.framesInFlight; ++i )
+	{
+		if( !config.headless )
+		{
+			vkDestroySemaphore( device, renderFinishedSemaphores[i], HostAllocator::Callbacks() );
+			vkDestroySemaphore( device, imageAvailableSemaphores[i], HostAllocator::Callbacks() );
+		}
+		vkDestroyFence( device, inFlightFences[i], HostAllocator::Callbacks() );
+	}
+
+	vkDestroyCommandPool( device, commandPool, HostAllocator::Callbacks() );
+	recorder.CleanUp();
+	profiler.CleanUp();
 
-	vkDestroySwapchainKHR( device, swapchain, nullptr );
+	for( auto& framebuffer : swapchainFramebuffers )
+		vkDestroyFramebuffer( device, framebuffer, HostAllocator::Callbacks() );
+	DestroyRetiredSwapchains( true );
 
-	vkDestroyDevice( device, nullptr );
+	renderGraph.CleanUp();
+	vkDestroyPipeline( device, graphicsPipeline, HostAllocator::Callbacks() );
+	vkDestroyPipelineLayout( device, pipelineLayout, HostAllocator::Callbacks() );
+	vkDestroyRenderPass( device, renderPass, HostAllocator::Callbacks() );
+	pipelineBuilder.CleanUp();
+	pipelineCache.CleanUp();
+
+	for( auto& imageView : swapchainImageViews )
+		vkDestroyImageView( device, imageView, HostAllocator::Callbacks() );
+
+	if( config.headless )
+	{
+		for( size_t i = 0; i < swapchainImages.size(); ++i )
+		{
+			vkDestroyImage( device, swapchainImages[i], HostAllocator::Callbacks() );
+			deviceAllocator.Free( offscreenImageMemories[i] );
+		}
+	}
+	else
+		vkDestroySwapchainKHR( device, swapchain, HostAllocator::Callbacks() );
+
+	if( config.gpuCull )
+		culling.CleanUp();
+	if( !config.textureDir.empty() )
+		textureStreamer.CleanUp();
+	uniformRing.CleanUp();
+	bindless.CleanUp();
+	vkDestroyBuffer( device, instanceBuffer, HostAllocator::Callbacks() );
+	deviceAllocator.Free( instanceBufferMemory );
+	vkDestroyBuffer( device, indexBuffer, HostAllocator::Callbacks() );
+	deviceAllocator.Free( indexBufferMemory );
+	vkDestroyBuffer( device, vertexBuffer, HostAllocator::Callbacks() );
+	deviceAllocator.Free( vertexBufferMemory );
+
+	uploads.CleanUp();
+	deviceAllocator.CleanUp();
+	queues.CleanUp();
+
+	vkDestroyDevice( device, HostAllocator::Callbacks() );
+	HostAllocator::ReleaseArena( VK_SYSTEM_ALLOCATION_SCOPE_DEVICE );
 
 	if( enableValidationLayer )
-		DebugUtilsMessengerEXT::Destroy( instance, debugMessenger, nullptr );
+		DebugUtilsMessengerEXT::Destroy( instance, debugMessenger, HostAllocator::Callbacks() );
 
-	vkDestroySurfaceKHR( instance, surface, nullptr );
-	vkDestroyInstance( instance, nullptr );
-	glfwDestroyWindow( window );
+	if( surface != VK_NULL_HANDLE )
+		vkDestroySurfaceKHR( instance, surface, HostAllocator::Callbacks() );
+	vkDestroyInstance( instance, HostAllocator::Callbacks() );
+	HostAllocator::ReleaseArena( VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE );
+	// messenger dari pNext vkCreateInstance masih bisa kirim pesan sampai vkDestroyInstance selesai
+	if( enableValidationLayer )
+		validationSink.CleanUp();
+	if( config.hostAllocatorReport )
+		HostAllocator::PrintStats( true );
 
-	glfwTerminate();
+	if( window != nullptr )
+	{
+		glfwDestroyWindow( window );
+		glfwTerminate();
+	}
 }
 
 void HelloTriangleApp::InitInstance()
 {
+	TRACE_ZONE( "InitInstance" );
 	if( enableValidationLayer && !CheckValidationLayerProperties() )
 		throw std::runtime_error( "Validation Layer requested, but not available!" );
+	// semua object (termasuk instance) harus di-create dan di-destroy dengan callbacks yang sama
+	HostAllocator::Init( config.hostAllocator );
 
 	VkApplicationInfo appInfo{};
 	appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
@@ -82,7 +318,8 @@ void HelloTriangleApp::InitInstance()
 		createInfo.enabledLayerCount = static_cast<uint32_t>( validationLayer.size() );
 		createInfo.ppEnabledLayerNames = validationLayer.data();
 
-		PopulateDebugUtilsMessengerCreateInfoEXT( debugCreateInfo );
+		validationSink.Init( config.validationSeverities, config.validationTypes, config.validationRepeatLimit );
+		validationSink.PopulateCreateInfo( debugCreateInfo );
 		createInfo.pNext = (VkDebugUtilsMessengerCreateInfoEXT*)&debugCreateInfo;
 	}
 	else
@@ -91,7 +328,7 @@ void HelloTriangleApp::InitInstance()
 		createInfo.pNext = nullptr;
 	}
 
-	if( vkCreateInstance( &createInfo, nullptr, &instance ) != VK_SUCCESS )
+	if( vkCreateInstance( &createInfo, HostAllocator::Callbacks(), &instance ) != VK_SUCCESS )
 		throw std::runtime_error( "Failed to create instance\n" );
 
 	uint32_t vkExtensionsCount = 0U;
@@ -101,10 +338,18 @@ void HelloTriangleApp::InitInstance()
 
 	if( !CheckExtensionProperties( extensions, vkExtensions ) )
 		throw std::runtime_error( "Failed to found the extensions\n" );
+
+	// instance masih 1.0: query feature descriptor indexing lewat versi KHR
+	if( std::find_if( extensions.begin(), extensions.end(), []( const char* e ) { return std::strcmp( e, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME ) == 0; } ) != extensions.end() )
+	{
+		getPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+			vkGetInstanceProcAddr( instance, "vkGetPhysicalDeviceFeatures2KHR" ) );
+	}
 }
 
 void HelloTriangleApp::PickPhysicalDevice()
 {
+	TRACE_ZONE( "PickPhysicalDevice" );
 	uint32_t physicalDeviceCount = 0;
 	vkEnumeratePhysicalDevices( instance, &physicalDeviceCount, nullptr );
 
@@ -114,38 +359,78 @@ void HelloTriangleApp::PickPhysicalDevice()
 	std::vector<VkPhysicalDevice> devices( physicalDeviceCount );
 	vkEnumeratePhysicalDevices( instance, &physicalDeviceCount, devices.data() );
 
-	for( const auto& device : devices )
+	DeviceRequirements requirements;
+	requirements.extensions = GetRequiredDeviceExtensions();
+	requirements.present = !config.headless;
+	requirements.drawIndirectFirstInstance = config.gpuCull;
+
+	// snapshot semua device sekali, dipakai buat scoring dan (yang terpilih) sampai CleanUp
+	std::vector<PhysicalDeviceInfo> candidates;
+	std::vector<int64_t> scores;
+	for( const auto& candidate : devices )
 	{
-		if( IsDeviceSuitable( device ) )
+		candidates.push_back( PhysicalDeviceInfo::Query( candidate, surface, getPhysicalDeviceFeatures2 ) );
+		scores.push_back( candidates.back().Score( requirements ) );
+	}
+
+	// Override dari --device / VULKAN_DEVICE: index atau potongan nama
+	// ----------------------------------------------------------------
+	size_t chosen = candidates.size();
+	const std::string& deviceOverride = config.deviceOverride;
+	if( !deviceOverride.empty() )
+	{
+		const bool isIndex = std::all_of( deviceOverride.begin(), deviceOverride.end(), []( char c ) { return c >= '0' && c <= '9'; } );
+		for( size_t i = 0; i < candidates.size() && chosen == candidates.size(); ++i )
 		{
-			physicalDevice = device;
-			break;
+			if( isIndex ? std::stoul( deviceOverride ) == i : std::strstr( candidates[i].properties.deviceName, deviceOverride.c_str() ) != nullptr )
+				chosen = i;
 		}
+		if( chosen == candidates.size() )
+			throw std::runtime_error( "No GPU matches device override \"" + deviceOverride + "\"" );
+		if( scores[chosen] < 0 )
+			throw std::runtime_error( std::string( "Overridden GPU is not suitable: " ) + candidates[chosen].properties.deviceName );
+	}
+	// ----------------------------------------------------------------
+	else
+	{
+		for( size_t i = 0; i < candidates.size(); ++i )
+		{
+			if( scores[i] >= 0 && ( chosen == candidates.size() || scores[i] > scores[chosen] ) )
+				chosen = i;
+		}
+		if( chosen == candidates.size() )
+			throw std::runtime_error( "Failed to find suitable GPUs!" );
 	}
-	if( physicalDevice == VK_NULL_HANDLE )
-		throw std::runtime_error( "Failed to find suitable GPUs!" );
-
-	//pilih yang atas (dikomen) itu, atau yang bawah ini. [pilih salah satu!]
 
-	/*std::multimap<int, VkPhysicalDevice> candidates;
-	for( const auto device : devices )
+	for( size_t i = 0; i < candidates.size(); ++i )
 	{
-		const int score = RateDeviceSuitability( device );
-		candidates.insert( std::make_pair( score, device ) );
+		std::cout << ( i == chosen ? "* " : "  " ) << "gpu " << i << ": " << candidates[i].properties.deviceName
+			<< " (" << candidates[i].TypeName() << ", " << ( candidates[i].DeviceLocalBytes() >> 20 ) << " MB device local, score "
+			<< scores[i] << ")" << std::endl;
 	}
 
-	if( candidates.rbegin()->first > 0 )
-		physicalDevice = candidates.rbegin()->second;
-	else
-		throw std::runtime_error( "Failed to find suitable GPUs!" );*/
+	physicalDeviceInfo = std::move( candidates[chosen] );
+	physicalDevice = physicalDeviceInfo.physicalDevice;
+
+	// indirect command culling pakai firstInstance buat index instance, tanpa feature ini fallback ke draw biasa (tanpa culling)
+	if( config.gpuCull && !physicalDeviceInfo.features.drawIndirectFirstInstance )
+	{
+		std::cout << "gpu culling: drawIndirectFirstInstance not supported, falling back to non-culled draws" << std::endl;
+		config.gpuCull = false;
+	}
 }
 
 void HelloTriangleApp::CreateLogicalDevice()
 {
-	QueueFamilyIndices indices = FindQueueFamilies( physicalDevice );
+	TRACE_ZONE( "CreateLogicalDevice" );
+	const QueueFamilyIndices& indices = physicalDeviceInfo.queueIndices;
 
 	std::vector<VkDeviceQueueCreateInfo> queueInfosss;
-	std::set<uint32_t> uniqueQueueFamilies{ indices.GetGraphicsFamilyValue(), indices.GetPresentFamilyValue() };
+	std::set<uint32_t> uniqueQueueFamilies{ indices.GetGraphicsFamilyValue() };
+	if( indices.presentFamily.has_value() )
+		uniqueQueueFamilies.insert( indices.GetPresentFamilyValue() );
+	uniqueQueueFamilies.insert( indices.GetComputeFamilyValue() );
+	uniqueQueueFamilies.insert( indices.GetTransferFamilyValue() );
 
 	float queuePriority = 1.0f;
 
@@ -172,10 +457,33 @@ void HelloTriangleApp::CreateLogicalDevice()
 	deviceInfo.pQueueCreateInfos = queueInfosss.data();
 	deviceInfo.queueCreateInfoCount = static_cast<uint32_t>( queueInfosss.size() );
 
-	VkPhysicalDeviceFeatures physicalDeviceFeatures = GetPhysicalDeviceFeatures( physicalDevice );
+	VkPhysicalDeviceFeatures physicalDeviceFeatures = physicalDeviceInfo.features;
 	deviceInfo.pEnabledFeatures = &physicalDeviceFeatures;
-	deviceInfo.enabledExtensionCount = static_cast<uint32_t>( deviceExtensionsNeeded.size() );
-	deviceInfo.ppEnabledExtensionNames = deviceExtensionsNeeded.data();
+	auto deviceExtensions = GetRequiredDeviceExtensions();
+	// opsional: compaction di GPU culling, tanpa ini culling fallback ke instanceCount = 0
+	const bool drawIndirectCountSupported = config.gpuCull &&
+		physicalDeviceInfo.HasExtension( VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME );
+	if( drawIndirectCountSupported )
+		deviceExtensions.push_back( VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME );
+
+	// opsional: bindless descriptor, tanpa ini BindlessDescriptors fallback ke set klasik per frame
+	descriptorIndexingEnabled = config.bindless && physicalDeviceInfo.SupportsBindless();
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures{};
+	if( descriptorIndexingEnabled )
+	{
+		deviceExtensions.push_back( VK_KHR_MAINTENANCE3_EXTENSION_NAME );
+		deviceExtensions.push_back( VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME );
+		descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+		descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+		descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+		descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+		descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+		deviceInfo.pNext = &descriptorIndexingFeatures;
+	}
+	deviceInfo.enabledExtensionCount = static_cast<uint32_t>( deviceExtensions.size() );
+	deviceInfo.ppEnabledExtensionNames = deviceExtensions.data();
 	if( enableValidationLayer )
 	{
 		deviceInfo.enabledLayerCount = static_cast<uint32_t>( validationLayer.size() );
@@ -187,48 +495,35 @@ void HelloTriangleApp::CreateLogicalDevice()
 		deviceInfo.ppEnabledLayerNames = nullptr;
 	}
 
-	if( vkCreateDevice( physicalDevice, &deviceInfo, nullptr, &device ) != VK_SUCCESS )
+	if( vkCreateDevice( physicalDevice, &deviceInfo, HostAllocator::Callbacks(), &device ) != VK_SUCCESS )
 		throw std::runtime_error( "Failed to create Logical Device" );
 
-	vkGetDeviceQueue( device, indices.GetGraphicsFamilyValue(), 0, &graphicsQueue );
-	vkGetDeviceQueue( device, indices.GetPresentFamilyValue(), 0, &presentQueue );
-}
+	queues.Init( device, indices );
 
-VKAPI_ATTR VkBool32 VKAPI_CALL HelloTriangleApp::debugCallback( 
-	VkDebugUtilsMessageSeverityFlagBitsEXT messageSaverity, 
-	VkDebugUtilsMessageTypeFlagsEXT messageType, 
-	const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, 
-	void* pUserData )
-{
-	std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl;
-	return VK_FALSE;
-}
-
-void HelloTriangleApp::PopulateDebugUtilsMessengerCreateInfoEXT( VkDebugUtilsMessengerCreateInfoEXT& createInfo )
-{
-	createInfo = {};
-	createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-	createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT |
-		VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
-	createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT |
-		VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT;
-	createInfo.pfnUserCallback = debugCallback;
-	createInfo.pUserData = nullptr;
+	if( drawIndirectCountSupported )
+		cmdDrawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+			vkGetDeviceProcAddr( device, "vkCmdDrawIndexedIndirectCountKHR" ) );
+	if( !config.headless )
+		vkGetDeviceQueue( device, indices.GetPresentFamilyValue(), 0, &presentQueue );
 }
 
 void HelloTriangleApp::SetupDebugMessenger()
 {
+	TRACE_ZONE( "SetupDebugMessenger" );
 	if( !enableValidationLayer ) return;
 
 	VkDebugUtilsMessengerCreateInfoEXT createInfo{};
-	PopulateDebugUtilsMessengerCreateInfoEXT( createInfo );
+	validationSink.PopulateCreateInfo( createInfo );
 
-	if( DebugUtilsMessengerEXT::Create( instance, &createInfo, nullptr, &debugMessenger ) != VK_SUCCESS )
+	if( DebugUtilsMessengerEXT::Create( instance, &createInfo, HostAllocator::Callbacks(), &debugMessenger ) != VK_SUCCESS )
 		throw std::runtime_error( "Failed to setup debug messenger!" );
 }
 
 void HelloTriangleApp::CreateSurface()
 {
+	TRACE_ZONE( "CreateSurface" );
+	if( config.headless ) return;
+
 	/*VkWin32SurfaceCreateInfoKHR surfaceInfo{};
 	surfaceInfo.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
 	surfaceInfo.flags = 0;
@@ -236,16 +531,17 @@ void HelloTriangleApp::CreateSurface()
 	surfaceInfo.hwnd = glfwGetWin32Window( window );
 	surfaceInfo.hinstance = GetModuleHandle( nullptr );
 
-	if( vkCreateWin32SurfaceKHR( instance, &surfaceInfo, nullptr, &surface ) != VK_SUCCESS )
+	if( vkCreateWin32SurfaceKHR( instance, &surfaceInfo, HostAllocator::Callbacks(), &surface ) != VK_SUCCESS )
 		throw std::runtime_error( "Failed to create Surface" );*/
 
-	if( glfwCreateWindowSurface( instance, window, nullptr, &surface ) != VK_SUCCESS )
+	if( glfwCreateWindowSurface( instance, window, HostAllocator::Callbacks(), &surface ) != VK_SUCCESS )
 		throw std::runtime_error( "Failed to create Surface" );
 }
 
 void HelloTriangleApp::CreateSwapChain()
 {
-	SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport( physicalDevice );
+	TRACE_ZONE( "CreateSwapChain" );
+	const SwapChainSupportDetails& swapChainSupport = physicalDeviceInfo.swapChainSupport;
 	VkSurfaceFormatKHR surfaceFormat = ChooseSwapSurfaceFormat( swapChainSupport.format );
 	VkPresentModeKHR presentMode = ChooseSwapPresentMode( swapChainSupport.presentationModes );
 	VkExtent2D extent = ChooseSwapExtent( swapChainSupport.capabilities );
@@ -266,7 +562,7 @@ void HelloTriangleApp::CreateSwapChain()
 	swapchainInfo.imageArrayLayers = 1;
 	swapchainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
-	QueueFamilyIndices indices = FindQueueFamilies( physicalDevice );
+	const QueueFamilyIndices& indices = physicalDeviceInfo.queueIndices;
 	uint32_t queueFamilyIndices [] = { indices.GetGraphicsFamilyValue(), indices.GetPresentFamilyValue() };
 	if( indices.graphicsFamily != indices.presentFamily )
 	{
@@ -283,13 +579,16 @@ void HelloTriangleApp::CreateSwapChain()
 	swapchainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 	swapchainInfo.presentMode = presentMode;
 	swapchainInfo.clipped = VK_TRUE;
-	swapchainInfo.oldSwapchain = VK_NULL_HANDLE;
+	// saat resize: swap chain lama masih hidup (di-retire), driver boleh pakai ulang resource nya
+	swapchainInfo.oldSwapchain = swapchain;
 	// -------------
 
 	// Creating Swapchain
 	// ------------------
-	if( vkCreateSwapchainKHR( device, &swapchainInfo, nullptr, &swapchain ) != VK_SUCCESS )
+	VkSwapchainKHR newSwapchain;
+	if( vkCreateSwapchainKHR( device, &swapchainInfo, HostAllocator::Callbacks(), &newSwapchain ) != VK_SUCCESS )
 		throw std::runtime_error( "Failed to create swapchain !" );
+	swapchain = newSwapchain;
 	// ------------------
 
 	// Retrieving Swapchain Images
@@ -306,8 +605,104 @@ void HelloTriangleApp::CreateSwapChain()
 	// ------------------------------------------------------------------------------------
 }
 
+bool HelloTriangleApp::RecreateSwapChain()
+{
+	TRACE_ZONE( "RecreateSwapChain" );
+	physicalDeviceInfo.RefreshSurfaceCapabilities( surface );
+
+	int width = 0, height = 0;
+	glfwGetFramebufferSize( window, &width, &height );
+	const VkExtent2D extent = ChooseSwapExtent( physicalDeviceInfo.swapChainSupport.capabilities );
+	if( width == 0 || height == 0 || extent.width == 0 || extent.height == 0 )
+	{
+		// minimized: tidak ada yang bisa di-render, tidur sampai ada event window
+		glfwWaitEvents();
+		return false;
+	}
+
+	// Resource lama belum tentu selesai dipakai GPU / presentation engine,
+	// jadi tidak di-destroy di sini (tanpa vkDeviceWaitIdle), tapi di DestroyRetiredSwapchains()
+	RetiredSwapchain retired;
+	retired.retiredFrame = frameNumber;
+	retired.swapchain = swapchain;
+	retired.imageViews = std::move( swapchainImageViews );
+	retired.framebuffers = std::move( swapchainFramebuffers );
+	retiredSwapchains.push_back( std::move( retired ) );
+
+	CreateSwapChain();
+	CreateImageViews();
+	CreateFramebuffers();
+
+	// jumlah image bisa berubah, dan fence lama milik image swap chain lama
+	imagesInFlight.assign( swapchainImages.size(), VK_NULL_HANDLE );
+	swapchainOutOfDate = false;
+	return true;
+}
+
+void HelloTriangleApp::DestroyRetiredSwapchains( bool all )
+{
+	// Frame terakhir yang pakai resource lama = retiredFrame - 1. Di frame N, fence frame N - framesInFlight
+	// sudah ditunggu, jadi N >= retiredFrame + framesInFlight sudah aman (sisa 1 frame buat present terakhir)
+	while( !retiredSwapchains.empty() &&
+		( all || frameNumber >= retiredSwapchains.front().retiredFrame + config.framesInFlight ) )
+	{
+		RetiredSwapchain& retired = retiredSwapchains.front();
+		for( auto& framebuffer : retired.framebuffers )
+			vkDestroyFramebuffer( device, framebuffer, HostAllocator::Callbacks() );
+		for( auto& imageView : retired.imageViews )
+			vkDestroyImageView( device, imageView, HostAllocator::Callbacks() );
+		vkDestroySwapchainKHR( device, retired.swapchain, HostAllocator::Callbacks() );
+		retiredSwapchains.pop_front();
+	}
+}
+
+void HelloTriangleApp::FramebufferResizeCallback( GLFWwindow* window, int /*width*/, int /*height*/ )
+{
+	// dipanggil dari glfwPollEvents (main thread), cukup tandai saja
+	auto app = reinterpret_cast<HelloTriangleApp*>( glfwGetWindowUserPointer( window ) );
+	app->swapchainOutOfDate = true;
+}
+
+void HelloTriangleApp::CreateOffscreenTargets()
+{
+	TRACE_ZONE( "CreateOffscreenTargets" );
+	// Headless mode: tidak ada swap chain, jadi kita bikin sendiri image device-local
+	// yang formatnya fixed (RGBA8) supaya readback ke PPM gampang
+	// ------------------------------------------------------------------------------
+	// minimal sebanyak frames in flight supaya frame N+1 tidak menunggu image frame N
+	const uint32_t offscreenImageCount = std::max( 2U, config.framesInFlight );
+
+	swapchainFormat = VK_FORMAT_R8G8B8A8_UNORM;
+	swapchainExtent = { static_cast<uint32_t>( ScreenWidth ), static_cast<uint32_t>( ScreenHeight ) };
+	swapchainImages.resize( offscreenImageCount );
+	offscreenImageMemories.resize( offscreenImageCount );
+
+	for( uint32_t i = 0; i < offscreenImageCount; ++i )
+	{
+		VkImageCreateInfo imageInfo{};
+		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.format = swapchainFormat;
+		imageInfo.extent = { swapchainExtent.width, swapchainExtent.height, 1 };
+		imageInfo.mipLevels = 1;
+		imageInfo.arrayLayers = 1;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		if( vkCreateImage( device, &imageInfo, HostAllocator::Callbacks(), &swapchainImages[i] ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create offscreen image!" );
+
+		offscreenImageMemories[i] = deviceAllocator.AllocateForImage( swapchainImages[i], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+	}
+	// ------------------------------------------------------------------------------
+}
+
 void HelloTriangleApp::CreateImageViews()
 {
+	TRACE_ZONE( "CreateImageViews" );
 	swapchainImageViews.resize( swapchainImages.size() );
 
 	for( size_t i = 0; i < swapchainImages.size(); ++i )
@@ -331,170 +726,911 @@ void HelloTriangleApp::CreateImageViews()
 		imageViewInfo.subresourceRange.baseArrayLayer = 0;
 		imageViewInfo.subresourceRange.layerCount = 1;
 
-		if( vkCreateImageView( device, &imageViewInfo, nullptr, &swapchainImageViews[i] ) != VK_SUCCESS )
+		if( vkCreateImageView( device, &imageViewInfo, HostAllocator::Callbacks(), &swapchainImageViews[i] ) != VK_SUCCESS )
 			throw std::runtime_error( "Failed to create imageview" );
 	}
 }
 
+void HelloTriangleApp::CreateRenderPass()
+{
+	TRACE_ZONE( "CreateRenderPass" );
+	VkAttachmentDescription colorAttachment{};
+	colorAttachment.format = swapchainFormat;
+	colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+	colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	// transisi layout (ke attachment, lalu ke PRESENT_SRC / TRANSFER_SRC) diurus render graph
+	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	VkAttachmentReference colorAttachmentRef{};
+	colorAttachmentRef.attachment = 0;
+	colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	VkSubpassDescription subpass{};
+	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpass.colorAttachmentCount = 1;
+	subpass.pColorAttachments = &colorAttachmentRef;
+
+	VkRenderPassCreateInfo renderPassInfo{};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassInfo.attachmentCount = 1;
+	renderPassInfo.pAttachments = &colorAttachment;
+	renderPassInfo.subpassCount = 1;
+	renderPassInfo.pSubpasses = &subpass;
+
+	if( vkCreateRenderPass( device, &renderPassInfo, HostAllocator::Callbacks(), &renderPass ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create render pass!" );
+}
+
 void HelloTriangleApp::CreateGraphicsPipeline()
 {
-	auto vertCode = ReadFile( "Shaders/vert.spv" );
-	auto fragCode = ReadFile( "Shdaers/frag.spv" );
+	TRACE_ZONE( "CreateGraphicsPipeline" );
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	const VkDescriptorSetLayout setLayouts[] = { bindless.GetLayout(), uniformRing.GetLayout() };
+	pipelineLayoutInfo.setLayoutCount = 2;
+	pipelineLayoutInfo.pSetLayouts = setLayouts;
+	const VkPushConstantRange meshRange{ VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof( MeshDrawConstants ) };
+	pipelineLayoutInfo.pushConstantRangeCount = mesh.IsLoaded() ? 1 : 0;
+	pipelineLayoutInfo.pPushConstantRanges = &meshRange;
+
+	if( vkCreatePipelineLayout( device, &pipelineLayoutInfo, HostAllocator::Callbacks(), &pipelineLayout ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create pipeline layout!" );
+
+	GraphicsPipelineDesc desc;
+	desc.vertShader = "vert.spv";
+	desc.fragShader = "frag.spv";
+	desc.extent = swapchainExtent;
+	desc.dynamicViewport = true;			// swap chain boleh di-resize tanpa bikin ulang pipeline
+	desc.layout = pipelineLayout;
+	desc.renderPass = renderPass;
+	if( mesh.IsLoaded() )
+	{
+		desc.vertShader = "meshvert.spv";
+		desc.vertexAttributes = mesh.VertexAttributes();
+		const auto instance = VertexLayout::InstanceAttributes( 3 );
+		desc.vertexAttributes.insert( desc.vertexAttributes.end(), instance.begin(), instance.end() );
+		desc.vertexBindings[0].stride = mesh.Header().vertexStride;
+		// winding obj (CCW, y ke atas) setelah y dibalik di shader
+		desc.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	}
 
-	VkShaderModule vertShaderModule = CreatingShaderModule( vertCode );
-	VkShaderModule fragShaderModule = CreatingShaderModule( fragCode );
+	if( config.pipelineBuildReport > 0 )
+	{
+		const auto variants = PipelineBuilder::MakeVariants( desc, config.pipelineBuildReport,
+			physicalDeviceInfo.features.fillModeNonSolid );
+		pipelineBuilder.ReportParallelSpeedup( variants );
+	}
 
-	// Creating shader stage info
-	// --------------------------
-	VkPipelineShaderStageCreateInfo vertStageInfo{};
-	vertStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	vertStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-	vertStageInfo.module = vertShaderModule;
-	vertStageInfo.pName = "main";
+	// shader module + pipeline dibuat di worker thread, sementara main thread lanjut bikin framebuffer dll
+	graphicsPipelineFuture = pipelineBuilder.Submit( desc, &graphicsPipelineMs );
+}
 
-	VkPipelineShaderStageCreateInfo fragStageInfo{};
-	fragStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	fragStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-	fragStageInfo.module = fragShaderModule;
-	fragStageInfo.pName = "main";
-	// --------------------------
+void HelloTriangleApp::CreateCullingPipeline( const std::vector<InstanceData>& instances, const std::vector<DrawCommand>& instanceDraws )
+{
+	// satu object per instance, bounding sphere segitiga (vertex terjauh ~0.71 dari pusat), mesh: kubus [-0.5, 0.5] (~0.87)
+	const float radius = config.meshPath.empty() ? 0.71f : 0.87f;
+	std::vector<CullObject> objects( instances.size() );
+	for( size_t i = 0; i < instances.size(); ++i )
+	{
+		objects[i].sphere[0] = instances[i].offset[0];
+		objects[i].sphere[1] = instances[i].offset[1];
+		objects[i].sphere[2] = 0.0f;
+		objects[i].sphere[3] = radius * instances[i].scale;
+		objects[i].indexCount = instanceDraws[i].indexCount;
+		objects[i].firstIndex = instanceDraws[i].firstIndex;
+		objects[i].vertexOffset = instanceDraws[i].vertexOffset;
+		objects[i].firstInstance = static_cast<uint32_t>( i );
+	}
 
-	VkPipelineShaderStageCreateInfo shaderStages[] = { vertStageInfo, fragStageInfo };
+	const uint32_t maxDrawIndirectCount = physicalDeviceInfo.features.multiDrawIndirect ? physicalDeviceInfo.properties.limits.maxDrawIndirectCount : 1;
+	culling.Init( device, pipelineCache.Get(), deviceAllocator, uploads, objects, cmdDrawIndexedIndirectCount, maxDrawIndirectCount );
+}
 
-	vkDestroyShaderModule( device, vertShaderModule, nullptr );
-	vkDestroyShaderModule( device, fragShaderModule, nullptr );
+void HelloTriangleApp::LoadMesh()
+{
+	TRACE_ZONE( "LoadMesh" );
+	const auto start = std::chrono::steady_clock::now();
+	mesh = MeshFile::Load( config.meshPath );
+	meshConstants = mesh.DrawConstants();
+	meshLods.assign( &mesh.Lod( 0 ), &mesh.Lod( 0 ) + mesh.LodCount() );
+	meshUnitScale = mesh.UnitScale();
+	const std::chrono::duration<double, std::milli> mapTime = std::chrono::steady_clock::now() - start;
+	meshMapMs = mapTime.count();
 }
 
-VkShaderModule HelloTriangleApp::CreatingShaderModule( const std::vector<char>& code )
+void HelloTriangleApp::CreateGeometryBuffers()
 {
-	VkShaderModuleCreateInfo shaderModuleInfo{};
-	shaderModuleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-	shaderModuleInfo.codeSize = code.size();
-	shaderModuleInfo.pCode = reinterpret_cast<const uint32_t*>( code.data() );
+	TRACE_ZONE( "CreateGeometryBuffers" );
+	std::vector<Vertex> vertices = {
+		{ { -0.5f, -0.5f }, { 1.0f, 0.0f, 0.0f } },
+		{ { 0.5f, -0.5f }, { 0.0f, 1.0f, 0.0f } },
+		{ { 0.0f, 0.5f }, { 0.0f, 0.0f, 1.0f } }
+	};
+	std::vector<uint16_t> indices = { 0, 1, 2 };
+
+	// scene benchmark yang lebih berat: lingkaran dari meshTriangles segitiga (fan dari titik tengah)
+	// ------------------------------------------------------------------------------------------------
+	if( config.meshTriangles > 1 && !mesh.IsLoaded() )
+	{
+		constexpr float twoPi = 6.28318530718f;
+		vertices = { { { 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } } };
+		indices.clear();
+		for( uint32_t i = 0; i <= config.meshTriangles; ++i )
+		{
+			const float angle = twoPi * static_cast<float>( i ) / static_cast<float>( config.meshTriangles );
+			vertices.push_back( { { 0.5f * std::cos( angle ), 0.5f * std::sin( angle ) },
+				{ 0.5f + 0.5f * std::cos( angle ), 0.5f + 0.5f * std::sin( angle ), 0.5f } } );
+		}
+		for( uint32_t i = 0; i < config.meshTriangles; ++i )
+		{
+			indices.push_back( 0 );
+			indices.push_back( static_cast<uint16_t>( i + 1 ) );
+			indices.push_back( static_cast<uint16_t>( i + 2 ) );
+		}
+	}
+	// ------------------------------------------------------------------------------------------------
+
+	// Instance di grid kolom x kolom yang menutupi layar, 1 instance = ukuran dan posisi semula
+	// -----------------------------------------------------------------------------------------
+	const uint32_t instanceCount = std::max( 1U, config.instanceCount );
+	const uint32_t columns = static_cast<uint32_t>( std::ceil( std::sqrt( static_cast<double>( instanceCount ) ) ) );
+	const float cell = 2.0f / static_cast<float>( columns );
+
+	std::vector<InstanceData> instances( instanceCount );
+	for( uint32_t i = 0; i < instanceCount; ++i )
+	{
+		instances[i].offset[0] = -1.0f + cell * ( static_cast<float>( i % columns ) + 0.5f );
+		instances[i].offset[1] = -1.0f + cell * ( static_cast<float>( i / columns ) + 0.5f );
+		instances[i].scale = 1.0f / static_cast<float>( columns );
+	}
+	// -----------------------------------------------------------------------------------------
+
+	// LOD per instance: level paling kasar yang error nya di layar <= config.lodThreshold pixel.
+	// Proyeksi nya orthographic, jadi "jarak" diwakili instance.scale: 1 unit kubus mesh = scale * layar / 2 pixel.
+	// Instance diurutkan per LOD supaya instance dengan LOD yang sama berurutan (satu draw per LOD).
+	// ----------------------------------------------------------------------------------------------------------------
+	std::vector<uint32_t> instanceLod( instanceCount, 0 );
+	if( meshLods.size() > 1 )
+	{
+		const float pixelsPerUnit = 0.5f * static_cast<float>( std::max( swapchainExtent.width, swapchainExtent.height ) );
+		for( uint32_t i = 0; i < instanceCount; ++i )
+		{
+			for( uint32_t level = 1; level < meshLods.size(); ++level )
+			{
+				const float screenError = meshLods[level].error * meshUnitScale * instances[i].scale * pixelsPerUnit;
+				if( screenError > config.lodThreshold )
+					break;
+				instanceLod[i] = level;
+			}
+		}
+
+		std::vector<uint32_t> order( instanceCount );
+		std::iota( order.begin(), order.end(), 0U );
+		std::stable_sort( order.begin(), order.end(), [&instanceLod]( uint32_t a, uint32_t b ) { return instanceLod[a] < instanceLod[b]; } );
+		std::vector<InstanceData> sortedInstances( instanceCount );
+		std::vector<uint32_t> sortedLod( instanceCount );
+		for( uint32_t i = 0; i < instanceCount; ++i )
+		{
+			sortedInstances[i] = instances[order[i]];
+			sortedLod[i] = instanceLod[order[i]];
+		}
+		instances.swap( sortedInstances );
+		instanceLod.swap( sortedLod );
+	}
+	// ----------------------------------------------------------------------------------------------------------------
+
+	// --mesh: vertex/index langsung dari halaman file yang di-mmap, tanpa parse
+	const auto copyStart = std::chrono::steady_clock::now();
+	const void* vertexData = vertices.data();
+	const void* indexData = indices.data();
+	VkDeviceSize vertexSize = sizeof( Vertex ) * vertices.size();
+	VkDeviceSize indexSize = sizeof( uint16_t ) * indices.size();
+	uint32_t indexCount = static_cast<uint32_t>( indices.size() );
+	if( mesh.IsLoaded() )
+	{
+		vertexData = mesh.VertexData();
+		indexData = mesh.IndexData();
+		vertexSize = mesh.VertexBytes();
+		indexSize = mesh.IndexBytes();
+		indexCount = mesh.Header().indexCount;
+		indexType = mesh.IndexType();
+	}
+
+	// device local, isinya lewat staging ring di transfer queue
+	const VkDeviceSize instanceSize = sizeof( InstanceData ) * instances.size();
+
+	CreateBuffer( vertexSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexBufferMemory );
+	CreateBuffer( indexSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexBufferMemory );
+	CreateBuffer( instanceSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, instanceBuffer, instanceBufferMemory );
+
+	uploads.UploadBuffer( vertexBuffer, 0, vertexData, vertexSize );
+	uploads.UploadBuffer( indexBuffer, 0, indexData, indexSize, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT );
+	uploads.UploadBuffer( instanceBuffer, 0, instances.data(), instanceSize );
+
+	if( mesh.IsLoaded() )
+	{
+		const std::chrono::duration<double, std::milli> copyTime = std::chrono::steady_clock::now() - copyStart;
+		const VkDeviceSize unquantizedSize = mesh.UnquantizedVertexBytes();
+		std::cout << "mesh: " << config.meshPath << ", " << mesh.Header().vertexCount << " vertices, " << meshLods[0].indexCount / 3 << " triangles + "
+			<< meshLods.size() - 1 << " LOD (" << indexCount / 3 << " total), loaded in "
+			<< meshMapMs + copyTime.count() << " ms (mmap " << meshMapMs << " ms + staging copy " << copyTime.count() << " ms, no parse)" << std::endl;
+		std::cout << "mesh: GPU memory " << ( vertexSize + indexSize ) / 1024 << " KiB (vertex " << vertexSize / 1024 << " KiB"
+			<< ( mesh.IsQuantized() ? ", quantized" : ", not quantized" ) << " + index " << indexSize / 1024 << " KiB), unquantized vertex data would be "
+			<< unquantizedSize / 1024 << " KiB (" << 100 * vertexSize / std::max<VkDeviceSize>( unquantizedSize, 1 ) << "%)" << std::endl;
+		// isinya sudah di staging ring, mapping nya tidak dipakai lagi
+		mesh = MeshFile();
+	}
 
-	VkShaderModule shaderModule;
-	if( vkCreateShaderModule( device, &shaderModuleInfo, nullptr, &shaderModule) != VK_SUCCESS )
-		throw std::runtime_error( "Failed to create shader module!");
-	
-	return shaderModule;
+	// range index buffer per LOD (tanpa --mesh: satu range, seluruh index buffer)
+	std::vector<DrawCommand> lodDraws( 1 );
+	lodDraws[0].indexCount = indexCount;
+	if( !meshLods.empty() )
+	{
+		lodDraws.resize( meshLods.size() );
+		for( size_t level = 0; level < meshLods.size(); ++level )
+		{
+			lodDraws[level].indexCount = meshLods[level].indexCount;
+			lodDraws[level].firstIndex = meshLods[level].firstIndex;
+		}
+	}
+
+	drawList.clear();
+	if( meshLods.size() > 1 )
+	{
+		// satu vkCmdDrawIndexed per LOD yang dipakai, config.drawCalls tidak berlaku
+		std::vector<uint32_t> lodInstances( meshLods.size(), 0 );
+		for( uint32_t lod : instanceLod )
+			++lodInstances[lod];
+		uint32_t firstInstance = 0;
+		for( size_t level = 0; level < meshLods.size(); ++level )
+		{
+			if( lodInstances[level] == 0 )
+				continue;
+			DrawCommand draw = lodDraws[level];
+			draw.instanceCount = lodInstances[level];
+			draw.firstInstance = firstInstance;
+			drawList.push_back( draw );
+			firstInstance += lodInstances[level];
+		}
+
+		uint64_t lodTriangles = 0;
+		std::cout << "mesh: LOD instances (threshold " << config.lodThreshold << " px):";
+		for( size_t level = 0; level < meshLods.size(); ++level )
+		{
+			std::cout << " " << level << "=" << lodInstances[level];
+			lodTriangles += static_cast<uint64_t>( meshLods[level].indexCount / 3 ) * lodInstances[level];
+		}
+		const uint64_t fullTriangles = static_cast<uint64_t>( meshLods[0].indexCount / 3 ) * instanceCount;
+		std::cout << std::endl << "mesh: triangles per frame " << lodTriangles << " with LOD, " << fullTriangles << " without ("
+			<< 100 * lodTriangles / std::max<uint64_t>( fullTriangles, 1 ) << "%)" << std::endl;
+	}
+	else
+	{
+		// instance dibagi rata ke config.drawCalls vkCmdDrawIndexed (default: semua dalam satu draw)
+		const uint32_t drawCount = std::min( config.drawCalls, instanceCount );
+		drawList.reserve( drawCount );
+		for( uint32_t i = 0; i < drawCount; ++i )
+		{
+			DrawCommand part = lodDraws[0];
+			part.firstInstance = static_cast<uint32_t>( static_cast<uint64_t>( instanceCount ) * i / drawCount );
+			part.instanceCount = static_cast<uint32_t>( static_cast<uint64_t>( instanceCount ) * ( i + 1 ) / drawCount ) - part.firstInstance;
+			drawList.push_back( part );
+		}
+	}
+
+	if( config.gpuCull )
+	{
+		std::vector<DrawCommand> instanceDraws( instanceCount );
+		for( uint32_t i = 0; i < instanceCount; ++i )
+			instanceDraws[i] = lodDraws[instanceLod[i]];
+		CreateCullingPipeline( instances, instanceDraws );
+	}
 }
 
-std::vector<const char*> HelloTriangleApp::GetRequiredExtension()
+void HelloTriangleApp::CreateBuffer( VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+	VkBuffer& buffer, DeviceAllocation& allocation )
 {
-	uint32_t glfwExtensionsCount = 0U;
-	const char** glfwExtensions = glfwGetRequiredInstanceExtensions( &glfwExtensionsCount );
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = size;
+	bufferInfo.usage = usage;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-	std::vector<const char*> extensions( glfwExtensions, glfwExtensions + glfwExtensionsCount );
-	if( enableValidationLayer )
-		extensions.push_back( "VK_EXT_debug_utils" );
+	if( vkCreateBuffer( device, &bufferInfo, HostAllocator::Callbacks(), &buffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create buffer!" );
 
-	return extensions;
+	allocation = deviceAllocator.AllocateForBuffer( buffer, properties );
 }
 
-int HelloTriangleApp::RateDeviceSuitability( VkPhysicalDevice device )
+void HelloTriangleApp::CreateFramebuffers()
 {
-	VkPhysicalDeviceProperties deviceProperties;
-	VkPhysicalDeviceFeatures deviceFeatures;
-	vkGetPhysicalDeviceProperties( device, &deviceProperties );
-	vkGetPhysicalDeviceFeatures( device, &deviceFeatures );
+	TRACE_ZONE( "CreateFramebuffers" );
+	swapchainFramebuffers.resize( swapchainImageViews.size() );
 
-	int score = 0;
+	for( size_t i = 0; i < swapchainImageViews.size(); ++i )
+	{
+		VkImageView attachments[] = { swapchainImageViews[i] };
+
+		VkFramebufferCreateInfo framebufferInfo{};
+		framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferInfo.renderPass = renderPass;
+		framebufferInfo.attachmentCount = 1;
+		framebufferInfo.pAttachments = attachments;
+		framebufferInfo.width = swapchainExtent.width;
+		framebufferInfo.height = swapchainExtent.height;
+		framebufferInfo.layers = 1;
+
+		if( vkCreateFramebuffer( device, &framebufferInfo, HostAllocator::Callbacks(), &swapchainFramebuffers[i] ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create framebuffer!" );
+	}
+}
 
-	if( !deviceFeatures.geometryShader )
-		return 0;
+void HelloTriangleApp::CreateCommandPool()
+{
+	TRACE_ZONE( "CreateCommandPool" );
+	const QueueFamilyIndices& indices = physicalDeviceInfo.queueIndices;
 
-	if( deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU )
-		score += 1000;
+	VkCommandPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	poolInfo.queueFamilyIndex = indices.GetGraphicsFamilyValue();
+	// command buffer di-reset dan di-record ulang tiap frame
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 
-	score += deviceProperties.limits.maxImageDimension2D;
+	if( vkCreateCommandPool( device, &poolInfo, HostAllocator::Callbacks(), &commandPool ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create command pool!" );
+}
+
+void HelloTriangleApp::CreateCommandBuffers()
+{
+	TRACE_ZONE( "CreateCommandBuffers" );
+	commandBuffers.resize( config.framesInFlight );
 
-	return 0;
+	VkCommandBufferAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocInfo.commandPool = commandPool;
+	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocInfo.commandBufferCount = static_cast<uint32_t>( commandBuffers.size() );
+
+	if( vkAllocateCommandBuffers( device, &allocInfo, commandBuffers.data() ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to allocate command buffers!" );
+}
+
+void HelloTriangleApp::RecordCommandBuffer( VkCommandBuffer commandBuffer, uint32_t imageIndex, const UploadBatch& uploadBatch )
+{
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	if( vkBeginCommandBuffer( commandBuffer, &beginInfo ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to begin recording command buffer!" );
+
+	// query pool frame ini di-reset, hasil pemakaian sebelumnya dibaca dulu
+	profiler.BeginFrame( commandBuffer, currentFrame );
+
+	// ambil alih buffer/image yang baru di-upload di transfer queue
+	uploads.RecordAcquire( commandBuffer, uploadBatch );
+	// mip texture yang mip 0 nya ada di uploadBatch, sebelum draw mana pun sampling dari image nya
+	if( !config.textureDir.empty() )
+		textureStreamer.RecordMipGeneration( commandBuffer );
+
+	graphImageIndex = imageIndex;
+	renderGraph.SetImportedImage( backbuffer, swapchainImages[imageIndex] );
+	renderGraph.Execute( commandBuffer );
+
+	if( vkEndCommandBuffer( commandBuffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to record command buffer!" );
 }
 
-std::pair<VkPhysicalDeviceProperties, VkPhysicalDeviceFeatures> HelloTriangleApp::GetPhysicalDevicePropertiesAndFeatures( VkPhysicalDevice physicalDevice ) const
+void HelloTriangleApp::RecordMainPass( VkCommandBuffer commandBuffer )
 {
-	VkPhysicalDeviceProperties deviceProperties;
-	VkPhysicalDeviceFeatures deviceFeatures;
-	vkGetPhysicalDeviceProperties( physicalDevice, &deviceProperties );
-	vkGetPhysicalDeviceFeatures( physicalDevice, &deviceFeatures );
+	VkClearValue clearColor{};
+	clearColor.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+	VkRenderPassBeginInfo renderPassInfo{};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	renderPassInfo.renderPass = renderPass;
+	renderPassInfo.framebuffer = swapchainFramebuffers[graphImageIndex];
+	renderPassInfo.renderArea.offset = { 0, 0 };
+	renderPassInfo.renderArea.extent = swapchainExtent;
+	renderPassInfo.clearValueCount = 1;
+	renderPassInfo.pClearValues = &clearColor;
+
+	profiler.BeginPass( commandBuffer, "main" );
+	if( config.gpuCull )
+	{
+		vkCmdBeginRenderPass( commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE );
+		BindGeometry( commandBuffer );
+		culling.RecordDraws( commandBuffer );
+	}
+	else if( config.recordThreads == 0 )
+	{
+		vkCmdBeginRenderPass( commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE );
+		RecordDraws( commandBuffer, drawList, 0, drawList.size() );
+	}
+	else
+	{
+		// draw list di-record paralel ke secondary command buffer, primary cuma execute
+		vkCmdBeginRenderPass( commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS );
+
+		VkCommandBufferInheritanceInfo inheritance{};
+		inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance.renderPass = renderPass;
+		inheritance.subpass = 0;
+		inheritance.framebuffer = swapchainFramebuffers[graphImageIndex];
+
+		const auto& secondaries = recorder.Record( inheritance, drawList.size(), [this]( VkCommandBuffer secondary, size_t begin, size_t end )
+			{
+				RecordDraws( secondary, drawList, begin, end );
+			} );
+		if( !secondaries.empty() )
+			vkCmdExecuteCommands( commandBuffer, static_cast<uint32_t>( secondaries.size() ), secondaries.data() );
+	}
+	vkCmdEndRenderPass( commandBuffer );
+	profiler.EndPass( commandBuffer );
+}
 
-	return { deviceProperties, deviceFeatures };
+void HelloTriangleApp::BindGeometry( VkCommandBuffer commandBuffer )
+{
+	vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline );
+
+	// dynamic state tidak diwarisi secondary command buffer, jadi di-set di sini
+	const VkViewport viewport{ 0.0f, 0.0f, static_cast<float>( swapchainExtent.width ), static_cast<float>( swapchainExtent.height ), 0.0f, 1.0f };
+	const VkRect2D scissor{ { 0, 0 }, swapchainExtent };
+	vkCmdSetViewport( commandBuffer, 0, 1, &viewport );
+	vkCmdSetScissor( commandBuffer, 0, 1, &scissor );
+
+	const VkBuffer vertexBuffers[] = { vertexBuffer, instanceBuffer };
+	const VkDeviceSize offsets[] = { 0, 0 };
+	vkCmdBindVertexBuffers( commandBuffer, 0, 2, vertexBuffers, offsets );
+	vkCmdBindIndexBuffer( commandBuffer, indexBuffer, 0, indexType );
+	if( !config.meshPath.empty() )
+		vkCmdPushConstants( commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof( meshConstants ), &meshConstants );
+	bindless.Bind( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, currentFrame );
+	uniformRing.Bind( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, frameUniformOffset );
 }
 
-VkPhysicalDeviceProperties HelloTriangleApp::GetPhysicalDeviceProperties( VkPhysicalDevice physicalDevice ) const
+void HelloTriangleApp::WriteFrameUniforms()
 {
-	VkPhysicalDeviceProperties properties;
-	vkGetPhysicalDeviceProperties( physicalDevice, &properties );
-	return properties;
+	// view transform identitas: gambar sama dengan sebelum ada ring, shader cuma membaca dari slice frame ini
+	FrameUniforms frame{};
+	frame.viewScale[0] = 1.0f;
+	frame.viewScale[1] = 1.0f;
+	frame.frameNumber = static_cast<uint32_t>( frameNumber );
+	// culling harus melihat view yang sama dengan vertex shader
+	if( config.gpuCull )
+		culling.SetViewTransform( frame.viewScale, frame.viewOffset );
+	const UniformSlice slice = uniformRing.Push( frame );
+	if( slice.data == nullptr )
+		throw std::runtime_error( "Uniform ring has no room for the frame uniforms" );
+	frameUniformOffset = slice.offset;
 }
 
-VkPhysicalDeviceFeatures HelloTriangleApp::GetPhysicalDeviceFeatures( VkPhysicalDevice physicalDevice ) const
+void HelloTriangleApp::RecordDraws( VkCommandBuffer commandBuffer, const std::vector<DrawCommand>& draws, size_t begin, size_t end )
 {
-	VkPhysicalDeviceFeatures features;
-	vkGetPhysicalDeviceFeatures( physicalDevice, &features );
-	return features;
+	BindGeometry( commandBuffer );
+	for( size_t i = begin; i < end; ++i )
+		vkCmdDrawIndexed( commandBuffer, draws[i].indexCount, draws[i].instanceCount, draws[i].firstIndex, draws[i].vertexOffset, draws[i].firstInstance );
 }
 
-QueueFamilyIndices HelloTriangleApp::FindQueueFamilies( VkPhysicalDevice device )
+void HelloTriangleApp::RunRecordBenchmark( size_t drawCount )
 {
-	QueueFamilyIndices indices;
+	constexpr int iterations = 5;
+
+	const std::vector<DrawCommand> draws( drawCount );
 
-	uint32_t queueFamiliesCount = 0;
-	vkGetPhysicalDeviceQueueFamilyProperties( device, &queueFamiliesCount, nullptr );
-	std::vector<VkQueueFamilyProperties> queueFamilies( queueFamiliesCount );
-	vkGetPhysicalDeviceQueueFamilyProperties( device, &queueFamiliesCount, queueFamilies.data() );
+	VkCommandBufferInheritanceInfo inheritance{};
+	inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	inheritance.renderPass = renderPass;
+	inheritance.subpass = 0;
+	inheritance.framebuffer = swapchainFramebuffers[0];
 
-	VkBool32 isPresentSupport = false;
-	int i = 0;
-	for( const auto& queueFamily : queueFamilies )
+	// 1, 2, 4, ... sampai jumlah core
+	std::vector<uint32_t> threadCounts;
+	const uint32_t maxThreads = std::max( 1U, std::thread::hardware_concurrency() );
+	for( uint32_t threads = 1; threads < maxThreads; threads *= 2 )
+		threadCounts.push_back( threads );
+	threadCounts.push_back( maxThreads );
+
+	double singleThreadMs = 0.0;
+	for( uint32_t threads : threadCounts )
 	{
-		if( ( queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT ) && !indices.graphicsFamily.has_value() )
-			indices.graphicsFamily = i;
+		ParallelRecorder benchRecorder;
+		benchRecorder.Init( device, queues.GetFamily( QueueType::Graphics ), 1, threads );
 
-		vkGetPhysicalDeviceSurfaceSupportKHR( device, i, surface, &isPresentSupport );
+		// ambil yang tercepat, iterasi pertama sekaligus warm-up pool driver
+		double bestMs = std::numeric_limits<double>::max();
+		for( int i = 0; i < iterations; ++i )
+		{
+			const auto start = std::chrono::steady_clock::now();
+			benchRecorder.BeginFrame( 0 );
+			benchRecorder.Record( inheritance, draws.size(), [this, &draws]( VkCommandBuffer secondary, size_t begin, size_t end )
+				{
+					RecordDraws( secondary, draws, begin, end );
+				} );
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			bestMs = std::min( bestMs, elapsed.count() );
+		}
+		benchRecorder.CleanUp();
 
-		if( isPresentSupport && !indices.presentFamily.has_value() )
-			indices.presentFamily = i;
+		if( threads == 1 )
+			singleThreadMs = bestMs;
+		std::cout << "record " << drawCount << " draws: " << threads << " threads " << bestMs << " ms ("
+			<< singleThreadMs / bestMs << "x)" << std::endl;
+	}
+}
 
-		if( indices.IsComplete() )
-			break;
+void HelloTriangleApp::CreateSyncObjects()
+{
+	TRACE_ZONE( "CreateSyncObjects" );
+	imageAvailableSemaphores.resize( config.framesInFlight );
+	renderFinishedSemaphores.resize( config.framesInFlight );
+	inFlightFences.resize( config.framesInFlight );
+	imagesInFlight.resize( swapchainImages.size(), VK_NULL_HANDLE );
+
+	VkSemaphoreCreateInfo semaphoreInfo{};
+	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+	// dibuat dalam keadaan signaled supaya frame pertama tidak nunggu selamanya
+	VkFenceCreateInfo fenceInfo{};
+	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+	for( uint32_t i = 0; i < config.framesInFlight; ++i )
+	{
+		// headless: tidak ada acquire/present, fence saja sudah cukup
+		if( !config.headless )
+		{
+			if( vkCreateSemaphore( device, &semaphoreInfo, HostAllocator::Callbacks(), &imageAvailableSemaphores[i] ) != VK_SUCCESS ||
+				vkCreateSemaphore( device, &semaphoreInfo, HostAllocator::Callbacks(), &renderFinishedSemaphores[i] ) != VK_SUCCESS )
+				throw std::runtime_error( "Failed to create semaphores for a frame!" );
+		}
+
+		if( vkCreateFence( device, &fenceInfo, HostAllocator::Callbacks(), &inFlightFences[i] ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create fence for a frame!" );
+	}
+}
+
+void HelloTriangleApp::LoadTextures()
+{
+	TRACE_ZONE( "LoadTextures" );
+	textureStreamer.Init( device, physicalDevice, pipelineCache.Get(), deviceAllocator, uploads, bindless, config.framesInFlight,
+		static_cast<VkDeviceSize>( config.textureBudgetMB ) << 20, config.textureThreads );
+
+	// urutan handle sama di tiap run
+	std::vector<std::string> paths;
+	for( const auto& entry : std::filesystem::directory_iterator( config.textureDir ) )
+	{
+		if( entry.is_regular_file() && ImageDecoder::IsSupported( entry.path().string() ) )
+			paths.push_back( entry.path().string() );
+	}
+	std::sort( paths.begin(), paths.end() );
+
+	for( const auto& path : paths )
+		textures.push_back( textureStreamer.Load( path ) );
+	std::cout << "textures: streaming " << textures.size() << " files from " << config.textureDir << std::endl;
+}
+
+void HelloTriangleApp::BuildRenderGraph()
+{
+	TRACE_ZONE( "BuildRenderGraph" );
+	renderGraph.Init( device, deviceAllocator );
+
+	// awal frame: swap chain image baru di-acquire (semaphore ditunggu di COLOR_ATTACHMENT_OUTPUT),
+	// offscreen image terakhir dipakai copy readback / transisi akhir frame sebelumnya di stage TRANSFER
+	if( config.headless )
+	{
+		backbuffer = renderGraph.ImportImage( "backbuffer", VK_NULL_HANDLE, VK_IMAGE_ASPECT_COLOR_BIT,
+			VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT );
+	}
+	else
+	{
+		backbuffer = renderGraph.ImportImage( "backbuffer", VK_NULL_HANDLE, VK_IMAGE_ASPECT_COLOR_BIT,
+			VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+			VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0 );
+	}
+	renderGraph.MarkOutput( backbuffer );
+
+	// compute pass: isi indirect (+ count) buffer untuk render pass di bawah.
+	// Draw frame sebelumnya (queue yang sama) terakhir membaca buffer ini di DRAW_INDIRECT.
+	std::vector<RenderGraphHandle> cullOutputs;
+	if( config.gpuCull )
+	{
+		cullOutputs.push_back( renderGraph.ImportBuffer( "cull indirect", culling.GetIndirectBuffer(),
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT ) );
+		if( culling.IsCompacting() )
+		{
+			cullOutputs.push_back( renderGraph.ImportBuffer( "cull count", culling.GetCountBuffer(),
+				VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT ) );
+		}
+
+		auto cull = renderGraph.AddPass( "cull" );
+		// count buffer di-nol-kan dengan vkCmdFillBuffer sebelum dispatch
+		for( RenderGraphHandle output : cullOutputs )
+		{
+			cull.Write( output, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT );
+		}
+		cull.Execute( [this]( VkCommandBuffer commandBuffer )
+			{
+				profiler.BeginPass( commandBuffer, "cull" );
+				culling.RecordCull( commandBuffer );
+				profiler.EndPass( commandBuffer );
+			} );
+	}
+
+	auto main = renderGraph.AddPass( "main" );
+	main.Write( backbuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL );
+	for( RenderGraphHandle input : cullOutputs )
+		main.Read( input, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT );
+	main.Execute( [this]( VkCommandBuffer commandBuffer ) { RecordMainPass( commandBuffer ); } );
+
+	renderGraph.Compile();
+	if( !config.renderGraphDumpPath.empty() )
+		renderGraph.WriteDump( config.renderGraphDumpPath );
+}
+
+void HelloTriangleApp::DrawFrame()
+{
+	TRACE_ZONE( "DrawFrame" );
+
+	// Tunggu sampai GPU selesai dengan frame yang pakai slot ini (framesInFlight frame yang lalu),
+	// CPU boleh jalan duluan sejauh framesInFlight - 1 frame
+	{
+		TRACE_ZONE( "WaitFrameFence" );
+		vkWaitForFences( device, 1, &inFlightFences[currentFrame], VK_TRUE, std::numeric_limits<uint64_t>::max() );
+	}
+	uniformRing.BeginFrame( currentFrame );
+	WriteFrameUniforms();
+
+	if( !config.headless )
+	{
+		DestroyRetiredSwapchains( false );
+		// resize / OUT_OF_DATE di frame sebelumnya. Minimized = frame ini dilewati
+		if( swapchainOutOfDate && !RecreateSwapChain() )
+			return;
+	}
+
+	uint32_t imageIndex;
+	{
+		TRACE_ZONE( "AcquireImage" );
+		if( config.headless )
+			imageIndex = static_cast<uint32_t>( frameNumber % swapchainImages.size() );
+		else
+		{
+			const VkResult acquireResult = vkAcquireNextImageKHR( device, swapchain, std::numeric_limits<uint64_t>::max(),
+				imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex );
+			// OUT_OF_DATE: semaphore tidak di-signal dan fence belum di-reset, jadi frame ini aman dilewati
+			if( acquireResult == VK_ERROR_OUT_OF_DATE_KHR )
+			{
+				swapchainOutOfDate = true;
+				return;
+			}
+			// SUBOPTIMAL: image nya tetap valid, frame ini tetap di-render, swap chain dibuat ulang setelah present
+			if( acquireResult == VK_SUBOPTIMAL_KHR )
+				swapchainOutOfDate = true;
+			else if( acquireResult != VK_SUCCESS )
+				throw std::runtime_error( "Failed to acquire swap chain image!" );
+		}
+
+		// kalau image ini masih dipakai frame lain (image count != framesInFlight), tunggu frame itu
+		if( imagesInFlight[imageIndex] != VK_NULL_HANDLE )
+			vkWaitForFences( device, 1, &imagesInFlight[imageIndex], VK_TRUE, std::numeric_limits<uint64_t>::max() );
+		imagesInFlight[imageIndex] = inFlightFences[currentFrame];
+	}
+
+	// descriptor yang dilepas framesInFlight frame lalu boleh dipakai ulang, set fallback frame ini boleh ditulis.
+	// Baru di sini (frame ini pasti di-submit): frame yang dilewati di atas tidak boleh ikut menghitung umur slot
+	bindless.BeginFrame( currentFrame );
+
+	// semua upload frame ini jalan di transfer queue, overlap dengan frame sebelumnya yang masih di GPU
+	// semua texture dianggap terlihat (belum ada material), tapi LRU tetap jalan kalau budget nya kecil
+	if( !config.textureDir.empty() )
+	{
+		for( TextureHandle texture : textures )
+			textureStreamer.Touch( texture );
+		textureStreamer.Update( currentFrame );
+	}
+
+	UploadBatch uploadBatch;
+	{
+		TRACE_ZONE( "FlushUploads" );
+		uploadBatch = uploads.Flush();
+	}
+
+	{
+		TRACE_ZONE( "RecordCommands" );
+		vkResetCommandBuffer( commandBuffers[currentFrame], 0 );
+		if( config.recordThreads > 0 )
+			recorder.BeginFrame( currentFrame );
+		RecordCommandBuffer( commandBuffers[currentFrame], imageIndex, uploadBatch );
+	}
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+
+	VkSemaphore waitSemaphores[2];
+	VkPipelineStageFlags waitStages[2];
+	uint32_t waitCount = 0;
+	if( !config.headless )
+	{
+		waitSemaphores[waitCount] = imageAvailableSemaphores[currentFrame];
+		waitStages[waitCount++] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	}
+	if( uploadBatch.semaphore != VK_NULL_HANDLE )
+	{
+		waitSemaphores[waitCount] = uploadBatch.semaphore;
+		waitStages[waitCount++] = uploadBatch.waitStage;
+	}
+	submitInfo.waitSemaphoreCount = waitCount;
+	submitInfo.pWaitSemaphores = waitSemaphores;
+	submitInfo.pWaitDstStageMask = waitStages;
+	if( !config.headless )
+	{
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &renderFinishedSemaphores[currentFrame];
+	}
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
+
+	{
+		TRACE_ZONE( "Submit" );
+		vkResetFences( device, 1, &inFlightFences[currentFrame] );
+		queues.Submit( QueueType::Graphics, submitInfo, inFlightFences[currentFrame] );
+	}
 
-		++i;
+	if( !config.headless )
+	{
+		VkPresentInfoKHR presentInfo{};
+		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pWaitSemaphores = &renderFinishedSemaphores[currentFrame];
+		presentInfo.swapchainCount = 1;
+		presentInfo.pSwapchains = &swapchain;
+		presentInfo.pImageIndices = &imageIndex;
+
+		TRACE_ZONE( "Present" );
+		const VkResult presentResult = queues.Present( presentQueue, presentInfo );
+		framePacer.MarkPresented();
+		if( presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR )
+			swapchainOutOfDate = true;
+		else if( presentResult != VK_SUCCESS )
+			throw std::runtime_error( "Failed to present swap chain image!" );
 	}
+	else
+		framePacer.MarkPresented();		// headless: "present" = submit
 
-	return indices;
+	if( config.headless && static_cast<int64_t>( frameNumber ) == config.readbackFrame )
+	{
+		TRACE_ZONE( "Readback" );
+		// readback sekali saja: boleh stall di frame ini
+		vkWaitForFences( device, 1, &inFlightFences[currentFrame], VK_TRUE, std::numeric_limits<uint64_t>::max() );
+		SaveTargetToPPM( imageIndex, config.readbackPath );
+	}
+
+	// tampilan in-app: waktu GPU per pass di judul window
+	if( window != nullptr && profiler.IsEnabled() && frameNumber % 60 == 0 )
+	{
+		std::string title = "Learning Vulkan";
+		for( const auto& pass : profiler.GetStats() )
+			title += " | " + pass.name + " " + std::to_string( pass.avgMs ) + " ms";
+		glfwSetWindowTitle( window, title.c_str() );
+	}
+
+	currentFrame = ( currentFrame + 1 ) % config.framesInFlight;
+	++frameNumber;
 }
 
-SwapChainSupportDetails HelloTriangleApp::QuerySwapChainSupport( VkPhysicalDevice physicalDevice )
+void HelloTriangleApp::SaveTargetToPPM( uint32_t imageIndex, const std::string& path )
 {
-	SwapChainSupportDetails details;
-	
-	// Get Basic Surface Capabilites details
-	vkGetPhysicalDeviceSurfaceCapabilitiesKHR( physicalDevice, surface, &details.capabilities );
+	const VkDeviceSize imageSize = static_cast<VkDeviceSize>( swapchainExtent.width ) * swapchainExtent.height * 4;
+
+	// Staging buffer yang host-visible buat nampung hasil copy
+	// --------------------------------------------------------
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = imageSize;
+	bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	VkBuffer readbackBuffer;
+	if( vkCreateBuffer( device, &bufferInfo, HostAllocator::Callbacks(), &readbackBuffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create readback buffer!" );
+
+	DeviceAllocation readbackMemory = deviceAllocator.AllocateForBuffer( readbackBuffer,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+	// --------------------------------------------------------
+
+	// One-shot copy image -> buffer
+	// -----------------------------
+	// image ditulis oleh graphics queue, jadi copy nya di graphics queue juga (tanpa ownership transfer)
+	queues.SubmitImmediate( QueueType::Graphics, [&]( VkCommandBuffer copyCmd )
+	{
+		// render graph sudah transisi ke TRANSFER_SRC + bikin tulisan color attachment visible buat transfer
+		// (barrier terakhir graph, submit sebelumnya di queue yang sama), jadi langsung copy
+		VkBufferImageCopy region{};
+		region.bufferOffset = 0;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = { swapchainExtent.width, swapchainExtent.height, 1 };
+		vkCmdCopyImageToBuffer( copyCmd, swapchainImages[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer, 1, &region );
+	} );
+	// -----------------------------
+
+	// Tulis sebagai binary PPM (P6), alpha dibuang
+	// -------------------------------------------
+	// sudah persistently mapped oleh allocator
+	const auto* pixels = static_cast<const uint8_t*>( readbackMemory.mapped );
+
+	std::ofstream out( path, std::ios::binary );
+	if( !out )
+		throw std::runtime_error( "Failed to open readback file " + path );
+
+	out << "P6\n" << swapchainExtent.width << " " << swapchainExtent.height << "\n255\n";
+	std::vector<char> row( static_cast<size_t>( swapchainExtent.width ) * 3 );
+	for( uint32_t y = 0; y < swapchainExtent.height; ++y )
+	{
+		const uint8_t* src = pixels + static_cast<size_t>( y ) * swapchainExtent.width * 4;
+		for( uint32_t x = 0; x < swapchainExtent.width; ++x )
+		{
+			row[x * 3 + 0] = static_cast<char>( src[x * 4 + 0] );
+			row[x * 3 + 1] = static_cast<char>( src[x * 4 + 1] );
+			row[x * 3 + 2] = static_cast<char>( src[x * 4 + 2] );
+		}
+		out.write( row.data(), static_cast<std::streamsize>( row.size() ) );
+	}
+	out.close();
+	// -------------------------------------------
+
+	vkDestroyBuffer( device, readbackBuffer, HostAllocator::Callbacks() );
+	deviceAllocator.Free( readbackMemory );
+}
 
-	// Get Surface Format details
-	// ----------------------
-	uint32_t surfaceFormatCount = 0;
-	vkGetPhysicalDeviceSurfaceFormatsKHR( physicalDevice, surface, &surfaceFormatCount, nullptr );
-	if( surfaceFormatCount != 0 )
+std::vector<const char*> HelloTriangleApp::GetRequiredExtension()
+{
+	std::vector<const char*> extensions;
+
+	// headless: GLFW tidak di-init, jadi tidak butuh surface extensions
+	if( !config.headless )
 	{
-		details.format.resize( static_cast<size_t>(surfaceFormatCount) );
-		vkGetPhysicalDeviceSurfaceFormatsKHR( physicalDevice, surface, &surfaceFormatCount, details.format.data() );
+		uint32_t glfwExtensionsCount = 0U;
+		const char** glfwExtensions = glfwGetRequiredInstanceExtensions( &glfwExtensionsCount );
+		extensions.assign( glfwExtensions, glfwExtensions + glfwExtensionsCount );
 	}
-	// ----------------------
+	if( enableValidationLayer )
+		extensions.push_back( "VK_EXT_debug_utils" );
 
-	// Get Presentation Modes details
-	// --------------------------
-	uint32_t presentationModesCount = 0;
-	vkGetPhysicalDeviceSurfacePresentModesKHR( physicalDevice, surface, &presentationModesCount, nullptr );
-	if( presentationModesCount != 0 )
+	// opsional, buat query feature descriptor indexing (bindless)
+	if( config.bindless )
 	{
-		details.presentationModes.resize( static_cast<size_t>(presentationModesCount) );
-		vkGetPhysicalDeviceSurfacePresentModesKHR( physicalDevice, surface, &presentationModesCount, details.presentationModes.data() );
+		uint32_t availableCount = 0U;
+		vkEnumerateInstanceExtensionProperties( nullptr, &availableCount, nullptr );
+		std::vector<VkExtensionProperties> available( availableCount );
+		vkEnumerateInstanceExtensionProperties( nullptr, &availableCount, available.data() );
+		for( const auto& extension : available )
+		{
+			if( std::strcmp( extension.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME ) == 0 )
+				extensions.push_back( VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME );
+		}
 	}
-	// --------------------------
 
-	return details;
+	return extensions;
+}
+
+std::vector<const char*> HelloTriangleApp::GetRequiredDeviceExtensions() const
+{
+	if( config.headless )
+		return {};
+	return deviceExtensionsNeeded;
 }
 
 VkSurfaceFormatKHR HelloTriangleApp::ChooseSwapSurfaceFormat( const std::vector<VkSurfaceFormatKHR>& availableSurfaceFormats )
@@ -512,14 +1648,12 @@ VkSurfaceFormatKHR HelloTriangleApp::ChooseSwapSurfaceFormat( const std::vector<
 
 VkPresentModeKHR HelloTriangleApp::ChooseSwapPresentMode( const std::vector<VkPresentModeKHR>& availablePresentModes )
 {
-	for( const auto& a : availablePresentModes )
-	{
-		if( a == VK_PRESENT_MODE_MAILBOX_KHR ) // jika terdapat presentation mode yang capable dalam triple buffering
-			return a;
-	}
-
-	// kalau nggak ada yang capable dalam triple buffering, yaa kita return yang double buffering aja.
-	return VK_PRESENT_MODE_FIFO_KHR;
+	const VkPresentModeKHR mode = ChoosePresentMode( config.presentPolicy, availablePresentModes );
+	// cuma di swap chain pertama, bukan tiap resize
+	if( swapchain == VK_NULL_HANDLE )
+		std::cout << "present policy " << PresentPolicyName( config.presentPolicy ) << ": " << PresentModeName( mode )
+			<< ", " << config.framesInFlight << " frame(s) in flight" << std::endl;
+	return mode;
 }
 
 VkExtent2D HelloTriangleApp::ChooseSwapExtent( const VkSurfaceCapabilitiesKHR& capabilities )
@@ -528,30 +1662,17 @@ VkExtent2D HelloTriangleApp::ChooseSwapExtent( const VkSurfaceCapabilitiesKHR& c
 		return capabilities.currentExtent;
 	else
 	{
-		VkExtent2D actualExtent = { ScreenWidth, ScreenHeight };
+		int width = ScreenWidth, height = ScreenHeight;
+		if( window != nullptr )
+			glfwGetFramebufferSize( window, &width, &height );
+
+		VkExtent2D actualExtent = { static_cast<uint32_t>( width ), static_cast<uint32_t>( height ) };
 		actualExtent.width = std::clamp( actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width );
 		actualExtent.height = std::clamp( actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height );
 		return actualExtent;
 	}
 }
 
-std::vector<char> HelloTriangleApp::ReadFile( const std::string& filename )
-{
-	std::ifstream in( filename, std::ios::ate | std::ios::binary );
-	if( !in )
-	{
-		throw std::runtime_error( "Failed to open shader file" );
-	}
-
-	size_t fileSize = static_cast<size_t>(in.tellg());
-	std::vector<char> buffer( fileSize );
-	in.seekg( 0 );
-	in.read( buffer.data(), fileSize );
-	
-	in.close();
-	return buffer;
-}
-
 bool HelloTriangleApp::CheckExtensionProperties( 
 	const std::vector<const char*>& extensions, std::vector<VkExtensionProperties>& vkExtensions )
 {
@@ -592,62 +1713,3 @@ bool HelloTriangleApp::CheckValidationLayerProperties()
 	return isAvailable;
 }
 
-bool HelloTriangleApp::IsDeviceSuitable( VkPhysicalDevice physicalDevice )
-{
-	/*VkPhysicalDeviceProperties deviceProperties;
-		VkPhysicalDeviceFeatures deviceFeatures;
-		vkGetPhysicalDeviceProperties( device, &deviceProperties );
-		vkGetPhysicalDeviceFeatures( device, &deviceFeatures );
-
-		return deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU &&
-			deviceFeatures.geometryShader;*/
-
-			//kita bakalan gunain apapun graphics card nya
-	QueueFamilyIndices indices = FindQueueFamilies( physicalDevice );
-	bool extensionSupported = CheckDeviceExtensionSupport( physicalDevice );
-
-	// verifying swap chain support
-	// ----------------------------
-	bool swapChainAdequate = false;
-	if( extensionSupported )
-	{
-		SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport( physicalDevice );
-		swapChainAdequate = !swapChainSupport.format.empty() && !swapChainSupport.presentationModes.empty();
-	}
-	// ----------------------------
-
-	return indices.IsComplete() && extensionSupported && swapChainAdequate;
-}
-
-bool HelloTriangleApp::CheckDeviceExtensionSupport( VkPhysicalDevice physicalDevice )
-{
-	uint32_t deviceExtensionsCount = 0;
-	vkEnumerateDeviceExtensionProperties( physicalDevice, nullptr, &deviceExtensionsCount, nullptr );
-	std::vector<VkExtensionProperties> deviceExtensions( deviceExtensionsCount );
-	vkEnumerateDeviceExtensionProperties( physicalDevice, nullptr, &deviceExtensionsCount, deviceExtensions.data() );
-
-	std::set<std::string> requiredExtension( deviceExtensionsNeeded.begin(), deviceExtensionsNeeded.end() );
-	for( const auto& e : deviceExtensions )
-		requiredExtension.erase( e.extensionName );
-
-	return requiredExtension.empty(); //jika kosong, maka akan me-return true
-
-	// ----> kode tepat diatas yang aku komen itu merupakan solusi dari si author vulkan tutorial.
-
-	/*bool isFound = true;
-	for( const auto& e : deviceExtensionsNeeded )
-	{
-		if(
-			std::find_if( deviceExtensions.begin(), deviceExtensions.end(),
-				[e]( const VkExtensionProperties& v )
-				{
-					return std::strcmp( v.extensionName, e ) == 0;
-				}
-			) == deviceExtensions.end() )
-		{
-			isFound = false;
-			break;
-		}
-	}
-	return isFound;*/
-}
@@ -8,16 +8,40 @@
 
 #include <iostream>
 #include <vector>
+#include <deque>
 #include <algorithm>
 #include <string>
 #include <map>
 #include <optional>
 #include <set>
 #include <cstring>
+#include <limits>
 
+#include "AppConfig.h"
+#include "BenchReport.h"
+#include "BindlessDescriptors.h"
+#include "CpuTrace.h"
 #include "DebugUtilsMessengerEXT.h"
+#include "DeviceAllocator.h"
+#include "DrawCommand.h"
+#include "FramePacer.h"
+#include "GpuCulling.h"
+#include "GpuProfiler.h"
+#include "GpuQueues.h"
+#include "HostAllocator.h"
+#include "MeshFile.h"
+#include "PipelineCache.h"
+#include "ParallelRecorder.h"
+#include "PhysicalDeviceInfo.h"
+#include "PipelineBuilder.h"
 #include "QueueFamilyIndices.h"
+#include "RenderGraph.h"
 #include "SwapChainSupportDetails.h"
+#include "TextureStreamer.h"
+#include "UniformRing.h"
+#include "UploadManager.h"
+#include "ValidationSink.h"
+#include "Vertex.h"
 
 // ___ VALIDATION LAYER ____
 #ifdef NDEBUG
@@ -31,6 +55,16 @@ const std::vector<const char*> validationLayer = {
 };
 // _________________________
 
+// uniform per frame (set 1 binding 0, dari uniformRing), layout sama dengan Frame di Shaders/shader.vert dan mesh.vert (std140)
+struct FrameUniforms
+{
+public:
+	float viewScale[2];
+	float viewOffset[2];
+	uint32_t frameNumber;
+	uint32_t padding[3];
+};
+
 //si author vulkan tutorial menamainya "deviceExtensions"
 const std::vector<const char*> deviceExtensionsNeeded = {
 	VK_KHR_SWAPCHAIN_EXTENSION_NAME
@@ -39,6 +73,7 @@ const std::vector<const char*> deviceExtensionsNeeded = {
 class HelloTriangleApp
 {
 public:
+	explicit HelloTriangleApp( const AppConfig& config );
 	void Run();
 
 private:
@@ -57,14 +92,8 @@ private:
 	void CreateLogicalDevice();
 
 	// --- DEBUG MESSENGER ---
+	// pesan nya ke validationSink (ring tanpa lock + writer thread), bukan std::cerr langsung dari callback
 	// -----------------------
-	static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
-		VkDebugUtilsMessageSeverityFlagBitsEXT messageSaverity,
-		VkDebugUtilsMessageTypeFlagsEXT messageType,
-		const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
-		void* pUserData
-	);
-	void PopulateDebugUtilsMessengerCreateInfoEXT( VkDebugUtilsMessengerCreateInfoEXT& createInfo );
 	void SetupDebugMessenger();
 	// -----------------------
 
@@ -73,53 +102,182 @@ private:
 
 	//SWAP CHAIN
 	void CreateSwapChain();
+	// false = window minimized, swap chain belum bisa dibuat
+	bool RecreateSwapChain();
+	void DestroyRetiredSwapchains( bool all );
+	static void FramebufferResizeCallback( GLFWwindow* window, int width, int height );
+
+	//OFFSCREEN TARGETS (headless pengganti swap chain)
+	void CreateOffscreenTargets();
 
 	//IMAGE VIEWS
 	void CreateImageViews();
 
+	//RENDER PASS
+	void CreateRenderPass();
+
 	//GRAPHICS PIPELINE
 	void CreateGraphicsPipeline();
-	VkShaderModule CreatingShaderModule( const std::vector<char>& code );
+
+	//CULLING PIPELINE (compute, isi indirect draw)
+	// instanceDraws[i] = range index buffer (LOD) instance i
+	void CreateCullingPipeline( const std::vector<InstanceData>& instances, const std::vector<DrawCommand>& instanceDraws );
+
+	//VERTEX / INDEX / INSTANCE BUFFERS
+	// --mesh: file di-mmap sebelum pipeline dibuat (vertex layout nya tergantung file)
+	void LoadMesh();
+	void CreateGeometryBuffers();
+	void CreateBuffer( VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+		VkBuffer& buffer, DeviceAllocation& allocation );
+
+	//FRAMEBUFFERS
+	void CreateFramebuffers();
+
+	//COMMAND BUFFERS
+	void CreateCommandPool();
+	void CreateCommandBuffers();
+	void RecordCommandBuffer( VkCommandBuffer commandBuffer, uint32_t imageIndex, const UploadBatch& uploadBatch );
+	void RecordMainPass( VkCommandBuffer commandBuffer );
+	void BindGeometry( VkCommandBuffer commandBuffer );
+	// setelah uniformRing.BeginFrame(), sebelum recording
+	void WriteFrameUniforms();
+	void RecordDraws( VkCommandBuffer commandBuffer, const std::vector<DrawCommand>& draws, size_t begin, size_t end );
+	// record drawCount draw ke secondary dengan 1, 2, 4, ... thread, print waktunya
+	void RunRecordBenchmark( size_t drawCount );
+
+	//TEXTURES (streaming, config.textureDir)
+	void LoadTextures();
+
+	//SYNC OBJECTS
+	void CreateSyncObjects();
+
+	//RENDER GRAPH
+	void BuildRenderGraph();
+
+	// --- FRAME LOOP ---
+	// ------------------
+	void DrawFrame();
+	// ------------------
+
+	// --- HEADLESS ---
+	// ----------------
+	void SaveTargetToPPM( uint32_t imageIndex, const std::string& path );
+	// ----------------
 
 	// --- GETTER ---
 	// --------------
 	std::vector<const char*> GetRequiredExtension();
-	int RateDeviceSuitability( VkPhysicalDevice device );
-	std::pair<VkPhysicalDeviceProperties, VkPhysicalDeviceFeatures>
-		GetPhysicalDevicePropertiesAndFeatures( VkPhysicalDevice physicalDevice ) const;
-	VkPhysicalDeviceProperties GetPhysicalDeviceProperties( VkPhysicalDevice physicalDevice ) const;
-	VkPhysicalDeviceFeatures GetPhysicalDeviceFeatures( VkPhysicalDevice physicalDevice ) const;
-	QueueFamilyIndices FindQueueFamilies( VkPhysicalDevice device );
-	SwapChainSupportDetails QuerySwapChainSupport( VkPhysicalDevice physicalDevice );
+	std::vector<const char*> GetRequiredDeviceExtensions() const;
 	VkSurfaceFormatKHR ChooseSwapSurfaceFormat( const std::vector<VkSurfaceFormatKHR>& availableSurfaceFormats );
 	VkPresentModeKHR ChooseSwapPresentMode( const std::vector<VkPresentModeKHR>& availablePresentModes );
 	VkExtent2D ChooseSwapExtent( const VkSurfaceCapabilitiesKHR& capabilities );
-	std::vector<char> ReadFile( const std::string& filename );
 	// -------------
 
 	// --- CHECKER ---
 	// ---------------
 	bool CheckExtensionProperties( const std::vector<const char*>& extensions, std::vector<VkExtensionProperties>& vkExtensions );
 	bool CheckValidationLayerProperties();
-	bool IsDeviceSuitable( VkPhysicalDevice physicalDevice );
-	bool CheckDeviceExtensionSupport( VkPhysicalDevice physicalDevice );
 	// ---------------
 
 public:
 	static constexpr int ScreenWidth = 800;
 	static constexpr int ScreenHeight = 600;
 private:
-	GLFWwindow* window;
+	AppConfig config;
+	GLFWwindow* window = nullptr;
 	VkInstance instance;
 	VkDebugUtilsMessengerEXT debugMessenger;
-	VkSurfaceKHR surface;
+	ValidationSink validationSink;					// di-Init di InitInstance kalau enableValidationLayer
+	VkSurfaceKHR surface = VK_NULL_HANDLE;
 	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+	PhysicalDeviceInfo physicalDeviceInfo;				// snapshot device terpilih, di-query sekali di PickPhysicalDevice
 	VkDevice device;
-	VkQueue graphicsQueue;
-	VkQueue presentQueue;
-	VkSwapchainKHR swapchain;
+	GpuQueues queues;
+	VkQueue presentQueue = VK_NULL_HANDLE;
+	DeviceAllocator deviceAllocator;
+	UploadManager uploads;
+	VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+	// di headless mode, isinya offscreen VkImage milik kita sendiri (bukan dari swap chain)
 	std::vector<VkImage> swapchainImages;
+	std::vector<DeviceAllocation> offscreenImageMemories;
 	VkFormat swapchainFormat;
 	VkExtent2D swapchainExtent;
 	std::vector<VkImageView> swapchainImageViews;
+	VkRenderPass renderPass;
+	VkPipelineLayout pipelineLayout;
+	VkPipeline graphicsPipeline;
+	std::shared_future<VkPipeline> graphicsPipelineFuture;	// dibuat di background, di-get() sebelum frame pertama
+	double graphicsPipelineMs = 0.0;						// ditulis worker, valid setelah graphicsPipelineFuture.get()
+	PipelineCache pipelineCache;
+	PipelineBuilder pipelineBuilder;
+	std::vector<VkFramebuffer> swapchainFramebuffers;
+	VkCommandPool commandPool;
+	std::vector<VkCommandBuffer> commandBuffers;		// satu per frame in flight, di-record ulang tiap frame
+	ParallelRecorder recorder;						// cuma dipakai kalau config.recordThreads > 0
+	std::vector<DrawCommand> drawList;
+
+	GpuProfiler profiler;							// aktif kalau config.gpuProfilePath tidak kosong
+	FramePacer framePacer;							// frame limiter + latency input -> present
+	BenchReport bench;								// selalu diisi, ditulis kalau config.benchReportPath tidak kosong
+
+	// --- DESCRIPTORS ---
+	BindlessDescriptors bindless;					// set 0 di pipelineLayout
+	PFN_vkGetPhysicalDeviceFeatures2KHR getPhysicalDeviceFeatures2 = nullptr;	// nullptr = instance tanpa get_physical_device_properties2
+	bool descriptorIndexingEnabled = false;
+	UniformRing uniformRing;						// set 1 di pipelineLayout
+	uint32_t frameUniformOffset = 0;				// dynamic offset FrameUniforms frame yang sedang di-record
+	// -------------------
+
+	// --- TEXTURES ---
+	TextureStreamer textureStreamer;				// cuma di-Init kalau config.textureDir tidak kosong
+	std::vector<TextureHandle> textures;
+	// ----------------
+
+	// --- RENDER GRAPH ---
+	RenderGraph renderGraph;						// cull -> main, di-compile sekali di InitVulkan
+	RenderGraphHandle backbuffer = RenderGraph::InvalidHandle;	// image diganti tiap frame (swap chain / offscreen)
+	uint32_t graphImageIndex = 0;					// image yang sedang di-record, dibaca pass di dalam graph
+	// --------------------
+
+	// --- GPU CULLING ---
+	GpuCulling culling;
+	PFN_vkCmdDrawIndexedIndirectCountKHR cmdDrawIndexedIndirectCount = nullptr;	// nullptr = extension tidak ada
+	// -------------------
+
+	// --- GEOMETRY ---
+	VkBuffer vertexBuffer = VK_NULL_HANDLE;
+	DeviceAllocation vertexBufferMemory;
+	VkBuffer indexBuffer = VK_NULL_HANDLE;
+	DeviceAllocation indexBufferMemory;
+	VkBuffer instanceBuffer = VK_NULL_HANDLE;
+	DeviceAllocation instanceBufferMemory;
+	VkIndexType indexType = VK_INDEX_TYPE_UINT16;
+	MeshFile mesh;									// cuma di-map sampai isinya masuk staging (CreateGeometryBuffers)
+	double meshMapMs = 0.0;
+	MeshDrawConstants meshConstants{};				// push constant Shaders/mesh.vert
+	std::vector<MeshLod> meshLods;					// di-copy dari file, tetap ada setelah mapping nya dilepas
+	float meshUnitScale = 1.0f;						// MeshLod::error -> kubus [-0.5, 0.5]
+	// ----------------
+
+	// --- SWAP CHAIN RECREATION ---
+	// swap chain lama + view + framebuffer nya di-destroy framesInFlight frame kemudian, bukan lewat vkDeviceWaitIdle
+	struct RetiredSwapchain
+	{
+		uint64_t retiredFrame = 0;
+		VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+		std::vector<VkImageView> imageViews;
+		std::vector<VkFramebuffer> framebuffers;
+	};
+	std::deque<RetiredSwapchain> retiredSwapchains;
+	bool swapchainOutOfDate = false;				// resize / OUT_OF_DATE / SUBOPTIMAL, dibuat ulang di awal frame berikutnya
+	// -----------------------------
+
+	// --- FRAMES IN FLIGHT ---
+	std::vector<VkSemaphore> imageAvailableSemaphores;
+	std::vector<VkSemaphore> renderFinishedSemaphores;
+	std::vector<VkFence> inFlightFences;
+	std::vector<VkFence> imagesInFlight;				// fence frame yang terakhir pakai image tsb
+	uint32_t currentFrame = 0;
+	uint64_t frameNumber = 0;
+	// ------------------------
 };
\ No newline at end of file
@@ -0,0 +1,346 @@
+#include "HostAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	// Layout satu allocation: [awal block ... padding alignment][Header 16 byte][data user]
+	// Header tepat sebelum pointer user, offset = jarak pointer user ke awal block
+	struct Header
+	{
+		uint64_t size;
+		uint32_t offset;
+		uint16_t sizeClass;
+		uint8_t scope;
+		uint8_t pool;
+	};
+	static_assert( sizeof( Header ) == 16, "Header must keep the user pointer 16 byte aligned" );
+
+	constexpr size_t MinAlignment = 16;
+	constexpr size_t ClassSizes[] = { 64, 128, 256, 512, 1024, 2048, 4096 };
+	constexpr uint32_t ClassCount = sizeof( ClassSizes ) / sizeof( ClassSizes[0] );
+	constexpr uint16_t LargeClass = 0xffff;		// di atas class terbesar: malloc langsung
+	constexpr size_t ChunkSize = 64 * 1024;
+	constexpr uint32_t ScopeCount = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+	// pool 0: COMMAND / OBJECT / CACHE, pool 1: arena DEVICE, pool 2: arena INSTANCE
+	enum PoolIndex : uint8_t
+	{
+		GeneralPool = 0,
+		DeviceArena = 1,
+		InstanceArena = 2,
+		PoolCount = 3
+	};
+
+	class Pool
+	{
+	public:
+		void* Allocate( uint32_t sizeClass )
+		{
+			SizeClass& c = classes[sizeClass];
+			std::lock_guard<std::mutex> lock( c.mutex );
+			if( c.freeList == nullptr )
+			{
+				// chunk baru dipotong jadi block seukuran class, semua masuk free list
+				char* chunk = static_cast<char*>( std::malloc( ChunkSize ) );
+				if( chunk == nullptr )
+					return nullptr;
+				c.chunks.push_back( chunk );
+				reservedBytes.fetch_add( ChunkSize, std::memory_order_relaxed );
+				const size_t blockSize = ClassSizes[sizeClass];
+				// dari belakang, supaya block pertama yang dipakai ada di awal chunk
+				for( size_t i = ChunkSize / blockSize; i-- > 0; )
+				{
+					FreeBlock* block = reinterpret_cast<FreeBlock*>( chunk + i * blockSize );
+					block->next = c.freeList;
+					c.freeList = block;
+				}
+			}
+			FreeBlock* block = c.freeList;
+			c.freeList = block->next;
+			return block;
+		}
+
+		void Free( void* pointer, uint32_t sizeClass )
+		{
+			SizeClass& c = classes[sizeClass];
+			std::lock_guard<std::mutex> lock( c.mutex );
+			FreeBlock* block = static_cast<FreeBlock*>( pointer );
+			block->next = c.freeList;
+			c.freeList = block;
+		}
+
+		// semua block dianggap sudah di-free
+		void Release()
+		{
+			for( SizeClass& c : classes )
+			{
+				std::lock_guard<std::mutex> lock( c.mutex );
+				for( void* chunk : c.chunks )
+					std::free( chunk );
+				c.chunks.clear();
+				c.freeList = nullptr;
+			}
+			reservedBytes.store( 0, std::memory_order_relaxed );
+		}
+
+		uint64_t ReservedBytes() const { return reservedBytes.load( std::memory_order_relaxed ); }
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+		struct SizeClass
+		{
+			std::mutex mutex;
+			FreeBlock* freeList = nullptr;
+			std::vector<void*> chunks;
+		};
+		SizeClass classes[ClassCount];
+		std::atomic<uint64_t> reservedBytes{ 0 };
+	};
+
+	struct ScopeCounters
+	{
+		std::atomic<uint64_t> bytes{ 0 };
+		std::atomic<uint64_t> peakBytes{ 0 };
+		std::atomic<uint64_t> allocations{ 0 };
+		std::atomic<uint64_t> liveAllocations{ 0 };
+		std::atomic<uint64_t> reallocations{ 0 };
+		std::atomic<uint64_t> internalBytes{ 0 };
+		std::atomic<uint64_t> internalPeakBytes{ 0 };
+	};
+
+	Pool pools[PoolCount];
+	ScopeCounters counters[ScopeCount];
+	std::atomic<uint64_t> largeAllocations{ 0 };
+	bool enabled = false;
+	VkAllocationCallbacks callbacks{};
+
+	const char* ScopeName( uint32_t scope )
+	{
+		switch( scope )
+		{
+		case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: return "command";
+		case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT: return "object";
+		case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: return "cache";
+		case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE: return "device";
+		default: return "instance";
+		}
+	}
+
+	PoolIndex PoolFor( VkSystemAllocationScope scope )
+	{
+		if( scope == VK_SYSTEM_ALLOCATION_SCOPE_DEVICE )
+			return DeviceArena;
+		if( scope == VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE )
+			return InstanceArena;
+		return GeneralPool;
+	}
+
+	void RaisePeak( std::atomic<uint64_t>& peak, uint64_t value )
+	{
+		uint64_t current = peak.load( std::memory_order_relaxed );
+		while( value > current && !peak.compare_exchange_weak( current, value, std::memory_order_relaxed ) )
+		{
+		}
+	}
+
+	Header* HeaderOf( void* pointer )
+	{
+		return reinterpret_cast<Header*>( static_cast<char*>( pointer ) - sizeof( Header ) );
+	}
+
+	// block nya cukup untuk header + size + padding alignment (semua block awalnya 16 byte aligned)
+	void* Allocate( size_t size, size_t alignment, VkSystemAllocationScope scope )
+	{
+		alignment = std::max( alignment, MinAlignment );
+		const size_t needed = sizeof( Header ) + size + ( alignment - MinAlignment );
+		uint16_t sizeClass = LargeClass;
+		for( uint32_t c = 0; c < ClassCount; ++c )
+		{
+			if( needed <= ClassSizes[c] )
+			{
+				sizeClass = static_cast<uint16_t>( c );
+				break;
+			}
+		}
+
+		const PoolIndex pool = PoolFor( scope );
+		char* block = nullptr;
+		if( sizeClass == LargeClass )
+		{
+			block = static_cast<char*>( std::malloc( needed ) );
+			largeAllocations.fetch_add( 1, std::memory_order_relaxed );
+		}
+		else
+			block = static_cast<char*>( pools[pool].Allocate( sizeClass ) );
+		// nullptr = VK_ERROR_OUT_OF_HOST_MEMORY di sisi driver
+		if( block == nullptr )
+			return nullptr;
+
+		const uintptr_t user = ( reinterpret_cast<uintptr_t>( block ) + sizeof( Header ) + alignment - 1 ) & ~static_cast<uintptr_t>( alignment - 1 );
+		Header* header = reinterpret_cast<Header*>( user - sizeof( Header ) );
+		header->size = size;
+		header->offset = static_cast<uint32_t>( user - reinterpret_cast<uintptr_t>( block ) );
+		header->sizeClass = sizeClass;
+		header->scope = static_cast<uint8_t>( scope );
+		header->pool = pool;
+
+		ScopeCounters& c = counters[scope];
+		RaisePeak( c.peakBytes, c.bytes.fetch_add( size, std::memory_order_relaxed ) + size );
+		c.allocations.fetch_add( 1, std::memory_order_relaxed );
+		c.liveAllocations.fetch_add( 1, std::memory_order_relaxed );
+		return reinterpret_cast<void*>( user );
+	}
+
+	void Free( void* pointer )
+	{
+		if( pointer == nullptr )
+			return;
+		const Header header = *HeaderOf( pointer );
+		ScopeCounters& c = counters[header.scope];
+		c.bytes.fetch_sub( header.size, std::memory_order_relaxed );
+		c.liveAllocations.fetch_sub( 1, std::memory_order_relaxed );
+
+		char* block = static_cast<char*>( pointer ) - header.offset;
+		if( header.sizeClass == LargeClass )
+			std::free( block );
+		else
+			pools[header.pool].Free( block, header.sizeClass );
+	}
+
+	VKAPI_ATTR void* VKAPI_CALL AllocationCallback( void*, size_t size, size_t alignment, VkSystemAllocationScope scope )
+	{
+		return size == 0 ? nullptr : Allocate( size, alignment, scope );
+	}
+
+	VKAPI_ATTR void* VKAPI_CALL ReallocationCallback( void*, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope )
+	{
+		if( original == nullptr )
+			return AllocationCallback( nullptr, size, alignment, scope );
+		if( size == 0 )
+		{
+			Free( original );
+			return nullptr;
+		}
+
+		Header* header = HeaderOf( original );
+		counters[header->scope].reallocations.fetch_add( 1, std::memory_order_relaxed );
+
+		// muat di block yang sama (dan alignment nya tetap cocok): cukup ganti ukuran, scope nya tetap scope semula
+		const bool aligned = reinterpret_cast<uintptr_t>( original ) % std::max( alignment, MinAlignment ) == 0;
+		if( header->sizeClass != LargeClass && aligned && header->offset + size <= ClassSizes[header->sizeClass] )
+		{
+			ScopeCounters& c = counters[header->scope];
+			if( size > header->size )
+				RaisePeak( c.peakBytes, c.bytes.fetch_add( size - header->size, std::memory_order_relaxed ) + size - header->size );
+			else
+				c.bytes.fetch_sub( header->size - size, std::memory_order_relaxed );
+			header->size = size;
+			return original;
+		}
+
+		// gagal = original tetap valid (sesuai spec)
+		void* moved = Allocate( size, alignment, scope );
+		if( moved == nullptr )
+			return nullptr;
+		std::memcpy( moved, original, std::min<size_t>( size, header->size ) );
+		Free( original );
+		return moved;
+	}
+
+	VKAPI_ATTR void VKAPI_CALL FreeCallback( void*, void* pointer )
+	{
+		Free( pointer );
+	}
+
+	VKAPI_ATTR void VKAPI_CALL InternalAllocationCallback( void*, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope )
+	{
+		ScopeCounters& c = counters[scope];
+		RaisePeak( c.internalPeakBytes, c.internalBytes.fetch_add( size, std::memory_order_relaxed ) + size );
+	}
+
+	VKAPI_ATTR void VKAPI_CALL InternalFreeCallback( void*, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope )
+	{
+		counters[scope].internalBytes.fetch_sub( size, std::memory_order_relaxed );
+	}
+}
+
+void HostAllocator::Init( bool enable )
+{
+	enabled = enable;
+	callbacks = {};
+	callbacks.pfnAllocation = AllocationCallback;
+	callbacks.pfnReallocation = ReallocationCallback;
+	callbacks.pfnFree = FreeCallback;
+	callbacks.pfnInternalAllocation = InternalAllocationCallback;
+	callbacks.pfnInternalFree = InternalFreeCallback;
+}
+
+const VkAllocationCallbacks* HostAllocator::Callbacks()
+{
+	return enabled ? &callbacks : nullptr;
+}
+
+void HostAllocator::ReleaseArena( VkSystemAllocationScope scope )
+{
+	const PoolIndex pool = PoolFor( scope );
+	if( pool == GeneralPool || counters[scope].liveAllocations.load( std::memory_order_relaxed ) != 0 )
+		return;
+	pools[pool].Release();
+}
+
+HostAllocator::ScopeStats HostAllocator::GetStats( VkSystemAllocationScope scope )
+{
+	const ScopeCounters& c = counters[scope];
+	ScopeStats stats;
+	stats.bytes = c.bytes.load( std::memory_order_relaxed );
+	stats.peakBytes = c.peakBytes.load( std::memory_order_relaxed );
+	stats.allocations = c.allocations.load( std::memory_order_relaxed );
+	stats.liveAllocations = c.liveAllocations.load( std::memory_order_relaxed );
+	stats.reallocations = c.reallocations.load( std::memory_order_relaxed );
+	stats.internalBytes = c.internalBytes.load( std::memory_order_relaxed );
+	stats.internalPeakBytes = c.internalPeakBytes.load( std::memory_order_relaxed );
+	return stats;
+}
+
+void HostAllocator::PrintStats( bool leaks )
+{
+	if( !enabled )
+	{
+		std::cout << "host allocator: disabled (--no-host-allocator), driver allocates host memory itself" << std::endl;
+		return;
+	}
+
+	for( uint32_t scope = 0; scope < ScopeCount; ++scope )
+	{
+		const ScopeStats stats = GetStats( static_cast<VkSystemAllocationScope>( scope ) );
+		std::cout << "host allocator " << ScopeName( scope ) << ": " << stats.allocations << " allocations (" << stats.reallocations
+			<< " reallocations), peak " << stats.peakBytes / 1024 << " KiB, driver internal peak " << stats.internalPeakBytes / 1024 << " KiB" << std::endl;
+	}
+	std::cout << "host allocator: pool " << pools[GeneralPool].ReservedBytes() / 1024 << " KiB reserved, device arena "
+		<< pools[DeviceArena].ReservedBytes() / 1024 << " KiB, instance arena " << pools[InstanceArena].ReservedBytes() / 1024 << " KiB, "
+		<< largeAllocations.load( std::memory_order_relaxed ) << " large allocations (> " << ClassSizes[ClassCount - 1] << " B) via malloc" << std::endl;
+
+	if( !leaks )
+		return;
+	bool leaked = false;
+	for( uint32_t scope = 0; scope < ScopeCount; ++scope )
+	{
+		const ScopeStats stats = GetStats( static_cast<VkSystemAllocationScope>( scope ) );
+		if( stats.liveAllocations == 0 )
+			continue;
+		std::cout << "host allocator leak: " << stats.liveAllocations << " " << ScopeName( scope ) << " allocations, "
+			<< stats.bytes << " bytes still allocated" << std::endl;
+		leaked = true;
+	}
+	if( !leaked )
+		std::cout << "host allocator: no leaks" << std::endl;
+}
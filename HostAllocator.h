@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+// VkAllocationCallbacks untuk semua vkCreate* / vkDestroy* / vkAllocateMemory (HostAllocator::Callbacks()).
+// Allocation kecil dari pool per size class (free list per class, chunk 64 KiB), yang besar langsung malloc.
+// Scope DEVICE dan INSTANCE punya arena sendiri (pool terpisah) supaya allocation yang hidup lama tidak
+// bercampur dengan allocation object / command yang sering dibuat-dibuang; arena nya dilepas sekaligus
+// setelah vkDestroyDevice / vkDestroyInstance. Semua fungsi thread safe (callback bisa dari thread mana saja).
+class HostAllocator
+{
+public:
+	struct ScopeStats
+	{
+	public:
+		uint64_t bytes = 0;					// yang diminta driver, belum di-free
+		uint64_t peakBytes = 0;
+		uint64_t allocations = 0;			// total sejak Init
+		uint64_t liveAllocations = 0;
+		uint64_t reallocations = 0;
+		uint64_t internalBytes = 0;			// dialokasi driver sendiri (pfnInternalAllocation), cuma dilaporkan
+		uint64_t internalPeakBytes = 0;
+	};
+
+	// sebelum vkCreateInstance. enabled = false: Callbacks() = nullptr (allocator bawaan driver), buat perbandingan
+	static void Init( bool enabled );
+	static const VkAllocationCallbacks* Callbacks();
+	// setelah object pemilik scope itu di-destroy (DEVICE: vkDestroyDevice, INSTANCE: vkDestroyInstance).
+	// Chunk arena nya cuma dilepas kalau tidak ada allocation scope itu yang masih hidup, selain itu = leak (dibiarkan)
+	static void ReleaseArena( VkSystemAllocationScope scope );
+
+	static ScopeStats GetStats( VkSystemAllocationScope scope );
+	// leaks = true: allocation yang masih hidup per scope juga di-print (panggil setelah vkDestroyInstance)
+	static void PrintStats( bool leaks );
+};
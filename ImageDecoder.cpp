@@ -0,0 +1,187 @@
+#include "ImageDecoder.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+	std::string Extension( const std::string& path )
+	{
+		const size_t dot = path.find_last_of( '.' );
+		std::string extension = dot == std::string::npos ? "" : path.substr( dot + 1 );
+		std::transform( extension.begin(), extension.end(), extension.begin(), []( unsigned char c ) { return static_cast<char>( std::tolower( c ) ); } );
+		return extension;
+	}
+}
+
+DecodedImage ImageDecoder::Decode( const std::string& path )
+{
+	std::ifstream in( path, std::ios::binary );
+	if( !in )
+		throw std::runtime_error( "Failed to open image: " + path );
+	const std::vector<uint8_t> file( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+
+	const std::string extension = Extension( path );
+	if( extension == "ppm" )
+		return DecodePpm( file, path );
+	if( extension == "tga" )
+		return DecodeTga( file, path );
+	throw std::runtime_error( "Unsupported image format: " + path );
+}
+
+bool ImageDecoder::IsSupported( const std::string& path )
+{
+	const std::string extension = Extension( path );
+	return extension == "ppm" || extension == "tga";
+}
+
+DecodedImage ImageDecoder::Downsample( const DecodedImage& image )
+{
+	DecodedImage result;
+	result.width = std::max( 1U, image.width / 2 );
+	result.height = std::max( 1U, image.height / 2 );
+	result.pixels.resize( static_cast<size_t>( result.width ) * result.height * 4 );
+
+	for( uint32_t y = 0; y < result.height; ++y )
+	{
+		const uint32_t y0 = std::min( y * 2, image.height - 1 );
+		const uint32_t y1 = std::min( y * 2 + 1, image.height - 1 );
+		for( uint32_t x = 0; x < result.width; ++x )
+		{
+			const uint32_t x0 = std::min( x * 2, image.width - 1 );
+			const uint32_t x1 = std::min( x * 2 + 1, image.width - 1 );
+			for( uint32_t c = 0; c < 4; ++c )
+			{
+				auto at = [&]( uint32_t px, uint32_t py ) { return image.pixels[( static_cast<size_t>( py ) * image.width + px ) * 4 + c]; };
+				const uint32_t sum = at( x0, y0 ) + at( x1, y0 ) + at( x0, y1 ) + at( x1, y1 );
+				result.pixels[( static_cast<size_t>( y ) * result.width + x ) * 4 + c] = static_cast<uint8_t>( ( sum + 2 ) / 4 );
+			}
+		}
+	}
+	return result;
+}
+
+DecodedImage ImageDecoder::DecodePpm( const std::vector<uint8_t>& file, const std::string& path )
+{
+	// Header: "P6" <width> <height> <maxval>, dipisah whitespace, komentar '#' sampai akhir baris
+	// -----------------------------------------------------------------------------------------
+	size_t pos = 0;
+	auto nextToken = [&]() -> std::string
+	{
+		for( ;; )
+		{
+			while( pos < file.size() && std::isspace( file[pos] ) )
+				++pos;
+			if( pos < file.size() && file[pos] == '#' )
+			{
+				while( pos < file.size() && file[pos] != '\n' )
+					++pos;
+				continue;
+			}
+			break;
+		}
+		std::string token;
+		while( pos < file.size() && !std::isspace( file[pos] ) )
+			token += static_cast<char>( file[pos++] );
+		return token;
+	};
+
+	if( nextToken() != "P6" )
+		throw std::runtime_error( "Only binary PPM (P6) is supported: " + path );
+	DecodedImage image;
+	image.width = static_cast<uint32_t>( std::stoul( nextToken() ) );
+	image.height = static_cast<uint32_t>( std::stoul( nextToken() ) );
+	if( std::stoul( nextToken() ) != 255 )
+		throw std::runtime_error( "Only 8-bit PPM is supported: " + path );
+	++pos;	// satu whitespace setelah maxval
+	// -----------------------------------------------------------------------------------------
+
+	const size_t pixelCount = static_cast<size_t>( image.width ) * image.height;
+	if( image.width == 0 || image.height == 0 || file.size() < pos + pixelCount * 3 )
+		throw std::runtime_error( "Truncated PPM: " + path );
+
+	image.pixels.resize( pixelCount * 4 );
+	for( size_t i = 0; i < pixelCount; ++i )
+	{
+		image.pixels[i * 4 + 0] = file[pos + i * 3 + 0];
+		image.pixels[i * 4 + 1] = file[pos + i * 3 + 1];
+		image.pixels[i * 4 + 2] = file[pos + i * 3 + 2];
+		image.pixels[i * 4 + 3] = 255;
+	}
+	return image;
+}
+
+DecodedImage ImageDecoder::DecodeTga( const std::vector<uint8_t>& file, const std::string& path )
+{
+	constexpr size_t HeaderSize = 18;
+	if( file.size() < HeaderSize )
+		throw std::runtime_error( "Truncated TGA: " + path );
+
+	const uint8_t idLength = file[0];
+	const uint8_t colorMapType = file[1];
+	const uint8_t imageType = file[2];
+	const uint32_t width = file[12] | ( file[13] << 8 );
+	const uint32_t height = file[14] | ( file[15] << 8 );
+	const uint32_t bytesPerPixel = file[16] / 8;
+	const bool topToBottom = ( file[17] & 0x20 ) != 0;
+
+	// 2 = true-color raw, 10 = true-color RLE
+	if( colorMapType != 0 || ( imageType != 2 && imageType != 10 ) || ( bytesPerPixel != 3 && bytesPerPixel != 4 ) )
+		throw std::runtime_error( "Only 24/32-bit true-color TGA is supported: " + path );
+	if( width == 0 || height == 0 )
+		throw std::runtime_error( "Empty TGA: " + path );
+
+	DecodedImage image;
+	image.width = width;
+	image.height = height;
+	const size_t pixelCount = static_cast<size_t>( width ) * height;
+	image.pixels.resize( pixelCount * 4 );
+
+	size_t pos = HeaderSize + idLength;
+	auto readPixel = [&]( size_t index )
+	{
+		if( pos + bytesPerPixel > file.size() )
+			throw std::runtime_error( "Truncated TGA: " + path );
+		// TGA menyimpan BGR(A), baris dari bawah kecuali bit 5 descriptor di-set
+		const size_t x = index % width;
+		const size_t y = topToBottom ? index / width : height - 1 - index / width;
+		uint8_t* out = &image.pixels[( y * width + x ) * 4];
+		out[0] = file[pos + 2];
+		out[1] = file[pos + 1];
+		out[2] = file[pos + 0];
+		out[3] = bytesPerPixel == 4 ? file[pos + 3] : 255;
+	};
+
+	for( size_t i = 0; i < pixelCount; )
+	{
+		if( imageType == 2 )
+		{
+			readPixel( i++ );
+			pos += bytesPerPixel;
+			continue;
+		}
+
+		// RLE: header packet, bit 7 = run (satu pixel diulang), sisanya jumlah - 1
+		if( pos >= file.size() )
+			throw std::runtime_error( "Truncated TGA: " + path );
+		const uint8_t packet = file[pos++];
+		const size_t count = std::min<size_t>( ( packet & 0x7f ) + 1, pixelCount - i );
+		if( packet & 0x80 )
+		{
+			for( size_t n = 0; n < count; ++n )
+				readPixel( i++ );
+			pos += bytesPerPixel;
+		}
+		else
+		{
+			for( size_t n = 0; n < count; ++n )
+			{
+				readPixel( i++ );
+				pos += bytesPerPixel;
+			}
+		}
+	}
+	return image;
+}
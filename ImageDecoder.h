@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pixel RGBA8, baris dari atas ke bawah, tanpa padding
+struct DecodedImage
+{
+public:
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector<uint8_t> pixels;
+
+	size_t ByteSize() const { return pixels.size(); }
+};
+
+// Decoder gambar tanpa library luar: PPM biner (P6, sama dengan output --readback) dan TGA
+// (true-color 24/32 bit, raw atau RLE). Format lain -> std::runtime_error.
+class ImageDecoder
+{
+public:
+	static DecodedImage Decode( const std::string& path );
+	static bool IsSupported( const std::string& path );
+
+	// box filter 2x2 ke mip berikutnya (ukuran ganjil: pixel terakhir di-clamp)
+	static DecodedImage Downsample( const DecodedImage& image );
+
+private:
+	static DecodedImage DecodePpm( const std::vector<uint8_t>& file, const std::string& path );
+	static DecodedImage DecodeTga( const std::vector<uint8_t>& file, const std::string& path );
+};
@@ -1,12 +1,11 @@
 #include "HelloTriangleApp.h"
 
 
-int main()
+int main( int argc, char** argv )
 {
-	HelloTriangleApp app;
-
 	try
 	{
+		HelloTriangleApp app( AppConfig::FromCommandLine( argc, argv ) );
 		app.Run();
 	} catch( const std::exception& e ) {
 		std::cout << e.what() << std::endl;
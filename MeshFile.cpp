@@ -0,0 +1,184 @@
+#include "MeshFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MeshFile MeshFile::Load( const std::string& path )
+{
+	const int fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+	if( fd < 0 )
+		throw std::runtime_error( "Failed to open mesh file " + path );
+
+	struct stat st;
+	if( fstat( fd, &st ) != 0 || static_cast<size_t>( st.st_size ) < sizeof( MeshFileHeader ) )
+	{
+		close( fd );
+		throw std::runtime_error( "Mesh file is too small: " + path );
+	}
+
+	void* mapping = mmap( nullptr, static_cast<size_t>( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+	close( fd );	// mapping tetap valid walaupun fd ditutup
+	if( mapping == MAP_FAILED )
+		throw std::runtime_error( "Failed to mmap mesh file " + path );
+	// seluruh isi file langsung di-copy ke staging, baca duluan supaya tidak page fault satu per satu
+	madvise( mapping, static_cast<size_t>( st.st_size ), MADV_WILLNEED );
+
+	MeshFile mesh;
+	mesh.mapping = mapping;
+	mesh.mappingSize = static_cast<size_t>( st.st_size );
+	mesh.header = static_cast<const MeshFileHeader*>( mapping );
+	mesh.Validate( path );
+	return mesh;
+}
+
+MeshFile::MeshFile( MeshFile&& other ) noexcept
+{
+	*this = std::move( other );
+}
+
+MeshFile& MeshFile::operator=( MeshFile&& other ) noexcept
+{
+	std::swap( mapping, other.mapping );
+	std::swap( mappingSize, other.mappingSize );
+	std::swap( header, other.header );
+	return *this;
+}
+
+MeshFile::~MeshFile()
+{
+	if( mapping != nullptr )
+		munmap( mapping, mappingSize );
+}
+
+void MeshFile::Validate( const std::string& path ) const
+{
+	if( header->magic != MeshFileMagic )
+		throw std::runtime_error( "Not a mesh file: " + path );
+	if( header->version != MeshFileVersion )
+		throw std::runtime_error( "Mesh file version " + std::to_string( header->version ) + " is not supported (expected "
+			+ std::to_string( MeshFileVersion ) + "), convert it again: " + path );
+
+	const uint32_t expectedStride = IsQuantized() ? sizeof( QuantizedMeshVertex ) : sizeof( MeshVertex );
+	if( header->vertexStride != expectedStride )
+		throw std::runtime_error( "Mesh file has unexpected vertex stride: " + path );
+	if( header->indexSize != 2 && header->indexSize != 4 )
+		throw std::runtime_error( "Mesh file has invalid index size: " + path );
+	if( header->indexCount % 3 != 0 )
+		throw std::runtime_error( "Mesh file index count is not a multiple of 3: " + path );
+
+	if( header->fileSize != mappingSize )
+		throw std::runtime_error( "Mesh file is truncated: " + path );
+	if( header->lodCount == 0 || sizeof( MeshFileHeader ) + static_cast<uint64_t>( header->lodCount ) * sizeof( MeshLod ) > mappingSize )
+		throw std::runtime_error( "Mesh file has an invalid LOD table: " + path );
+	for( uint32_t level = 0; level < header->lodCount; ++level )
+	{
+		const MeshLod& lod = Lod( level );
+		if( lod.indexCount == 0 || lod.indexCount % 3 != 0 || static_cast<uint64_t>( lod.firstIndex ) + lod.indexCount > header->indexCount )
+			throw std::runtime_error( "Mesh file LOD " + std::to_string( level ) + " is out of range: " + path );
+	}
+	if( header->vertexOffset % MeshFileAlignment != 0 || header->indexOffset % MeshFileAlignment != 0 )
+		throw std::runtime_error( "Mesh file data is not aligned: " + path );
+	const uint64_t tableEnd = sizeof( MeshFileHeader ) + static_cast<uint64_t>( header->lodCount ) * sizeof( MeshLod );
+	if( header->vertexOffset < tableEnd || header->vertexOffset + VertexBytes() > mappingSize
+		|| header->indexOffset < tableEnd || header->indexOffset + IndexBytes() > mappingSize )
+		throw std::runtime_error( "Mesh file data is out of bounds: " + path );
+}
+
+const void* MeshFile::VertexData() const
+{
+	return static_cast<const std::byte*>( mapping ) + header->vertexOffset;
+}
+
+VkDeviceSize MeshFile::VertexBytes() const
+{
+	return static_cast<VkDeviceSize>( header->vertexCount ) * header->vertexStride;
+}
+
+const void* MeshFile::IndexData() const
+{
+	return static_cast<const std::byte*>( mapping ) + header->indexOffset;
+}
+
+VkDeviceSize MeshFile::IndexBytes() const
+{
+	return static_cast<VkDeviceSize>( header->indexCount ) * header->indexSize;
+}
+
+VkIndexType MeshFile::IndexType() const
+{
+	return header->indexSize == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
+
+const MeshLod& MeshFile::Lod( uint32_t level ) const
+{
+	return reinterpret_cast<const MeshLod*>( header + 1 )[level];
+}
+
+float MeshFile::UnitScale() const
+{
+	float maxExtent = 0.0f;
+	for( int i = 0; i < 3; ++i )
+		maxExtent = std::max( maxExtent, header->boundsMax[i] - header->boundsMin[i] );
+	return maxExtent > 0.0f ? 1.0f / maxExtent : 1.0f;
+}
+
+VkDeviceSize MeshFile::UnquantizedVertexBytes() const
+{
+	return static_cast<VkDeviceSize>( header->vertexCount ) * sizeof( MeshVertex );
+}
+
+std::vector<VkVertexInputAttributeDescription> MeshFile::VertexAttributes() const
+{
+	// format vertex attribute ini wajib di-support semua device (tabel "mandatory format support")
+	if( IsQuantized() )
+	{
+		return {
+			{ 0, 0, VK_FORMAT_R16G16B16A16_UNORM, offsetof( QuantizedMeshVertex, position ) },
+			{ 1, 0, VK_FORMAT_R16G16_SNORM, offsetof( QuantizedMeshVertex, normal ) },
+			{ 2, 0, VK_FORMAT_R16G16_SFLOAT, offsetof( QuantizedMeshVertex, uv ) }
+		};
+	}
+	return {
+		{ 0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof( MeshVertex, position ) },
+		{ 1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof( MeshVertex, normal ) },
+		{ 2, 0, VK_FORMAT_R32G32_SFLOAT, offsetof( MeshVertex, uv ) }
+	};
+}
+
+MeshDrawConstants MeshFile::DrawConstants() const
+{
+	float center[3];
+	float extent[3];
+	float maxExtent = 0.0f;
+	for( int i = 0; i < 3; ++i )
+	{
+		center[i] = 0.5f * ( header->boundsMin[i] + header->boundsMax[i] );
+		extent[i] = header->boundsMax[i] - header->boundsMin[i];
+		maxExtent = std::max( maxExtent, extent[i] );
+	}
+	if( maxExtent <= 0.0f )
+		maxExtent = 1.0f;
+
+	// quantized: shader menerima 0..1 di dalam bounds, float: posisi asli
+	MeshDrawConstants constants{};
+	for( int i = 0; i < 3; ++i )
+	{
+		if( IsQuantized() )
+		{
+			constants.positionScale[i] = extent[i] / maxExtent;
+			constants.positionBias[i] = ( header->boundsMin[i] - center[i] ) / maxExtent;
+		}
+		else
+		{
+			constants.positionScale[i] = 1.0f / maxExtent;
+			constants.positionBias[i] = -center[i] / maxExtent;
+		}
+	}
+	constants.octahedralNormal = IsQuantized() ? 1 : 0;
+	return constants;
+}
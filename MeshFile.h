@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "MeshFormat.h"
+
+// push constant Shaders/mesh.vert: posisi di file -> kubus [-0.5, 0.5] (ukuran segitiga semula)
+struct MeshDrawConstants
+{
+public:
+	float positionScale[4];
+	float positionBias[4];
+	uint32_t octahedralNormal;				// 1 = normal quantized (octahedral), 0 = float3
+	uint32_t padding[3];
+};
+
+// File .mesh yang di-mmap. Load() cuma memvalidasi header dan offset, vertex/index data dibaca
+// langsung dari halaman yang di-map (tanpa parse, tanpa copy ke heap). Mapping dilepas di destructor.
+class MeshFile
+{
+public:
+	static MeshFile Load( const std::string& path );
+
+	MeshFile() = default;
+	MeshFile( const MeshFile& ) = delete;
+	MeshFile& operator=( const MeshFile& ) = delete;
+	MeshFile( MeshFile&& other ) noexcept;
+	MeshFile& operator=( MeshFile&& other ) noexcept;
+	~MeshFile();
+
+	bool IsLoaded() const { return header != nullptr; }
+	const MeshFileHeader& Header() const { return *header; }
+	bool IsQuantized() const { return ( header->flags & MeshFileQuantized ) != 0; }
+
+	const void* VertexData() const;
+	VkDeviceSize VertexBytes() const;
+	const void* IndexData() const;
+	VkDeviceSize IndexBytes() const;
+	VkIndexType IndexType() const;
+	uint32_t LodCount() const { return header->lodCount; }
+	const MeshLod& Lod( uint32_t level ) const;
+	// MeshLod::error * UnitScale() = error di kubus [-0.5, 0.5] yang dipakai DrawConstants()
+	float UnitScale() const;
+	// ukuran vertex buffer kalau mesh yang sama tidak di-quantize, buat perbandingan
+	VkDeviceSize UnquantizedVertexBytes() const;
+
+	// binding 0: location 0 = posisi, 1 = normal, 2 = uv (lihat Shaders/mesh.vert)
+	std::vector<VkVertexInputAttributeDescription> VertexAttributes() const;
+	MeshDrawConstants DrawConstants() const;
+
+private:
+	void Validate( const std::string& path ) const;
+
+private:
+	void* mapping = nullptr;
+	size_t mappingSize = 0;
+	const MeshFileHeader* header = nullptr;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+// Format mesh biner (.mesh): ditulis Tools/MeshConverter, dibaca MeshFile (mmap, tanpa parse).
+// Isi file (little endian):
+//   MeshFileHeader
+//   MeshLod[header.lodCount] langsung setelah header, LOD 0 = mesh asli, makin besar makin kasar
+//   vertex data di header.vertexOffset: QuantizedMeshVertex (flags MeshFileQuantized) atau MeshVertex
+//   index data di header.indexOffset: uint16 / uint32 (header.indexSize), semua LOD berurutan,
+//   semua LOD pakai vertex data yang sama
+// Offset di-align MeshFileAlignment, data nya langsung di-copy ke staging dari halaman yang di-mmap.
+// MeshFileVersion dinaikkan setiap kali layout di atas berubah, file versi lain ditolak (convert ulang).
+
+constexpr uint32_t MeshFileMagic = 0x4853454D;		// "MESH"
+constexpr uint32_t MeshFileVersion = 2;
+constexpr uint64_t MeshFileAlignment = 16;
+
+enum MeshFileFlags : uint32_t
+{
+	MeshFileQuantized = 1 << 0,
+};
+
+struct MeshFileHeader
+{
+public:
+	uint32_t magic = MeshFileMagic;
+	uint32_t version = MeshFileVersion;
+	uint32_t flags = 0;
+	uint32_t vertexCount = 0;
+	uint32_t indexCount = 0;				// total semua LOD
+	uint32_t vertexStride = 0;
+	uint32_t indexSize = 0;					// 2 kalau vertexCount <= 65536, selain itu 4
+	uint32_t lodCount = 0;
+	float boundsMin[3] = {};				// posisi quantized relatif ke bounds ini
+	float boundsMax[3] = {};
+	uint64_t vertexOffset = 0;
+	uint64_t indexOffset = 0;
+	uint64_t fileSize = 0;					// buat menolak file yang terpotong
+};
+
+// Satu level LOD = range di index buffer
+struct MeshLod
+{
+public:
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+	float error = 0.0f;						// batas atas jarak ke permukaan LOD 0, satuan posisi mesh
+	uint32_t reserved = 0;
+};
+
+// 32 byte, tanpa quantization (convert dengan --no-quantize)
+struct MeshVertex
+{
+public:
+	float position[3];
+	float normal[3];
+	float uv[2];
+};
+
+// 16 byte: posisi UNORM16 di dalam bounds (w tidak dipakai), normal octahedral SNORM16, uv half float
+struct QuantizedMeshVertex
+{
+public:
+	uint16_t position[4];
+	int16_t normal[2];
+	uint16_t uv[2];
+};
+
+static_assert( sizeof( MeshFileHeader ) == 80, "MeshFileHeader layout is part of the file format" );
+static_assert( sizeof( MeshLod ) == 16, "MeshLod layout is part of the file format" );
+static_assert( sizeof( MeshVertex ) == 32, "MeshVertex layout is part of the file format" );
+static_assert( sizeof( QuantizedMeshVertex ) == 16, "QuantizedMeshVertex layout is part of the file format" );
@@ -0,0 +1,113 @@
+#include "ParallelRecorder.h"
+#include "CpuTrace.h"
+#include "HostAllocator.h"
+#include <algorithm>
+#include <stdexcept>
+
+void ParallelRecorder::Init( VkDevice device, uint32_t queueFamily, uint32_t framesInFlight, uint32_t threadCount )
+{
+	this->device = device;
+	this->threadCount = std::max( 1U, threadCount );
+	if( this->threadCount > 1 )
+		pool = std::make_unique<ThreadPool>( this->threadCount - 1 );
+
+	frames.resize( framesInFlight );
+	for( auto& workers : frames )
+	{
+		workers.resize( this->threadCount );
+		for( auto& worker : workers )
+		{
+			// tanpa RESET_COMMAND_BUFFER_BIT: reset selalu satu pool sekaligus
+			VkCommandPoolCreateInfo poolInfo{};
+			poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			poolInfo.queueFamilyIndex = queueFamily;
+			poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+			if( vkCreateCommandPool( device, &poolInfo, HostAllocator::Callbacks(), &worker.pool ) != VK_SUCCESS )
+				throw std::runtime_error( "Failed to create worker command pool!" );
+
+			VkCommandBufferAllocateInfo allocInfo{};
+			allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			allocInfo.commandPool = worker.pool;
+			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			allocInfo.commandBufferCount = 1;
+
+			if( vkAllocateCommandBuffers( device, &allocInfo, &worker.commandBuffer ) != VK_SUCCESS )
+				throw std::runtime_error( "Failed to allocate secondary command buffer!" );
+		}
+	}
+	recorded.reserve( this->threadCount );
+}
+
+void ParallelRecorder::CleanUp()
+{
+	pool.reset();
+
+	for( auto& workers : frames )
+	{
+		for( auto& worker : workers )
+			vkDestroyCommandPool( device, worker.pool, HostAllocator::Callbacks() );
+	}
+	frames.clear();
+	recorded.clear();
+}
+
+void ParallelRecorder::BeginFrame( uint32_t frameIndex )
+{
+	currentFrame = frameIndex;
+	for( auto& worker : frames[currentFrame] )
+		vkResetCommandPool( device, worker.pool, 0 );
+}
+
+const std::vector<VkCommandBuffer>& ParallelRecorder::Record( const VkCommandBufferInheritanceInfo& inheritance, size_t itemCount, const RecordRange& recordRange )
+{
+	recorded.clear();
+	if( itemCount == 0 )
+		return recorded;
+
+	const size_t chunkCount = std::min<size_t>( threadCount, itemCount );
+	const size_t chunkSize = ( itemCount + chunkCount - 1 ) / chunkCount;
+
+	// Potongan 1..N-1 ke thread pool, potongan 0 di thread ini
+	// --------------------------------------------------------
+	std::vector<std::future<void>> futures;
+	futures.reserve( chunkCount );
+	for( size_t chunk = 1; chunk < chunkCount; ++chunk )
+	{
+		const size_t begin = chunk * chunkSize;
+		const size_t end = std::min( itemCount, begin + chunkSize );
+		futures.push_back( pool->Submit( [this, chunk, &inheritance, begin, end, &recordRange]
+			{
+				RecordChunk( static_cast<uint32_t>( chunk ), inheritance, begin, end, recordRange );
+			} ) );
+	}
+	RecordChunk( 0, inheritance, 0, std::min( itemCount, chunkSize ), recordRange );
+
+	for( auto& future : futures )
+		future.get();
+	// --------------------------------------------------------
+
+	// urutan secondary = urutan draw list
+	for( size_t chunk = 0; chunk < chunkCount; ++chunk )
+		recorded.push_back( frames[currentFrame][chunk].commandBuffer );
+	return recorded;
+}
+
+void ParallelRecorder::RecordChunk( uint32_t worker, const VkCommandBufferInheritanceInfo& inheritance, size_t begin, size_t end, const RecordRange& recordRange )
+{
+	TRACE_ZONE( "RecordChunk" );
+	VkCommandBuffer commandBuffer = frames[currentFrame][worker].commandBuffer;
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+	beginInfo.pInheritanceInfo = &inheritance;
+
+	if( vkBeginCommandBuffer( commandBuffer, &beginInfo ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to begin secondary command buffer!" );
+
+	recordRange( commandBuffer, begin, end );
+
+	if( vkEndCommandBuffer( commandBuffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to record secondary command buffer!" );
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ThreadPool.h"
+
+// Recording draw list paralel ke secondary command buffer.
+// Tiap worker punya VkCommandPool sendiri per frame in flight (command pool tidak thread-safe),
+// pool nya di-reset sekaligus di BeginFrame(), command buffer tidak pernah di-free per frame.
+// Worker 0 jalan di thread pemanggil, sisanya di thread pool.
+class ParallelRecorder
+{
+public:
+	// record item [begin, end) ke command buffer (secondary, sudah di-begin)
+	using RecordRange = std::function<void( VkCommandBuffer commandBuffer, size_t begin, size_t end )>;
+
+public:
+	void Init( VkDevice device, uint32_t queueFamily, uint32_t framesInFlight, uint32_t threadCount );
+	void CleanUp();
+
+	// panggil setelah fence frame ini signaled
+	void BeginFrame( uint32_t frameIndex );
+
+	// bagi itemCount jadi potongan berurutan, satu per worker. Hasilnya dieksekusi
+	// dengan vkCmdExecuteCommands di render pass yang di-begin dengan SECONDARY_COMMAND_BUFFERS
+	const std::vector<VkCommandBuffer>& Record( const VkCommandBufferInheritanceInfo& inheritance, size_t itemCount, const RecordRange& recordRange );
+
+	uint32_t ThreadCount() const { return threadCount; }
+
+private:
+	void RecordChunk( uint32_t worker, const VkCommandBufferInheritanceInfo& inheritance, size_t begin, size_t end, const RecordRange& recordRange );
+
+private:
+	struct WorkerFrame
+	{
+		VkCommandPool pool = VK_NULL_HANDLE;
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	};
+
+	VkDevice device = VK_NULL_HANDLE;
+	uint32_t threadCount = 1;
+	std::unique_ptr<ThreadPool> pool;
+
+	std::vector<std::vector<WorkerFrame>> frames;	// [frame in flight][worker]
+	uint32_t currentFrame = 0;
+	std::vector<VkCommandBuffer> recorded;
+};
@@ -0,0 +1,168 @@
+#include "PhysicalDeviceInfo.h"
+#include <algorithm>
+#include <cstring>
+
+PhysicalDeviceInfo PhysicalDeviceInfo::Query( VkPhysicalDevice physicalDevice, VkSurfaceKHR surface,
+	PFN_vkGetPhysicalDeviceFeatures2KHR getFeatures2 )
+{
+	PhysicalDeviceInfo info;
+	info.physicalDevice = physicalDevice;
+	vkGetPhysicalDeviceProperties( physicalDevice, &info.properties );
+	vkGetPhysicalDeviceFeatures( physicalDevice, &info.features );
+	vkGetPhysicalDeviceMemoryProperties( physicalDevice, &info.memory );
+
+	uint32_t queueFamiliesCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties( physicalDevice, &queueFamiliesCount, nullptr );
+	info.queueFamilies.resize( queueFamiliesCount );
+	vkGetPhysicalDeviceQueueFamilyProperties( physicalDevice, &queueFamiliesCount, info.queueFamilies.data() );
+
+	uint32_t deviceExtensionsCount = 0;
+	vkEnumerateDeviceExtensionProperties( physicalDevice, nullptr, &deviceExtensionsCount, nullptr );
+	info.extensions.resize( deviceExtensionsCount );
+	vkEnumerateDeviceExtensionProperties( physicalDevice, nullptr, &deviceExtensionsCount, info.extensions.data() );
+
+	info.descriptorIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+	if( getFeatures2 != nullptr && info.HasExtension( VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME ) )
+	{
+		VkPhysicalDeviceFeatures2KHR features2{};
+		features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+		features2.pNext = &info.descriptorIndexing;
+		getFeatures2( physicalDevice, &features2 );
+		info.descriptorIndexing.pNext = nullptr;
+	}
+
+	// Queue families
+	// --------------
+	QueueFamilyIndices& indices = info.queueIndices;
+	for( uint32_t i = 0; i < queueFamiliesCount; ++i )
+	{
+		const VkQueueFlags flags = info.queueFamilies[i].queueFlags;
+		if( ( flags & VK_QUEUE_GRAPHICS_BIT ) && !indices.graphicsFamily.has_value() )
+			indices.graphicsFamily = i;
+
+		// family tanpa GRAPHICS biasanya engine terpisah (DMA / compute), kerjanya bisa overlap dengan rendering
+		const bool noGraphics = !( flags & VK_QUEUE_GRAPHICS_BIT );
+		if( noGraphics && ( flags & VK_QUEUE_COMPUTE_BIT ) && !indices.computeFamily.has_value() )
+			indices.computeFamily = i;
+		if( noGraphics && !( flags & VK_QUEUE_COMPUTE_BIT ) && ( flags & VK_QUEUE_TRANSFER_BIT ) && !indices.transferFamily.has_value() )
+			indices.transferFamily = i;
+
+		// headless: tidak ada surface, present queue tidak dicari sama sekali
+		if( surface != VK_NULL_HANDLE )
+		{
+			VkBool32 isPresentSupport = VK_FALSE;
+			vkGetPhysicalDeviceSurfaceSupportKHR( physicalDevice, i, surface, &isPresentSupport );
+			if( isPresentSupport && !indices.presentFamily.has_value() )
+				indices.presentFamily = i;
+		}
+	}
+
+	// Fallback: compute family juga bisa transfer, graphics family bisa semuanya
+	if( indices.graphicsFamily.has_value() )
+	{
+		if( !indices.transferFamily.has_value() )
+			indices.transferFamily = indices.computeFamily.value_or( indices.GetGraphicsFamilyValue() );
+		if( !indices.computeFamily.has_value() )
+			indices.computeFamily = indices.graphicsFamily;
+	}
+	// --------------
+
+	// Surface: format dan present mode tidak berubah, capabilities (currentExtent) bisa berubah kalau window di-resize
+	// ---------------------------------------------------------------------------------------------------------------
+	if( surface != VK_NULL_HANDLE )
+	{
+		SwapChainSupportDetails& details = info.swapChainSupport;
+		vkGetPhysicalDeviceSurfaceCapabilitiesKHR( physicalDevice, surface, &details.capabilities );
+
+		uint32_t surfaceFormatCount = 0;
+		vkGetPhysicalDeviceSurfaceFormatsKHR( physicalDevice, surface, &surfaceFormatCount, nullptr );
+		details.format.resize( surfaceFormatCount );
+		vkGetPhysicalDeviceSurfaceFormatsKHR( physicalDevice, surface, &surfaceFormatCount, details.format.data() );
+
+		uint32_t presentationModesCount = 0;
+		vkGetPhysicalDeviceSurfacePresentModesKHR( physicalDevice, surface, &presentationModesCount, nullptr );
+		details.presentationModes.resize( presentationModesCount );
+		vkGetPhysicalDeviceSurfacePresentModesKHR( physicalDevice, surface, &presentationModesCount, details.presentationModes.data() );
+	}
+	// ---------------------------------------------------------------------------------------------------------------
+
+	return info;
+}
+
+void PhysicalDeviceInfo::RefreshSurfaceCapabilities( VkSurfaceKHR surface )
+{
+	vkGetPhysicalDeviceSurfaceCapabilitiesKHR( physicalDevice, surface, &swapChainSupport.capabilities );
+}
+
+bool PhysicalDeviceInfo::HasExtension( const char* name ) const
+{
+	return std::any_of( extensions.begin(), extensions.end(), [name]( const VkExtensionProperties& e )
+		{
+			return std::strcmp( e.extensionName, name ) == 0;
+		} );
+}
+
+VkDeviceSize PhysicalDeviceInfo::DeviceLocalBytes() const
+{
+	VkDeviceSize largest = 0;
+	for( uint32_t i = 0; i < memory.memoryHeapCount; ++i )
+	{
+		if( memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT )
+			largest = std::max( largest, memory.memoryHeaps[i].size );
+	}
+	return largest;
+}
+
+const char* PhysicalDeviceInfo::TypeName() const
+{
+	switch( properties.deviceType )
+	{
+	case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "discrete";
+	case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+	case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "virtual";
+	case VK_PHYSICAL_DEVICE_TYPE_CPU: return "cpu";
+	default: return "other";
+	}
+}
+
+bool PhysicalDeviceInfo::SupportsBindless() const
+{
+	const VkPhysicalDeviceDescriptorIndexingFeaturesEXT& f = descriptorIndexing;
+	return HasExtension( VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME ) && HasExtension( VK_KHR_MAINTENANCE3_EXTENSION_NAME ) &&
+		f.descriptorBindingPartiallyBound && f.descriptorBindingUpdateUnusedWhilePending &&
+		f.descriptorBindingSampledImageUpdateAfterBind && f.descriptorBindingStorageBufferUpdateAfterBind &&
+		f.runtimeDescriptorArray && f.shaderSampledImageArrayNonUniformIndexing;
+}
+
+int64_t PhysicalDeviceInfo::Score( const DeviceRequirements& requirements ) const
+{
+	// Syarat wajib
+	// ------------
+	if( !queueIndices.graphicsFamily.has_value() )
+		return -1;
+	for( const char* extension : requirements.extensions )
+	{
+		if( !HasExtension( extension ) )
+			return -1;
+	}
+	if( requirements.present && ( !queueIndices.presentFamily.has_value() ||
+		swapChainSupport.format.empty() || swapChainSupport.presentationModes.empty() ) )
+		return -1;
+	// ------------
+
+	// tipe device selalu menang, heap (dalam MB) cuma memecah seri di tipe yang sama
+	int64_t typeRank = 0;
+	switch( properties.deviceType )
+	{
+	case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: typeRank = 4; break;
+	case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: typeRank = 3; break;
+	case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: typeRank = 2; break;
+	case VK_PHYSICAL_DEVICE_TYPE_CPU: typeRank = 1; break;
+	default: break;
+	}
+
+	// opsional: tanpa drawIndirectFirstInstance GPU culling fallback ke draw biasa, jadi cuma memecah seri di tipe yang sama
+	const int64_t featureRank = requirements.drawIndirectFirstInstance && features.drawIndirectFirstInstance ? 1 : 0;
+
+	return ( typeRank << 40 ) + ( featureRank << 39 ) + static_cast<int64_t>( DeviceLocalBytes() >> 20 );
+}
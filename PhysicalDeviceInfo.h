@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+#include "QueueFamilyIndices.h"
+#include "SwapChainSupportDetails.h"
+
+// Apa yang wajib ada di device supaya app ini jalan
+struct DeviceRequirements
+{
+public:
+	std::vector<const char*> extensions;
+	bool present = true;						// butuh present queue + swap chain (false di headless)
+	bool drawIndirectFirstInstance = false;		// GPU culling: lebih suka device dengan firstInstance di indirect command (tidak wajib)
+};
+
+// Snapshot satu VkPhysicalDevice, di-query sekali saat PickPhysicalDevice.
+// Kode lain baca dari sini, bukan memanggil vkGetPhysicalDevice* lagi.
+struct PhysicalDeviceInfo
+{
+public:
+	// getFeatures2 = nullptr: VK_KHR_get_physical_device_properties2 tidak ada, feature extension dianggap tidak ada
+	static PhysicalDeviceInfo Query( VkPhysicalDevice physicalDevice, VkSurfaceKHR surface,
+		PFN_vkGetPhysicalDeviceFeatures2KHR getFeatures2 = nullptr );
+	// currentExtent berubah tiap window di-resize, query ulang sebelum swap chain dibuat ulang
+	void RefreshSurfaceCapabilities( VkSurfaceKHR surface );
+
+	bool HasExtension( const char* name ) const;
+	// heap DEVICE_LOCAL terbesar (VRAM di discrete, shared memory di integrated)
+	VkDeviceSize DeviceLocalBytes() const;
+	const char* TypeName() const;
+	// descriptor indexing dengan feature yang dipakai BindlessDescriptors
+	bool SupportsBindless() const;
+
+	// -1 = tidak memenuhi requirements. Discrete > integrated > virtual > CPU, lalu feature opsional, lalu heap terbesar.
+	int64_t Score( const DeviceRequirements& requirements ) const;
+
+public:
+	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+	VkPhysicalDeviceProperties properties{};
+	VkPhysicalDeviceFeatures features{};
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexing{};	// semua VK_FALSE kalau extension nya tidak ada
+	VkPhysicalDeviceMemoryProperties memory{};
+	std::vector<VkQueueFamilyProperties> queueFamilies;
+	std::vector<VkExtensionProperties> extensions;
+	QueueFamilyIndices queueIndices;
+	SwapChainSupportDetails swapChainSupport{};		// kosong kalau tanpa surface (headless)
+};
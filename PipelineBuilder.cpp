@@ -0,0 +1,301 @@
+#include "PipelineBuilder.h"
+#include "ShaderBlob.h"
+#include "CpuTrace.h"
+#include "HostAllocator.h"
+#include <iostream>
+#include <chrono>
+#include <stdexcept>
+
+void PipelineBuilder::Init( VkDevice device, VkPipelineCache cache, size_t threadCount )
+{
+	this->device = device;
+	this->cache = cache;
+	pool = threadCount == 0 ? std::make_unique<ThreadPool>() : std::make_unique<ThreadPool>( threadCount );
+}
+
+void PipelineBuilder::CleanUp()
+{
+	// destroy pool = tunggu semua task yang masih antri selesai
+	pool.reset();
+
+	for( auto& module : shaderModules )
+	{
+		try
+		{
+			vkDestroyShaderModule( device, module.second.get(), HostAllocator::Callbacks() );
+		} catch( const std::exception& ) {
+			// module yang gagal dibuat tidak perlu di-destroy
+		}
+	}
+	shaderModules.clear();
+}
+
+std::shared_future<VkPipeline> PipelineBuilder::Submit( const GraphicsPipelineDesc& desc, double* creationMs )
+{
+	const auto start = std::chrono::steady_clock::now();
+	// module di-submit duluan, jadi task pipeline (FIFO) tidak mungkin nunggu task yang belum diambil worker
+	auto vert = GetShaderModule( desc.vertShader );
+	auto frag = GetShaderModule( desc.fragShader );
+
+	return pool->Submit( [this, desc, vert, frag, start, creationMs]
+		{
+			VkPipeline pipeline = CreatePipeline( desc, vert.get(), frag.get(), cache );
+			// ditulis sebelum future nya ready, jadi aman dibaca caller setelah get()
+			if( creationMs != nullptr )
+				*creationMs = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+			return pipeline;
+		} ).share();
+}
+
+std::vector<std::shared_future<VkPipeline>> PipelineBuilder::SubmitBatch( const std::vector<GraphicsPipelineDesc>& descs )
+{
+	std::vector<std::shared_future<VkPipeline>> pipelines;
+	pipelines.reserve( descs.size() );
+	for( const auto& desc : descs )
+		pipelines.push_back( Submit( desc ) );
+	return pipelines;
+}
+
+void PipelineBuilder::ReportParallelSpeedup( const std::vector<GraphicsPipelineDesc>& descs )
+{
+	using Clock = std::chrono::steady_clock;
+
+	auto createEmptyCache = [this]
+	{
+		VkPipelineCacheCreateInfo cacheInfo{};
+		cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		VkPipelineCache emptyCache;
+		if( vkCreatePipelineCache( device, &cacheInfo, HostAllocator::Callbacks(), &emptyCache ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create pipeline cache!" );
+		return emptyCache;
+	};
+
+	auto destroyAll = [this]( std::vector<VkPipeline>& pipelines, std::map<std::string, VkShaderModule>& modules, VkPipelineCache benchCache )
+	{
+		for( auto pipeline : pipelines )
+			vkDestroyPipeline( device, pipeline, HostAllocator::Callbacks() );
+		for( auto& module : modules )
+			vkDestroyShaderModule( device, module.second, HostAllocator::Callbacks() );
+		vkDestroyPipelineCache( device, benchCache, HostAllocator::Callbacks() );
+	};
+
+	// Serial: persis seperti path lama, satu per satu di main thread
+	// ----------------------------------------------------------------
+	VkPipelineCache serialCache = createEmptyCache();
+	std::vector<VkPipeline> serialPipelines;
+	std::map<std::string, VkShaderModule> serialModules;
+
+	const auto serialStart = Clock::now();
+	for( const auto& desc : descs )
+	{
+		for( const auto& name : { desc.vertShader, desc.fragShader } )
+		{
+			if( serialModules.find( name ) == serialModules.end() )
+				serialModules[name] = CreateShaderModule( name );
+		}
+		serialPipelines.push_back( CreatePipeline( desc, serialModules[desc.vertShader], serialModules[desc.fragShader], serialCache ) );
+	}
+	const std::chrono::duration<double, std::milli> serialTime = Clock::now() - serialStart;
+	destroyAll( serialPipelines, serialModules, serialCache );
+	// ----------------------------------------------------------------
+
+	// Paralel: module dulu, lalu pipeline, semua di pool
+	// --------------------------------------------------
+	VkPipelineCache parallelCache = createEmptyCache();
+	std::map<std::string, std::shared_future<VkShaderModule>> moduleFutures;
+	std::vector<std::future<VkPipeline>> pipelineFutures;
+
+	const auto parallelStart = Clock::now();
+	for( const auto& desc : descs )
+	{
+		for( const auto& name : { desc.vertShader, desc.fragShader } )
+		{
+			if( moduleFutures.find( name ) == moduleFutures.end() )
+				moduleFutures[name] = pool->Submit( [this, name] { return CreateShaderModule( name ); } ).share();
+		}
+	}
+	for( const auto& desc : descs )
+	{
+		auto vert = moduleFutures[desc.vertShader];
+		auto frag = moduleFutures[desc.fragShader];
+		pipelineFutures.push_back( pool->Submit( [this, desc, vert, frag, parallelCache]
+			{
+				return CreatePipeline( desc, vert.get(), frag.get(), parallelCache );
+			} ) );
+	}
+
+	std::vector<VkPipeline> parallelPipelines;
+	for( auto& future : pipelineFutures )
+		parallelPipelines.push_back( future.get() );
+	const std::chrono::duration<double, std::milli> parallelTime = Clock::now() - parallelStart;
+
+	std::map<std::string, VkShaderModule> parallelModules;
+	for( auto& module : moduleFutures )
+		parallelModules[module.first] = module.second.get();
+	destroyAll( parallelPipelines, parallelModules, parallelCache );
+	// --------------------------------------------------
+
+	std::cout << "pipeline build: " << descs.size() << " pipelines, serial " << serialTime.count() << " ms, "
+		<< pool->Size() << " threads " << parallelTime.count() << " ms ("
+		<< serialTime.count() / parallelTime.count() << "x)" << std::endl;
+}
+
+std::vector<GraphicsPipelineDesc> PipelineBuilder::MakeVariants( const GraphicsPipelineDesc& base, size_t count, bool allowNonSolidFill )
+{
+	// kombinasi state yang tidak butuh shader/layout lain, cukup buat bikin banyak pipeline yang beda
+	const VkCullModeFlags cullModes[] = { VK_CULL_MODE_NONE, VK_CULL_MODE_BACK_BIT, VK_CULL_MODE_FRONT_BIT };
+	const VkFrontFace frontFaces[] = { VK_FRONT_FACE_CLOCKWISE, VK_FRONT_FACE_COUNTER_CLOCKWISE };
+	const VkPolygonMode polygonModes[] = { VK_POLYGON_MODE_FILL, VK_POLYGON_MODE_LINE };
+
+	std::vector<GraphicsPipelineDesc> variants;
+	variants.reserve( count );
+	for( size_t i = 0; i < count; ++i )
+	{
+		GraphicsPipelineDesc desc = base;
+		desc.cullMode = cullModes[i % 3];
+		desc.frontFace = frontFaces[( i / 3 ) % 2];
+		desc.polygonMode = allowNonSolidFill ? polygonModes[( i / 6 ) % 2] : VK_POLYGON_MODE_FILL;
+		variants.push_back( desc );
+	}
+	return variants;
+}
+
+std::shared_future<VkShaderModule> PipelineBuilder::GetShaderModule( const std::string& name )
+{
+	std::lock_guard<std::mutex> lock( moduleMutex );
+
+	auto it = shaderModules.find( name );
+	if( it != shaderModules.end() )
+		return it->second;
+
+	auto module = pool->Submit( [this, name] { return CreateShaderModule( name ); } ).share();
+	shaderModules.emplace( name, module );
+	return module;
+}
+
+VkShaderModule PipelineBuilder::CreateShaderModule( const std::string& name ) const
+{
+	TRACE_ZONE( "CreateShaderModule" );
+	// blob cuma perlu hidup sampai vkCreateShaderModule selesai
+	const ShaderBlob code = ShaderBlob::Load( name );
+
+	VkShaderModuleCreateInfo shaderModuleInfo{};
+	shaderModuleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	shaderModuleInfo.codeSize = code.Size();
+	shaderModuleInfo.pCode = code.Code();
+
+	VkShaderModule shaderModule;
+	if( vkCreateShaderModule( device, &shaderModuleInfo, HostAllocator::Callbacks(), &shaderModule ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create shader module " + name );
+
+	return shaderModule;
+}
+
+VkPipeline PipelineBuilder::CreatePipeline( const GraphicsPipelineDesc& desc, VkShaderModule vert, VkShaderModule frag, VkPipelineCache pipelineCache ) const
+{
+	TRACE_ZONE( "CreatePipeline" );
+	// Creating shader stage info
+	// --------------------------
+	VkPipelineShaderStageCreateInfo vertStageInfo{};
+	vertStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	vertStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+	vertStageInfo.module = vert;
+	vertStageInfo.pName = "main";
+
+	VkPipelineShaderStageCreateInfo fragStageInfo{};
+	fragStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	fragStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	fragStageInfo.module = frag;
+	fragStageInfo.pName = "main";
+	// --------------------------
+
+	VkPipelineShaderStageCreateInfo shaderStages[] = { vertStageInfo, fragStageInfo };
+
+	// Fixed functions
+	// ---------------
+	VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>( desc.vertexBindings.size() );
+	vertexInputInfo.pVertexBindingDescriptions = desc.vertexBindings.data();
+	vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>( desc.vertexAttributes.size() );
+	vertexInputInfo.pVertexAttributeDescriptions = desc.vertexAttributes.data();
+
+	VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+	inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	inputAssembly.topology = desc.topology;
+	inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+	VkViewport viewport{};
+	viewport.x = 0.0f;
+	viewport.y = 0.0f;
+	viewport.width = static_cast<float>( desc.extent.width );
+	viewport.height = static_cast<float>( desc.extent.height );
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+
+	VkRect2D scissor{};
+	scissor.offset = { 0, 0 };
+	scissor.extent = desc.extent;
+
+	VkPipelineViewportStateCreateInfo viewportState{};
+	viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewportState.viewportCount = 1;
+	viewportState.pViewports = desc.dynamicViewport ? nullptr : &viewport;
+	viewportState.scissorCount = 1;
+	viewportState.pScissors = desc.dynamicViewport ? nullptr : &scissor;
+
+	const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+	VkPipelineDynamicStateCreateInfo dynamicState{};
+	dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicState.dynamicStateCount = 2;
+	dynamicState.pDynamicStates = dynamicStates;
+
+	VkPipelineRasterizationStateCreateInfo rasterizer{};
+	rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterizer.depthClampEnable = VK_FALSE;
+	rasterizer.rasterizerDiscardEnable = VK_FALSE;
+	rasterizer.polygonMode = desc.polygonMode;
+	rasterizer.lineWidth = 1.0f;
+	rasterizer.cullMode = desc.cullMode;
+	rasterizer.frontFace = desc.frontFace;
+	rasterizer.depthBiasEnable = VK_FALSE;
+
+	VkPipelineMultisampleStateCreateInfo multisampling{};
+	multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisampling.sampleShadingEnable = VK_FALSE;
+	multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+	VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+	colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	colorBlendAttachment.blendEnable = VK_FALSE;
+
+	VkPipelineColorBlendStateCreateInfo colorBlending{};
+	colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	colorBlending.logicOpEnable = VK_FALSE;
+	colorBlending.logicOp = VK_LOGIC_OP_COPY;
+	colorBlending.attachmentCount = 1;
+	colorBlending.pAttachments = &colorBlendAttachment;
+	// ---------------
+
+	VkGraphicsPipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	pipelineInfo.stageCount = 2;
+	pipelineInfo.pStages = shaderStages;
+	pipelineInfo.pVertexInputState = &vertexInputInfo;
+	pipelineInfo.pInputAssemblyState = &inputAssembly;
+	pipelineInfo.pViewportState = &viewportState;
+	pipelineInfo.pRasterizationState = &rasterizer;
+	pipelineInfo.pMultisampleState = &multisampling;
+	pipelineInfo.pColorBlendState = &colorBlending;
+	pipelineInfo.pDynamicState = desc.dynamicViewport ? &dynamicState : nullptr;
+	pipelineInfo.layout = desc.layout;
+	pipelineInfo.renderPass = desc.renderPass;
+	pipelineInfo.subpass = 0;
+	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+	VkPipeline pipeline;
+	if( vkCreateGraphicsPipelines( device, pipelineCache, 1, &pipelineInfo, HostAllocator::Callbacks(), &pipeline ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create graphics pipeline!" );
+
+	return pipeline;
+}
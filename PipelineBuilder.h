@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <future>
+#include <memory>
+
+#include "ThreadPool.h"
+#include "Vertex.h"
+
+// Deskripsi satu graphics pipeline. Layout dan render pass dimiliki pemanggil.
+struct GraphicsPipelineDesc
+{
+	std::string vertShader = "vert.spv";
+	std::string fragShader = "frag.spv";
+	std::vector<VkVertexInputBindingDescription> vertexBindings = VertexLayout::Bindings();
+	std::vector<VkVertexInputAttributeDescription> vertexAttributes = VertexLayout::Attributes();
+	VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+	VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+	VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+	VkExtent2D extent{};
+	// viewport + scissor di-set lewat vkCmdSetViewport/Scissor, extent diabaikan (pipeline tetap valid setelah resize)
+	bool dynamicViewport = false;
+	VkPipelineLayout layout = VK_NULL_HANDLE;
+	VkRenderPass renderPass = VK_NULL_HANDLE;
+};
+
+// Bikin shader module dan pipeline secara paralel di thread pool.
+// Semua pipeline pakai satu VkPipelineCache yang sama (VkPipelineCache thread-safe tanpa
+// VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT).
+// Shader module di-share antar pipeline dan baru di-destroy di CleanUp().
+class PipelineBuilder
+{
+public:
+	void Init( VkDevice device, VkPipelineCache cache, size_t threadCount = 0 );
+	void CleanUp();
+
+	// langsung return, pipeline nya jadi di background. get() pada future = tunggu pipeline tsb saja.
+	// creationMs != nullptr: worker menulis durasi Submit -> pipeline jadi (termasuk shader module) di sini, baca setelah get()
+	std::shared_future<VkPipeline> Submit( const GraphicsPipelineDesc& desc, double* creationMs = nullptr );
+	std::vector<std::shared_future<VkPipeline>> SubmitBatch( const std::vector<GraphicsPipelineDesc>& descs );
+
+	// Build batch yang sama secara serial (main thread) dan paralel, masing-masing dengan cache kosong,
+	// lalu print wall-clock time nya. Pipeline hasil benchmark langsung di-destroy.
+	void ReportParallelSpeedup( const std::vector<GraphicsPipelineDesc>& descs );
+
+	// allowNonSolidFill = VkPhysicalDeviceFeatures::fillModeNonSolid
+	static std::vector<GraphicsPipelineDesc> MakeVariants( const GraphicsPipelineDesc& base, size_t count, bool allowNonSolidFill );
+
+private:
+	std::shared_future<VkShaderModule> GetShaderModule( const std::string& name );
+	VkShaderModule CreateShaderModule( const std::string& name ) const;
+	VkPipeline CreatePipeline( const GraphicsPipelineDesc& desc, VkShaderModule vert, VkShaderModule frag, VkPipelineCache cache ) const;
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	VkPipelineCache cache = VK_NULL_HANDLE;
+	std::unique_ptr<ThreadPool> pool;
+
+	std::mutex moduleMutex;
+	std::map<std::string, std::shared_future<VkShaderModule>> shaderModules;
+};
@@ -0,0 +1,194 @@
+#include "PipelineCache.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "HostAllocator.h"
+
+void PipelineCache::Init( VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& path )
+{
+	this->device = device;
+	this->properties = properties;
+	this->path = path;
+
+	// Load blob lama, kalau header nya tidak cocok dengan device/driver sekarang, buang saja (cold start)
+	// --------------------------------------------------------------------------------------------------
+	std::vector<char> file = path.empty() ? std::vector<char>{} : LoadBlob();
+	const bool valid = !file.empty() && IsBlobValid( file );
+	if( !file.empty() && !valid )
+		std::cout << "pipeline cache: " << path << " is stale or corrupt, starting cold" << std::endl;
+
+	VkPipelineCacheCreateInfo cacheInfo{};
+	cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	if( valid )
+	{
+		cacheInfo.initialDataSize = file.size() - sizeof( FileHeader );
+		cacheInfo.pInitialData = file.data() + sizeof( FileHeader );
+	}
+
+	if( vkCreatePipelineCache( device, &cacheInfo, HostAllocator::Callbacks(), &cache ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create pipeline cache!" );
+
+	warm = valid;
+	loadedBytes = valid ? cacheInfo.initialDataSize : 0;
+	// --------------------------------------------------------------------------------------------------
+
+	LoadTimings();
+}
+
+void PipelineCache::CleanUp()
+{
+	if( !path.empty() )
+	{
+		Save();
+		SaveTimings();
+	}
+
+	vkDestroyPipelineCache( device, cache, HostAllocator::Callbacks() );
+	cache = VK_NULL_HANDLE;
+}
+
+void PipelineCache::ReportStartupTiming( double pipelineCreationMs )
+{
+	std::cout << "pipeline cache: " << ( warm ? "warm" : "cold" ) << " (" << loadedBytes << " bytes loaded), "
+		<< "pipelines created in " << pipelineCreationMs << " ms" << std::endl;
+
+	if( warm )
+		lastWarmMs = pipelineCreationMs;
+	else
+		lastColdMs = pipelineCreationMs;
+
+	if( lastColdMs > 0.0 && lastWarmMs > 0.0 )
+	{
+		std::cout << "pipeline cache: last cold " << lastColdMs << " ms vs last warm " << lastWarmMs
+			<< " ms (" << lastColdMs / lastWarmMs << "x)" << std::endl;
+	}
+}
+
+std::vector<char> PipelineCache::LoadBlob() const
+{
+	std::ifstream in( path, std::ios::ate | std::ios::binary );
+	if( !in )
+		return {};
+
+	size_t fileSize = static_cast<size_t>( in.tellg() );
+	std::vector<char> buffer( fileSize );
+	in.seekg( 0 );
+	in.read( buffer.data(), fileSize );
+	return buffer;
+}
+
+bool PipelineCache::IsBlobValid( const std::vector<char>& file ) const
+{
+	if( file.size() < sizeof( FileHeader ) )
+		return false;
+
+	FileHeader header;
+	std::memcpy( &header, file.data(), sizeof( FileHeader ) );
+
+	if( std::memcmp( header.magic, "VKPC", 4 ) != 0 || header.version != FileVersion )
+		return false;
+	if( header.vendorID != properties.vendorID || header.deviceID != properties.deviceID ||
+		header.driverVersion != properties.driverVersion ||
+		std::memcmp( header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE ) != 0 )
+		return false;
+	if( header.dataSize != file.size() - sizeof( FileHeader ) )
+		return false;
+
+	const char* data = file.data() + sizeof( FileHeader );
+	if( header.dataHash != Hash( data, static_cast<size_t>( header.dataSize ) ) )
+		return false;
+
+	// header bawaan Vulkan (VkPipelineCacheHeaderVersionOne) juga dicek, jaga-jaga kalau driver berubah
+	// tanpa bump driverVersion
+	// -------------------------------------------------------------------------------------------------
+	constexpr size_t vkHeaderSize = 16 + VK_UUID_SIZE;
+	if( header.dataSize < vkHeaderSize )
+		return false;
+
+	uint32_t vkHeader[4];
+	std::memcpy( vkHeader, data, sizeof( vkHeader ) );
+	if( vkHeader[0] < vkHeaderSize || vkHeader[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+		vkHeader[2] != properties.vendorID || vkHeader[3] != properties.deviceID ||
+		std::memcmp( data + 16, properties.pipelineCacheUUID, VK_UUID_SIZE ) != 0 )
+		return false;
+	// -------------------------------------------------------------------------------------------------
+
+	return true;
+}
+
+void PipelineCache::Save() const
+{
+	size_t dataSize = 0;
+	if( vkGetPipelineCacheData( device, cache, &dataSize, nullptr ) != VK_SUCCESS || dataSize == 0 )
+		return;
+
+	std::vector<char> file( sizeof( FileHeader ) + dataSize );
+	if( vkGetPipelineCacheData( device, cache, &dataSize, file.data() + sizeof( FileHeader ) ) != VK_SUCCESS )
+		return;
+	file.resize( sizeof( FileHeader ) + dataSize );
+
+	FileHeader header{};
+	std::memcpy( header.magic, "VKPC", 4 );
+	header.version = FileVersion;
+	header.vendorID = properties.vendorID;
+	header.deviceID = properties.deviceID;
+	header.driverVersion = properties.driverVersion;
+	std::memcpy( header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE );
+	header.dataSize = dataSize;
+	header.dataHash = Hash( file.data() + sizeof( FileHeader ), dataSize );
+	std::memcpy( file.data(), &header, sizeof( FileHeader ) );
+
+	WriteFileAtomic( path, file );
+}
+
+void PipelineCache::LoadTimings()
+{
+	std::ifstream in( path + ".timing" );
+	if( in )
+		in >> lastColdMs >> lastWarmMs;
+}
+
+void PipelineCache::SaveTimings() const
+{
+	const std::string text = std::to_string( lastColdMs ) + " " + std::to_string( lastWarmMs ) + "\n";
+	WriteFileAtomic( path + ".timing", std::vector<char>( text.begin(), text.end() ) );
+}
+
+uint64_t PipelineCache::Hash( const char* data, size_t size )
+{
+	// FNV-1a 64 bit, cukup buat deteksi file yang ketulis setengah / korup
+	uint64_t hash = 14695981039346656037ULL;
+	for( size_t i = 0; i < size; ++i )
+	{
+		hash ^= static_cast<uint8_t>( data[i] );
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+void PipelineCache::WriteFileAtomic( const std::string& path, const std::vector<char>& data )
+{
+	// tulis ke file sementara, fsync, lalu rename -> file lama tidak pernah setengah ketimpa
+	const std::string tmpPath = path + ".tmp";
+
+	FILE* file = std::fopen( tmpPath.c_str(), "wb" );
+	if( file == nullptr )
+	{
+		std::cerr << "pipeline cache: failed to write " << tmpPath << std::endl;
+		return;
+	}
+
+	const bool written = std::fwrite( data.data(), 1, data.size(), file ) == data.size() &&
+		std::fflush( file ) == 0 && fsync( fileno( file ) ) == 0;
+	std::fclose( file );
+
+	if( !written || std::rename( tmpPath.c_str(), path.c_str() ) != 0 )
+	{
+		std::cerr << "pipeline cache: failed to write " << path << std::endl;
+		std::remove( tmpPath.c_str() );
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+
+// VkPipelineCache yang disimpan ke disk antar launch.
+// File nya punya header sendiri (vendor, device, driver version, pipelineCacheUUID),
+// karena header bawaan Vulkan tidak menyimpan driver version.
+class PipelineCache
+{
+public:
+	void Init( VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& path );
+	void CleanUp();
+
+	VkPipelineCache Get() const { return cache; }
+	bool IsWarm() const { return warm; }
+
+	// print waktu pembuatan pipeline, dibandingkan dengan run cold/warm sebelumnya
+	void ReportStartupTiming( double pipelineCreationMs );
+
+private:
+	struct FileHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t vendorID;
+		uint32_t deviceID;
+		uint32_t driverVersion;
+		uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+		uint64_t dataSize;
+		uint64_t dataHash;
+	};
+	static constexpr uint32_t FileVersion = 1;
+
+	std::vector<char> LoadBlob() const;
+	bool IsBlobValid( const std::vector<char>& file ) const;
+	void Save() const;
+	void LoadTimings();
+	void SaveTimings() const;
+	static uint64_t Hash( const char* data, size_t size );
+	static void WriteFileAtomic( const std::string& path, const std::vector<char>& data );
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	VkPhysicalDeviceProperties properties{};
+	VkPipelineCache cache = VK_NULL_HANDLE;
+	std::string path;
+	bool warm = false;
+	size_t loadedBytes = 0;
+
+	// hasil run sebelumnya, dari file "<path>.timing"
+	double lastColdMs = -1.0;
+	double lastWarmMs = -1.0;
+};
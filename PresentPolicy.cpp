@@ -0,0 +1,62 @@
+#include "PresentPolicy.h"
+#include <algorithm>
+#include <stdexcept>
+
+PresentPolicy ParsePresentPolicy( const std::string& name )
+{
+	if( name == "throughput" )
+		return PresentPolicy::Throughput;
+	if( name == "low-latency" )
+		return PresentPolicy::LowLatency;
+	if( name == "power-saving" )
+		return PresentPolicy::PowerSaving;
+	throw std::runtime_error( "Unknown present policy: " + name + " (throughput, low-latency, power-saving)" );
+}
+
+const char* PresentPolicyName( PresentPolicy policy )
+{
+	switch( policy )
+	{
+	case PresentPolicy::Throughput: return "throughput";
+	case PresentPolicy::LowLatency: return "low-latency";
+	case PresentPolicy::PowerSaving: return "power-saving";
+	}
+	return "unknown";
+}
+
+const char* PresentModeName( VkPresentModeKHR mode )
+{
+	switch( mode )
+	{
+	case VK_PRESENT_MODE_IMMEDIATE_KHR: return "IMMEDIATE";
+	case VK_PRESENT_MODE_MAILBOX_KHR: return "MAILBOX";
+	case VK_PRESENT_MODE_FIFO_KHR: return "FIFO";
+	case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "FIFO_RELAXED";
+	default: return "OTHER";
+	}
+}
+
+VkPresentModeKHR ChoosePresentMode( PresentPolicy policy, const std::vector<VkPresentModeKHR>& availablePresentModes )
+{
+	std::vector<VkPresentModeKHR> preferred;
+	switch( policy )
+	{
+	case PresentPolicy::Throughput:
+		// MAILBOX: tidak tearing tapi tetap uncapped, IMMEDIATE: uncapped tapi bisa tearing
+		preferred = { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR };
+		break;
+	case PresentPolicy::LowLatency:
+		// FIFO_RELAXED: frame yang telat langsung tampil (tearing sesekali) daripada nunggu vblank berikutnya
+		preferred = { VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_MAILBOX_KHR };
+		break;
+	case PresentPolicy::PowerSaving:
+		break;
+	}
+
+	for( VkPresentModeKHR mode : preferred )
+	{
+		if( std::find( availablePresentModes.begin(), availablePresentModes.end(), mode ) != availablePresentModes.end() )
+			return mode;
+	}
+	return VK_PRESENT_MODE_FIFO_KHR;
+}
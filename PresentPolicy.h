@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+
+// Trade-off presentasi, dipilih saat runtime (--present-policy)
+enum class PresentPolicy
+{
+	Throughput,		// MAILBOX > IMMEDIATE > FIFO, tanpa cap vsync
+	LowLatency,		// FIFO_RELAXED > MAILBOX > FIFO, 1 frame in flight, input di-sample setelah GPU selesai frame sebelumnya
+	PowerSaving		// FIFO: cap di refresh rate, CPU/GPU banyak idle
+};
+
+PresentPolicy ParsePresentPolicy( const std::string& name );
+const char* PresentPolicyName( PresentPolicy policy );
+const char* PresentModeName( VkPresentModeKHR mode );
+// FIFO selalu ada (wajib di spec), jadi selalu ada fallback
+VkPresentModeKHR ChoosePresentMode( PresentPolicy policy, const std::vector<VkPresentModeKHR>& availablePresentModes );
@@ -16,7 +16,18 @@ public:
 	{
 		return presentFamily.value();
 	}
+	uint32_t GetComputeFamilyValue() const
+	{
+		return computeFamily.value();
+	}
+	uint32_t GetTransferFamilyValue() const
+	{
+		return transferFamily.value();
+	}
 public:
 	std::optional<uint32_t> graphicsFamily;
 	std::optional<uint32_t> presentFamily;
-};
\ No newline at end of file
+	// kalau device tidak punya family khusus, dua ini diisi graphicsFamily
+	std::optional<uint32_t> computeFamily;		// async compute: COMPUTE tanpa GRAPHICS
+	std::optional<uint32_t> transferFamily;		// DMA: TRANSFER tanpa GRAPHICS dan COMPUTE
+};
@@ -0,0 +1,745 @@
+#include "RenderGraph.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "HostAllocator.h"
+
+namespace
+{
+	constexpr VkAccessFlags WriteAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+		VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+	const char* LayoutName( VkImageLayout layout )
+	{
+		switch( layout )
+		{
+		case VK_IMAGE_LAYOUT_UNDEFINED: return "UNDEFINED";
+		case VK_IMAGE_LAYOUT_GENERAL: return "GENERAL";
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: return "COLOR_ATTACHMENT";
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: return "DEPTH_STENCIL_ATTACHMENT";
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL: return "DEPTH_STENCIL_READ_ONLY";
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return "SHADER_READ_ONLY";
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: return "TRANSFER_SRC";
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: return "TRANSFER_DST";
+		case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: return "PRESENT_SRC";
+		default: return "OTHER";
+		}
+	}
+
+	std::string StageNames( VkPipelineStageFlags stages )
+	{
+		static const std::pair<VkPipelineStageFlags, const char*> names[] = {
+			{ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, "TOP" },
+			{ VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, "DRAW_INDIRECT" },
+			{ VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, "VERTEX_INPUT" },
+			{ VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, "VERTEX" },
+			{ VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, "FRAGMENT" },
+			{ VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT, "EARLY_FRAGMENT_TESTS" },
+			{ VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, "LATE_FRAGMENT_TESTS" },
+			{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, "COLOR_OUTPUT" },
+			{ VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, "COMPUTE" },
+			{ VK_PIPELINE_STAGE_TRANSFER_BIT, "TRANSFER" },
+			{ VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, "BOTTOM" },
+			{ VK_PIPELINE_STAGE_HOST_BIT, "HOST" },
+			{ VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, "ALL_GRAPHICS" },
+			{ VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, "ALL_COMMANDS" }
+		};
+
+		std::string result;
+		for( const auto& name : names )
+		{
+			if( ( stages & name.first ) == name.first )
+			{
+				result += result.empty() ? "" : "|";
+				result += name.second;
+				stages &= ~name.first;
+			}
+		}
+		return result.empty() ? "NONE" : result;
+	}
+}
+
+// PassBuilder
+// -----------
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read( RenderGraphHandle resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout )
+{
+	return Access( resource, stage, access, layout, false );
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write( RenderGraphHandle resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout )
+{
+	return Access( resource, stage, access, layout, true );
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::SideEffect()
+{
+	graph.passes[pass].sideEffect = true;
+	return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Execute( ExecuteFn execute )
+{
+	graph.passes[pass].execute = std::move( execute );
+	return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Access( RenderGraphHandle resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout, bool write )
+{
+	if( resource >= graph.resources.size() )
+		throw std::runtime_error( "Render graph pass \"" + graph.passes[pass].name + "\" uses an invalid resource!" );
+
+	// read + write resource yang sama di satu pass = satu akses (kalau dipisah, pass nya barrier ke diri sendiri)
+	auto& accesses = graph.passes[pass].accesses;
+	auto existing = std::find_if( accesses.begin(), accesses.end(), [resource]( const ResourceAccess& a ) { return a.resource == resource; } );
+	if( existing == accesses.end() )
+	{
+		accesses.push_back( ResourceAccess{ resource, 0, 0, layout } );
+		existing = accesses.end() - 1;
+	}
+	else if( existing->layout != layout )
+		throw std::runtime_error( "Render graph pass \"" + graph.passes[pass].name + "\" uses \"" + graph.resources[resource].name + "\" in two layouts!" );
+
+	existing->stage |= stage;
+	existing->access |= access;
+	existing->read |= !write;
+	existing->write |= write;
+	return *this;
+}
+// -----------
+
+void RenderGraph::Init( VkDevice device, DeviceAllocator& allocator )
+{
+	this->device = device;
+	this->allocator = &allocator;
+}
+
+void RenderGraph::CleanUp()
+{
+	DestroyTransients();
+	resources.clear();
+	passes.clear();
+	finalBatch = BarrierBatch{};
+	stats = RenderGraphStats{};
+	compiled = false;
+}
+
+RenderGraphHandle RenderGraph::ImportImage( const std::string& name, VkImage image, VkImageAspectFlags aspect,
+	VkImageLayout initialLayout, VkPipelineStageFlags initialStage,
+	VkImageLayout finalLayout, VkPipelineStageFlags finalStage, VkAccessFlags finalAccess )
+{
+	Resource resource;
+	resource.name = name;
+	resource.imported = true;
+	resource.image = image;
+	resource.aspect = aspect;
+	resource.initialLayout = initialLayout;
+	resource.initialStage = initialStage;
+	resource.finalLayout = finalLayout;
+	resource.finalStage = finalStage;
+	resource.finalAccess = finalAccess;
+	resources.push_back( resource );
+	return static_cast<RenderGraphHandle>( resources.size() - 1 );
+}
+
+RenderGraphHandle RenderGraph::ImportBuffer( const std::string& name, VkBuffer buffer, VkPipelineStageFlags lastStage, VkAccessFlags lastAccess )
+{
+	Resource resource;
+	resource.name = name;
+	resource.isImage = false;
+	resource.imported = true;
+	resource.buffer = buffer;
+	resource.initialStage = lastStage;
+	resource.initialAccess = lastAccess;
+	resources.push_back( resource );
+	return static_cast<RenderGraphHandle>( resources.size() - 1 );
+}
+
+RenderGraphHandle RenderGraph::CreateImage( const std::string& name, const TransientImageDesc& desc )
+{
+	Resource resource;
+	resource.name = name;
+	resource.aspect = desc.aspect;
+	resource.desc = desc;
+	resources.push_back( resource );
+	return static_cast<RenderGraphHandle>( resources.size() - 1 );
+}
+
+void RenderGraph::MarkOutput( RenderGraphHandle resource )
+{
+	resources.at( resource ).output = true;
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass( const std::string& name )
+{
+	if( compiled )
+		throw std::runtime_error( "Render graph is already compiled!" );
+
+	passes.push_back( Pass{} );
+	passes.back().name = name;
+	return PassBuilder( *this, static_cast<uint32_t>( passes.size() - 1 ) );
+}
+
+void RenderGraph::Compile()
+{
+	if( compiled )
+		throw std::runtime_error( "Render graph is already compiled!" );
+
+	stats = RenderGraphStats{};
+	stats.passCount = static_cast<uint32_t>( passes.size() );
+
+	CullPasses();
+	ComputeLifetimes();
+	AllocateTransients();
+	ComputeBarriers();
+	compiled = true;
+}
+
+void RenderGraph::CullPasses()
+{
+	// dari belakang: pass hidup kalau side effect atau menulis resource yang dibutuhkan,
+	// resource yang dibaca pass hidup jadi dibutuhkan pass sebelumnya
+	std::vector<bool> needed( resources.size() );
+	for( size_t i = 0; i < resources.size(); ++i )
+		needed[i] = resources[i].output;
+
+	for( size_t p = passes.size(); p-- > 0; )
+	{
+		Pass& pass = passes[p];
+		pass.live = pass.sideEffect;
+		for( const auto& access : pass.accesses )
+			pass.live = pass.live || ( access.write && needed[access.resource] );
+
+		if( !pass.live )
+		{
+			++stats.culledPassCount;
+			continue;
+		}
+		for( const auto& access : pass.accesses )
+		{
+			if( access.read )
+				needed[access.resource] = true;
+		}
+	}
+}
+
+void RenderGraph::ComputeLifetimes()
+{
+	for( int32_t p = 0; p < static_cast<int32_t>( passes.size() ); ++p )
+	{
+		if( !passes[p].live )
+			continue;
+		for( const auto& access : passes[p].accesses )
+		{
+			Resource& resource = resources[access.resource];
+			if( resource.firstPass < 0 )
+				resource.firstPass = p;
+			resource.lastPass = p;
+			resource.lastStage = access.stage;
+			resource.lastWriteAccess = access.access & WriteAccessMask;
+		}
+	}
+}
+
+void RenderGraph::AllocateTransients()
+{
+	// Buat image, lalu taruh di satu heap: yang terbesar duluan, offset serendah mungkin
+	// yang tidak bertabrakan dengan transient lain yang umurnya overlap
+	// ------------------------------------------------------------------------------------
+	std::vector<RenderGraphHandle> order;
+	for( RenderGraphHandle i = 0; i < resources.size(); ++i )
+	{
+		Resource& resource = resources[i];
+		if( resource.imported || resource.firstPass < 0 )
+			continue;
+
+		VkImageCreateInfo imageInfo{};
+		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.format = resource.desc.format;
+		imageInfo.extent = { resource.desc.extent.width, resource.desc.extent.height, 1 };
+		imageInfo.mipLevels = 1;
+		imageInfo.arrayLayers = 1;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.usage = resource.desc.usage;
+		imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		if( vkCreateImage( device, &imageInfo, HostAllocator::Callbacks(), &resource.image ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create transient image \"" + resource.name + "\"!" );
+		vkGetImageMemoryRequirements( device, resource.image, &resource.requirements );
+
+		++stats.transientCount;
+		stats.transientBytes += resource.requirements.size;
+		order.push_back( i );
+	}
+	if( order.empty() )
+		return;
+
+	std::sort( order.begin(), order.end(), [this]( RenderGraphHandle a, RenderGraphHandle b )
+		{
+			return resources[a].requirements.size > resources[b].requirements.size;
+		} );
+
+	VkMemoryRequirements heapRequirements{ 0, 1, ~0U };
+	std::vector<RenderGraphHandle> placed;
+	for( RenderGraphHandle i : order )
+	{
+		Resource& resource = resources[i];
+		// memory type tidak cocok dengan heap: transient ini dapat memory sendiri
+		if( ( heapRequirements.memoryTypeBits & resource.requirements.memoryTypeBits ) == 0 )
+			continue;
+
+		// range yang dipakai transient lain di waktu yang sama, urut offset
+		std::vector<std::pair<VkDeviceSize, VkDeviceSize>> busy;
+		for( RenderGraphHandle other : placed )
+		{
+			const Resource& o = resources[other];
+			if( o.firstPass <= resource.lastPass && resource.firstPass <= o.lastPass )
+				busy.emplace_back( o.heapOffset, o.heapOffset + o.requirements.size );
+		}
+		std::sort( busy.begin(), busy.end() );
+
+		const VkDeviceSize alignment = resource.requirements.alignment;
+		VkDeviceSize offset = 0;
+		for( const auto& range : busy )
+		{
+			if( offset + resource.requirements.size <= range.first )
+				break;
+			offset = std::max( offset, ( range.second + alignment - 1 ) / alignment * alignment );
+		}
+
+		resource.heapOffset = offset;
+		resource.aliased = true;
+		heapRequirements.size = std::max( heapRequirements.size, offset + resource.requirements.size );
+		heapRequirements.alignment = std::max( heapRequirements.alignment, alignment );
+		heapRequirements.memoryTypeBits &= resource.requirements.memoryTypeBits;
+		placed.push_back( i );
+	}
+	// ------------------------------------------------------------------------------------
+
+	// alignment heap = alignment terbesar, jadi offset di dalam heap tetap aligned setelah ditambah transientHeap.offset
+	transientHeap = allocator->Allocate( heapRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, ResourceKind::Optimal );
+	stats.aliasedBytes = heapRequirements.size;
+
+	for( RenderGraphHandle i : order )
+	{
+		Resource& resource = resources[i];
+		if( resource.aliased )
+			vkBindImageMemory( device, resource.image, transientHeap.memory, transientHeap.offset + resource.heapOffset );
+		else
+		{
+			resource.ownMemory = allocator->AllocateForImage( resource.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+			stats.aliasedBytes += resource.requirements.size;
+		}
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = resource.image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = resource.desc.format;
+		viewInfo.subresourceRange = { resource.aspect, 0, 1, 0, 1 };
+		if( vkCreateImageView( device, &viewInfo, HostAllocator::Callbacks(), &resource.view ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create transient image view \"" + resource.name + "\"!" );
+	}
+}
+
+void RenderGraph::ComputeBarriers()
+{
+	std::vector<ResourceState> states( resources.size() );
+	for( size_t i = 0; i < resources.size(); ++i )
+	{
+		const Resource& resource = resources[i];
+		ResourceState& state = states[i];
+		state.layout = resource.initialLayout;
+		if( resource.initialAccess & WriteAccessMask )
+		{
+			state.writeStage = resource.initialStage;
+			state.writeAccess = resource.initialAccess;
+		}
+		else
+			state.readStages = resource.initialStage;
+	}
+
+	auto addBarrier = [this]( BarrierBatch& batch, const Barrier& barrier, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage )
+	{
+		batch.srcStage |= srcStage ? srcStage : static_cast<VkPipelineStageFlags>( VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT );
+		batch.dstStage |= dstStage;
+		const bool isImage = resources[barrier.resource].isImage;
+		if( barrier.srcAccess != 0 || barrier.dstAccess != 0 || barrier.oldLayout != barrier.newLayout )
+		{
+			batch.barriers.push_back( barrier );
+			++( isImage ? stats.imageBarrierCount : stats.bufferBarrierCount );
+		}
+	};
+
+	for( int32_t p = 0; p < static_cast<int32_t>( passes.size() ); ++p )
+	{
+		Pass& pass = passes[p];
+		if( !pass.live )
+			continue;
+
+		for( const auto& access : pass.accesses )
+		{
+			const Resource& resource = resources[access.resource];
+			ResourceState& state = states[access.resource];
+			Barrier barrier;
+			barrier.resource = access.resource;
+
+			// Pemakaian pertama transient: isi lama dibuang, tapi harus menunggu pemakai terakhir memory yang sama.
+			// Itu termasuk transient ini sendiri dan alias yang dipakai belakangan di frame sebelumnya
+			// (memory transient dipakai bersama semua frame in flight).
+			if( !resource.imported && resource.firstPass == p )
+			{
+				state = ResourceState{};
+				for( const auto& o : resources )
+				{
+					const bool sharesMemory = &o == &resource || ( o.aliased && resource.aliased && o.firstPass >= 0 &&
+						o.heapOffset < resource.heapOffset + resource.requirements.size && resource.heapOffset < o.heapOffset + o.requirements.size );
+					if( !sharesMemory )
+						continue;
+					state.writeStage |= o.lastStage;
+					state.writeAccess |= o.lastWriteAccess;
+				}
+			}
+
+			const bool layoutChange = resource.isImage && access.layout != VK_IMAGE_LAYOUT_UNDEFINED && access.layout != state.layout;
+			if( access.write || layoutChange )
+			{
+				// WAW / WAR / transisi layout: tunggu semua akses sebelumnya, write terakhir harus available
+				const VkPipelineStageFlags srcStage = state.writeStage | state.readStages;
+				if( srcStage != 0 || layoutChange )
+				{
+					barrier.srcAccess = state.writeAccess;
+					barrier.dstAccess = access.access;
+					barrier.oldLayout = resource.isImage ? state.layout : VK_IMAGE_LAYOUT_UNDEFINED;
+					barrier.newLayout = resource.isImage && layoutChange ? access.layout : barrier.oldLayout;
+					// WAR tanpa transisi cukup execution dependency
+					if( state.writeAccess == 0 && !layoutChange )
+						barrier.dstAccess = 0;
+					addBarrier( pass.before, barrier, srcStage, access.stage );
+				}
+				if( layoutChange )
+					state.layout = access.layout;
+
+				// transisi layout juga dihitung write: reader berikutnya di stage lain harus menunggu nya
+				state.writeStage = access.stage;
+				state.writeAccess = access.write ? access.access & WriteAccessMask : 0;
+				state.readStages = access.write ? 0 : access.stage;
+				state.visibleAccess = access.write ? 0 : access.access;
+			}
+			else if( state.writeStage != 0 && ( ( access.stage & ~state.readStages ) != 0 || ( access.access & ~state.visibleAccess ) != 0 ) )
+			{
+				// RAW: reader baru (stage / access yang belum pernah melihat write terakhir)
+				barrier.srcAccess = state.writeAccess;
+				barrier.dstAccess = access.access;
+				barrier.oldLayout = barrier.newLayout = resource.isImage ? state.layout : VK_IMAGE_LAYOUT_UNDEFINED;
+				addBarrier( pass.before, barrier, state.writeStage, access.stage );
+				state.readStages |= access.stage;
+				state.visibleAccess |= access.access;
+			}
+			else
+			{
+				// read-after-read / belum pernah ditulis: tidak butuh barrier
+				state.readStages |= access.stage;
+				state.visibleAccess |= access.access;
+			}
+		}
+
+		if( pass.before.srcStage != 0 )
+			++stats.barrierBatchCount;
+	}
+
+	// Resource import ke final layout, supaya pemakai di luar graph (present, readback) dapat state yang dijanjikan
+	// -------------------------------------------------------------------------------------------------------------
+	for( RenderGraphHandle i = 0; i < resources.size(); ++i )
+	{
+		const Resource& resource = resources[i];
+		const ResourceState& state = states[i];
+		if( !resource.imported || !resource.isImage || resource.firstPass < 0 || resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED )
+			continue;
+
+		if( resource.finalLayout != state.layout || state.writeAccess != 0 )
+		{
+			Barrier barrier;
+			barrier.resource = i;
+			barrier.srcAccess = state.writeAccess;
+			barrier.dstAccess = resource.finalAccess;
+			barrier.oldLayout = state.layout;
+			barrier.newLayout = resource.finalLayout;
+			addBarrier( finalBatch, barrier, state.writeStage | state.readStages, resource.finalStage );
+		}
+	}
+	if( finalBatch.srcStage != 0 )
+		++stats.barrierBatchCount;
+	// -------------------------------------------------------------------------------------------------------------
+}
+
+void RenderGraph::DestroyTransients()
+{
+	for( auto& resource : resources )
+	{
+		if( resource.imported )
+			continue;
+		vkDestroyImageView( device, resource.view, HostAllocator::Callbacks() );
+		vkDestroyImage( device, resource.image, HostAllocator::Callbacks() );
+		allocator->Free( resource.ownMemory );
+		resource.view = VK_NULL_HANDLE;
+		resource.image = VK_NULL_HANDLE;
+	}
+	allocator->Free( transientHeap );
+	transientHeap = DeviceAllocation{};
+}
+
+void RenderGraph::SetImportedImage( RenderGraphHandle resource, VkImage image )
+{
+	resources.at( resource ).image = image;
+}
+
+void RenderGraph::Execute( VkCommandBuffer commandBuffer ) const
+{
+	if( !compiled )
+		throw std::runtime_error( "Render graph is not compiled!" );
+
+	for( const auto& pass : passes )
+	{
+		if( !pass.live )
+			continue;
+		RecordBatch( commandBuffer, pass.before );
+		if( pass.execute )
+			pass.execute( commandBuffer );
+	}
+	RecordBatch( commandBuffer, finalBatch );
+}
+
+void RenderGraph::RecordBatch( VkCommandBuffer commandBuffer, const BarrierBatch& batch ) const
+{
+	if( batch.srcStage == 0 )
+		return;
+
+	std::vector<VkImageMemoryBarrier> imageBarriers;
+	std::vector<VkBufferMemoryBarrier> bufferBarriers;
+	for( const auto& barrier : batch.barriers )
+	{
+		const Resource& resource = resources[barrier.resource];
+		if( resource.isImage )
+		{
+			VkImageMemoryBarrier imageBarrier{};
+			imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			imageBarrier.srcAccessMask = barrier.srcAccess;
+			imageBarrier.dstAccessMask = barrier.dstAccess;
+			imageBarrier.oldLayout = barrier.oldLayout;
+			imageBarrier.newLayout = barrier.newLayout;
+			imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			imageBarrier.image = resource.image;
+			imageBarrier.subresourceRange = { resource.aspect, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS };
+			imageBarriers.push_back( imageBarrier );
+		}
+		else
+		{
+			VkBufferMemoryBarrier bufferBarrier{};
+			bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			bufferBarrier.srcAccessMask = barrier.srcAccess;
+			bufferBarrier.dstAccessMask = barrier.dstAccess;
+			bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			bufferBarrier.buffer = resource.buffer;
+			bufferBarrier.offset = 0;
+			bufferBarrier.size = VK_WHOLE_SIZE;
+			bufferBarriers.push_back( bufferBarrier );
+		}
+	}
+
+	vkCmdPipelineBarrier( commandBuffer, batch.srcStage, batch.dstStage, 0, 0, nullptr,
+		static_cast<uint32_t>( bufferBarriers.size() ), bufferBarriers.data(),
+		static_cast<uint32_t>( imageBarriers.size() ), imageBarriers.data() );
+}
+
+VkImage RenderGraph::GetImage( RenderGraphHandle resource ) const
+{
+	return resources.at( resource ).image;
+}
+
+VkImageView RenderGraph::GetImageView( RenderGraphHandle resource ) const
+{
+	return resources.at( resource ).view;
+}
+
+VkBuffer RenderGraph::GetBuffer( RenderGraphHandle resource ) const
+{
+	return resources.at( resource ).buffer;
+}
+
+void RenderGraph::Dump( std::ostream& out ) const
+{
+	out << "render graph: " << ( stats.passCount - stats.culledPassCount ) << "/" << stats.passCount << " passes live, "
+		<< stats.barrierBatchCount << " barrier batches (" << stats.imageBarrierCount << " image, "
+		<< stats.bufferBarrierCount << " buffer barriers)\n";
+
+	for( size_t p = 0; p < passes.size(); ++p )
+	{
+		const Pass& pass = passes[p];
+		out << "pass " << p << " \"" << pass.name << "\"" << ( pass.live ? "" : " [culled]" ) << ( pass.sideEffect ? " [side effect]" : "" ) << "\n";
+		if( !pass.live )
+			continue;
+		DumpBatch( out, pass.before );
+		for( const auto& access : pass.accesses )
+		{
+			out << "    " << ( access.read && access.write ? "read/write " : access.write ? "write " : "read " )
+				<< "\"" << resources[access.resource].name << "\" @ " << StageNames( access.stage );
+			if( access.layout != VK_IMAGE_LAYOUT_UNDEFINED )
+				out << " as " << LayoutName( access.layout );
+			out << "\n";
+		}
+	}
+	if( finalBatch.srcStage != 0 )
+	{
+		out << "after last pass\n";
+		DumpBatch( out, finalBatch );
+	}
+
+	// Transient memory
+	// ----------------
+	const VkDeviceSize saved = stats.transientBytes - stats.aliasedBytes;
+	out << "transient memory: " << stats.transientCount << " images, " << stats.transientBytes << " bytes without aliasing, "
+		<< stats.aliasedBytes << " bytes allocated, " << saved << " bytes saved";
+	if( stats.transientBytes > 0 )
+		out << " (" << ( 100 * saved / stats.transientBytes ) << "%)";
+	out << "\n";
+	for( const auto& resource : resources )
+	{
+		if( resource.imported )
+			continue;
+		out << "    \"" << resource.name << "\" " << resource.desc.extent.width << "x" << resource.desc.extent.height;
+		if( resource.firstPass < 0 )
+		{
+			out << " unused\n";
+			continue;
+		}
+		out << ", " << resource.requirements.size << " bytes, passes " << resource.firstPass << ".." << resource.lastPass;
+		if( resource.aliased )
+			out << ", heap offset " << resource.heapOffset << "\n";
+		else
+			out << ", own memory\n";
+	}
+	// ----------------
+}
+
+void RenderGraph::DumpBatch( std::ostream& out, const BarrierBatch& batch ) const
+{
+	if( batch.srcStage == 0 )
+		return;
+	out << "  barrier " << StageNames( batch.srcStage ) << " -> " << StageNames( batch.dstStage );
+	if( batch.barriers.empty() )
+		out << " (execution only)";
+	out << "\n";
+	for( const auto& barrier : batch.barriers )
+	{
+		const Resource& resource = resources[barrier.resource];
+		out << "    \"" << resource.name << "\" access 0x" << std::hex << barrier.srcAccess << " -> 0x" << barrier.dstAccess << std::dec;
+		if( resource.isImage && barrier.oldLayout != barrier.newLayout )
+			out << ", " << LayoutName( barrier.oldLayout ) << " -> " << LayoutName( barrier.newLayout );
+		out << "\n";
+	}
+}
+
+void RenderGraph::WriteDump( const std::string& path ) const
+{
+	std::ofstream file( path );
+	if( !file )
+		throw std::runtime_error( "Failed to open render graph dump file: " + path );
+	Dump( file );
+	std::cout << "render graph dump written to " << path << std::endl;
+}
+
+void RenderGraph::SelfTest( VkDevice device, DeviceAllocator& allocator, std::ostream& out )
+{
+	auto check = []( bool condition, const std::string& what )
+	{
+		if( !condition )
+			throw std::runtime_error( "Render graph self test: " + what );
+	};
+
+	RenderGraph graph;
+	graph.Init( device, allocator );
+
+	// semua transient sama persis, jadi ukuran heap yang benar bisa dihitung dari satu image
+	TransientImageDesc desc;
+	desc.format = VK_FORMAT_R8G8B8A8_UNORM;
+	desc.extent = { 256, 256 };
+	desc.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+
+	const RenderGraphHandle target = graph.ImportImage( "target", VK_NULL_HANDLE, VK_IMAGE_ASPECT_COLOR_BIT,
+		VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT );
+	graph.MarkOutput( target );
+	const RenderGraphHandle gbuffer = graph.CreateImage( "gbuffer", desc );
+	const RenderGraphHandle lit = graph.CreateImage( "lit", desc );
+	const RenderGraphHandle post = graph.CreateImage( "post", desc );
+	const RenderGraphHandle debug = graph.CreateImage( "debug", desc );
+
+	// gbuffer hidup di pass 0..1, lit 1..2, post 2..3: gbuffer dan post tidak pernah bersamaan, lit overlap dengan keduanya
+	const VkPipelineStageFlags colorStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	const VkPipelineStageFlags fragmentStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	const VkAccessFlags colorWrite = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	const VkAccessFlags shaderRead = VK_ACCESS_SHADER_READ_BIT;
+	const VkImageLayout colorLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	const VkImageLayout readLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	graph.AddPass( "geometry" ).Write( gbuffer, colorStage, colorWrite, colorLayout );
+	graph.AddPass( "lighting" ).Read( gbuffer, fragmentStage, shaderRead, readLayout ).Write( lit, colorStage, colorWrite, colorLayout );
+	graph.AddPass( "post" ).Read( lit, fragmentStage, shaderRead, readLayout ).Write( post, colorStage, colorWrite, colorLayout );
+	graph.AddPass( "composite" ).Read( post, fragmentStage, shaderRead, readLayout ).Write( target, colorStage, colorWrite, colorLayout );
+	// tulisannya tidak dibaca siapa pun: harus di-cull, "debug" tidak pernah dibuat
+	graph.AddPass( "debug overlay" ).Write( debug, colorStage, colorWrite, colorLayout );
+	graph.Compile();
+	graph.Dump( out );
+
+	const Resource& g = graph.resources[gbuffer];
+	const Resource& l = graph.resources[lit];
+	const Resource& p = graph.resources[post];
+	const VkDeviceSize size = g.requirements.size;
+	const VkDeviceSize alignment = g.requirements.alignment;
+
+	check( graph.stats.culledPassCount == 1 && !graph.passes[4].live, "\"debug overlay\" is not culled" );
+	check( graph.resources[debug].firstPass < 0 && graph.resources[debug].image == VK_NULL_HANDLE, "transient of a culled pass was created" );
+	check( graph.stats.transientCount == 3 && graph.stats.transientBytes == 3 * size, "unexpected transient count or size" );
+	check( g.aliased && l.aliased && p.aliased, "transient got its own memory" );
+
+	// post menempati memory gbuffer, lit (overlap dengan keduanya) di belakangnya
+	check( p.heapOffset == g.heapOffset, "\"post\" does not alias \"gbuffer\"" );
+	for( const Resource* other : { &g, &p } )
+	{
+		check( l.heapOffset >= other->heapOffset + size || other->heapOffset >= l.heapOffset + size,
+			"\"lit\" overlaps \"" + other->name + "\" while both are alive" );
+	}
+	const VkDeviceSize expectedBytes = ( size + alignment - 1 ) / alignment * alignment + size;
+	check( graph.stats.aliasedBytes == expectedBytes, "heap is " + std::to_string( graph.stats.aliasedBytes ) +
+		" bytes, expected " + std::to_string( expectedBytes ) );
+
+	// pemakaian pertama alias: barrier dari UNDEFINED yang menunggu pemakai terakhir memory yang sama
+	auto findBarrier = [&graph]( uint32_t pass, RenderGraphHandle resource ) -> const Barrier*
+	{
+		for( const auto& barrier : graph.passes[pass].before.barriers )
+		{
+			if( barrier.resource == resource )
+				return &barrier;
+		}
+		return nullptr;
+	};
+	const Barrier* postBarrier = findBarrier( 2, post );
+	check( postBarrier != nullptr && postBarrier->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && postBarrier->newLayout == colorLayout,
+		"no UNDEFINED -> COLOR_ATTACHMENT barrier before the first use of \"post\"" );
+	// "lighting" terakhir membaca gbuffer di FRAGMENT, tulisan post di COLOR_OUTPUT harus menunggu nya
+	check( ( graph.passes[2].before.srcStage & fragmentStage ) != 0 && ( graph.passes[2].before.dstStage & colorStage ) != 0,
+		"first use of \"post\" does not wait for the last reader of \"gbuffer\"" );
+	// gbuffer di frame berikutnya: memory nya terakhir dibaca post di "composite" (FRAGMENT)
+	const Barrier* gbufferBarrier = findBarrier( 0, gbuffer );
+	check( gbufferBarrier != nullptr && ( graph.passes[0].before.srcStage & fragmentStage ) != 0,
+		"first use of \"gbuffer\" does not wait for the last reader of \"post\" in the previous frame" );
+
+	const VkDeviceSize saved = graph.stats.transientBytes - graph.stats.aliasedBytes;
+	out << "render graph self test: passed, " << saved << " of " << graph.stats.transientBytes << " transient bytes saved by aliasing" << std::endl;
+	graph.CleanUp();
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "DeviceAllocator.h"
+
+using RenderGraphHandle = uint32_t;
+
+// Attachment sementara milik graph, hanya hidup di antara pass pertama dan terakhir yang memakainya
+struct TransientImageDesc
+{
+public:
+	VkFormat format = VK_FORMAT_UNDEFINED;
+	VkExtent2D extent{};
+	VkImageUsageFlags usage = 0;
+	VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+};
+
+struct RenderGraphStats
+{
+	uint32_t passCount = 0;
+	uint32_t culledPassCount = 0;
+	uint32_t barrierBatchCount = 0;			// vkCmdPipelineBarrier per frame
+	uint32_t imageBarrierCount = 0;
+	uint32_t bufferBarrierCount = 0;
+	uint32_t transientCount = 0;
+	VkDeviceSize transientBytes = 0;		// kalau tiap transient punya memory sendiri
+	VkDeviceSize aliasedBytes = 0;			// yang benar-benar dialokasikan setelah aliasing
+};
+
+// Frame graph: pass mendeklarasikan resource yang dibaca/ditulis (stage + access + layout),
+// Compile() membuang pass yang hasilnya tidak dipakai, menghitung barrier minimal + transisi layout,
+// dan menumpuk memory transient yang umurnya tidak overlap. Execute() tinggal memutar hasilnya.
+//
+// Dibangun + di-compile sekali, di-execute tiap frame. Resource import (swap chain image) boleh
+// diganti per frame lewat SetImportedImage(), layout/state nya dianggap sama tiap frame.
+class RenderGraph
+{
+public:
+	static constexpr RenderGraphHandle InvalidHandle = UINT32_MAX;
+	using ExecuteFn = std::function<void( VkCommandBuffer )>;
+
+	class PassBuilder
+	{
+	public:
+		// layout hanya dipakai untuk image, UNDEFINED = tidak peduli (buffer)
+		PassBuilder& Read( RenderGraphHandle resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED );
+		PassBuilder& Write( RenderGraphHandle resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED );
+		// pass yang tidak pernah di-cull walaupun tulisannya tidak dibaca siapa pun
+		PassBuilder& SideEffect();
+		PassBuilder& Execute( ExecuteFn execute );
+
+	private:
+		friend class RenderGraph;
+		PassBuilder( RenderGraph& graph, uint32_t pass ) : graph( graph ), pass( pass ) {}
+		PassBuilder& Access( RenderGraphHandle resource, VkPipelineStageFlags stage, VkAccessFlags access, VkImageLayout layout, bool write );
+
+		RenderGraph& graph;
+		uint32_t pass;
+	};
+
+public:
+	void Init( VkDevice device, DeviceAllocator& allocator );
+	void CleanUp();
+
+	// --- BUILD ---
+	// initial* = state di awal tiap frame (mis. stage tempat semaphore acquire ditunggu),
+	// final* = state yang diharapkan pemakai setelah graph (mis. PRESENT_SRC sebelum present)
+	RenderGraphHandle ImportImage( const std::string& name, VkImage image, VkImageAspectFlags aspect,
+		VkImageLayout initialLayout, VkPipelineStageFlags initialStage,
+		VkImageLayout finalLayout, VkPipelineStageFlags finalStage, VkAccessFlags finalAccess );
+	// last* = akses terakhir ke buffer ini di frame sebelumnya (graph yang sama)
+	RenderGraphHandle ImportBuffer( const std::string& name, VkBuffer buffer, VkPipelineStageFlags lastStage, VkAccessFlags lastAccess );
+	RenderGraphHandle CreateImage( const std::string& name, const TransientImageDesc& desc );
+	// resource yang hasilnya dipakai di luar graph, pass yang menulisnya tidak di-cull
+	void MarkOutput( RenderGraphHandle resource );
+	PassBuilder AddPass( const std::string& name );
+	// -------------
+
+	void Compile();
+	void SetImportedImage( RenderGraphHandle resource, VkImage image );
+	void Execute( VkCommandBuffer commandBuffer ) const;
+
+	VkImage GetImage( RenderGraphHandle resource ) const;
+	VkImageView GetImageView( RenderGraphHandle resource ) const;
+	VkBuffer GetBuffer( RenderGraphHandle resource ) const;
+
+	const RenderGraphStats& GetStats() const { return stats; }
+	// pass (live/culled), barrier per pass, lifetime + offset transient, penghematan memory
+	void Dump( std::ostream& out ) const;
+	void WriteDump( const std::string& path ) const;
+
+	// Graph sintetis di device sungguhan: transient yang umurnya overlap dan yang tidak, plus pass yang di-cull.
+	// Cek culling, offset alias, penghematan memory, dan barrier di pemakaian pertama alias. Dump nya ke out, gagal = exception
+	static void SelfTest( VkDevice device, DeviceAllocator& allocator, std::ostream& out );
+
+private:
+	struct Resource
+	{
+		std::string name;
+		bool isImage = true;
+		bool imported = false;
+		bool output = false;
+		VkImage image = VK_NULL_HANDLE;
+		VkImageView view = VK_NULL_HANDLE;
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+
+		// import
+		VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkPipelineStageFlags initialStage = 0;
+		VkAccessFlags initialAccess = 0;
+		VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkPipelineStageFlags finalStage = 0;
+		VkAccessFlags finalAccess = 0;
+
+		// transient
+		TransientImageDesc desc;
+		VkMemoryRequirements requirements{};
+		VkDeviceSize heapOffset = 0;
+		bool aliased = false;				// false = memory sendiri (memoryTypeBits tidak cocok dengan heap)
+		DeviceAllocation ownMemory;
+
+		// hasil Compile()
+		int32_t firstPass = -1;
+		int32_t lastPass = -1;
+		VkPipelineStageFlags lastStage = 0;	// akses di lastPass, buat sinkronisasi alias
+		VkAccessFlags lastWriteAccess = 0;
+	};
+
+	struct ResourceAccess
+	{
+		RenderGraphHandle resource = InvalidHandle;
+		VkPipelineStageFlags stage = 0;
+		VkAccessFlags access = 0;
+		VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		bool read = false;
+		bool write = false;
+	};
+
+	struct Barrier
+	{
+		RenderGraphHandle resource = InvalidHandle;
+		VkAccessFlags srcAccess = 0;
+		VkAccessFlags dstAccess = 0;
+		VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkImageLayout newLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	};
+
+	// satu vkCmdPipelineBarrier, kosong = tidak ada barrier
+	struct BarrierBatch
+	{
+		VkPipelineStageFlags srcStage = 0;
+		VkPipelineStageFlags dstStage = 0;
+		std::vector<Barrier> barriers;		// tanpa barrier tapi stage != 0 = execution dependency saja
+	};
+
+	struct Pass
+	{
+		std::string name;
+		std::vector<ResourceAccess> accesses;
+		ExecuteFn execute;
+		bool sideEffect = false;
+		bool live = false;
+		BarrierBatch before;
+	};
+
+	// state sinkronisasi satu resource selama Compile()
+	struct ResourceState
+	{
+		VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		VkPipelineStageFlags writeStage = 0;
+		VkAccessFlags writeAccess = 0;
+		VkPipelineStageFlags readStages = 0;	// reader sejak write terakhir (sudah tersinkron dengan write itu)
+		VkAccessFlags visibleAccess = 0;		// access yang sudah melihat hasil write terakhir
+	};
+
+	void CullPasses();
+	void ComputeLifetimes();
+	void AllocateTransients();
+	void ComputeBarriers();
+	void DestroyTransients();
+	void RecordBatch( VkCommandBuffer commandBuffer, const BarrierBatch& batch ) const;
+	void DumpBatch( std::ostream& out, const BarrierBatch& batch ) const;
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	DeviceAllocator* allocator = nullptr;
+
+	std::vector<Resource> resources;
+	std::vector<Pass> passes;
+	BarrierBatch finalBatch;				// ke final layout resource import, setelah pass terakhir
+
+	DeviceAllocation transientHeap;
+	RenderGraphStats stats;
+	bool compiled = false;
+};
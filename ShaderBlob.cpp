@@ -0,0 +1,108 @@
+#include "ShaderBlob.h"
+#include <stdexcept>
+#include <utility>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef EMBED_SHADERS
+#include "Shaders/EmbeddedShaders.h"
+#endif
+
+namespace
+{
+	constexpr uint32_t SpirvMagic = 0x07230203;
+	constexpr size_t SpirvHeaderWords = 5;
+}
+
+ShaderBlob ShaderBlob::Load( const std::string& name )
+{
+#ifdef EMBED_SHADERS
+	ShaderBlob blob = Embedded( name );
+#else
+	ShaderBlob blob = Map( "Shaders/" + name );
+#endif
+	blob.Validate( name );
+	return blob;
+}
+
+ShaderBlob::ShaderBlob( ShaderBlob&& other ) noexcept
+{
+	*this = std::move( other );
+}
+
+ShaderBlob& ShaderBlob::operator=( ShaderBlob&& other ) noexcept
+{
+	std::swap( code, other.code );
+	std::swap( wordCount, other.wordCount );
+	std::swap( mapping, other.mapping );
+	std::swap( mappingSize, other.mappingSize );
+	return *this;
+}
+
+ShaderBlob::~ShaderBlob()
+{
+	if( mapping != nullptr )
+		munmap( mapping, mappingSize );
+}
+
+ShaderBlob ShaderBlob::Map( const std::string& path )
+{
+	const int fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+	if( fd < 0 )
+		throw std::runtime_error( "Failed to open shader file " + path );
+
+	struct stat st;
+	if( fstat( fd, &st ) != 0 || st.st_size == 0 )
+	{
+		close( fd );
+		throw std::runtime_error( "Failed to stat shader file " + path );
+	}
+
+	void* mapping = mmap( nullptr, static_cast<size_t>( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+	close( fd );	// mapping tetap valid walaupun fd ditutup
+	if( mapping == MAP_FAILED )
+		throw std::runtime_error( "Failed to mmap shader file " + path );
+
+	if( st.st_size % sizeof( uint32_t ) != 0 )
+	{
+		munmap( mapping, static_cast<size_t>( st.st_size ) );
+		throw std::runtime_error( "Shader file size is not a multiple of 4: " + path );
+	}
+
+	ShaderBlob blob;
+	blob.mapping = mapping;
+	blob.mappingSize = static_cast<size_t>( st.st_size );
+	blob.code = static_cast<const uint32_t*>( mapping );
+	blob.wordCount = blob.mappingSize / sizeof( uint32_t );
+	return blob;
+}
+
+ShaderBlob ShaderBlob::Embedded( const std::string& name )
+{
+#ifdef EMBED_SHADERS
+	for( const auto& shader : embeddedShaders )
+	{
+		if( name == shader.name )
+		{
+			ShaderBlob blob;
+			blob.code = shader.code;
+			blob.wordCount = shader.wordCount;
+			return blob;
+		}
+	}
+#endif
+	throw std::runtime_error( "Shader is not embedded in this build: " + name );
+}
+
+void ShaderBlob::Validate( const std::string& name ) const
+{
+	if( wordCount < SpirvHeaderWords )
+		throw std::runtime_error( "Shader is too small to be SPIR-V: " + name );
+	if( code[0] != SpirvMagic )
+		throw std::runtime_error( "Shader has invalid SPIR-V magic number: " + name );
+	// word ke-3 = bound id, harus > 0
+	if( code[3] == 0 )
+		throw std::runtime_error( "Shader has invalid SPIR-V id bound: " + name );
+}
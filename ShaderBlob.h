@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// SPIR-V yang siap dikasih ke vkCreateShaderModule tanpa copy ke heap.
+// Backend:
+//  - default      : file .spv di-mmap read-only (alamat mmap selalu page aligned -> aman di-cast ke uint32_t*)
+//  - EMBED_SHADERS: array constexpr uint32_t yang di-generate Makefile dari Shaders/*.spv
+class ShaderBlob
+{
+public:
+	// name = nama file di folder Shaders, misal "vert.spv"
+	static ShaderBlob Load( const std::string& name );
+
+	ShaderBlob( const ShaderBlob& ) = delete;
+	ShaderBlob& operator=( const ShaderBlob& ) = delete;
+	ShaderBlob( ShaderBlob&& other ) noexcept;
+	ShaderBlob& operator=( ShaderBlob&& other ) noexcept;
+	~ShaderBlob();
+
+	const uint32_t* Code() const { return code; }
+	size_t Size() const { return wordCount * sizeof( uint32_t ); }	// dalam byte, sesuai VkShaderModuleCreateInfo::codeSize
+	size_t WordCount() const { return wordCount; }
+
+private:
+	ShaderBlob() = default;
+	static ShaderBlob Map( const std::string& path );
+	static ShaderBlob Embedded( const std::string& name );
+	void Validate( const std::string& name ) const;
+
+private:
+	const uint32_t* code = nullptr;
+	size_t wordCount = 0;
+	void* mapping = nullptr;	// nullptr kalau embedded
+	size_t mappingSize = 0;
+};
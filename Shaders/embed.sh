@@ -0,0 +1,32 @@
+#!/bin/sh
+# Generate EmbeddedShaders.h dari file .spv: setiap shader jadi array constexpr uint32_t
+# (otomatis aligned 4 byte). Dipanggil dari Makefile kalau EMBED_SHADERS=1.
+# usage: sh Shaders/embed.sh Shaders/vert.spv Shaders/frag.spv > Shaders/EmbeddedShaders.h
+
+echo "#pragma once"
+echo "// GENERATED by Shaders/embed.sh - jangan di-edit manual"
+echo "#include <cstdint>"
+echo "#include <cstddef>"
+echo ""
+
+for spv in "$@"; do
+	name=$(basename "$spv" .spv | tr -c 'a-zA-Z0-9\n' '_')
+	echo "constexpr uint32_t ${name}_spv[] = {"
+	od -An -v -tx4 "$spv" | sed -e 's/^ *//' -e 's/  */ /g' -e 's/\([0-9a-f]\{8\}\)/0x\1,/g' -e 's/^/\t/'
+	echo "};"
+	echo ""
+done
+
+echo "struct EmbeddedShader"
+echo "{"
+echo "	const char* name;"
+echo "	const uint32_t* code;"
+echo "	size_t wordCount;"
+echo "};"
+echo ""
+echo "constexpr EmbeddedShader embeddedShaders[] = {"
+for spv in "$@"; do
+	name=$(basename "$spv" .spv | tr -c 'a-zA-Z0-9\n' '_')
+	echo "	{ \"$(basename "$spv")\", ${name}_spv, sizeof( ${name}_spv ) / sizeof( uint32_t ) },"
+done
+echo "};"
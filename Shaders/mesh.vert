@@ -0,0 +1,47 @@
+#version 450
+
+// mesh dari file .mesh (lihat MeshFormat.h / MeshFile.h)
+// per vertex
+layout (location = 0) in vec3 inPosition;	// quantized: UNORM16 di dalam bounds, selain itu float
+layout (location = 1) in vec3 inNormal;		// quantized: octahedral SNORM16 di .xy, selain itu float
+layout (location = 2) in vec2 inUV;
+// per instance
+layout (location = 3) in vec2 instanceOffset;
+layout (location = 4) in float instanceScale;
+
+// sama dengan MeshDrawConstants
+layout (push_constant) uniform MeshDraw
+{
+    vec4 positionScale;
+    vec4 positionBias;
+    uint octahedralNormal;
+} mesh;
+
+// per frame, dari UniformRing (dynamic offset), sama dengan FrameUniforms
+layout (set = 1, binding = 0) uniform Frame
+{
+    vec2 viewScale;
+    vec2 viewOffset;
+    uint frameNumber;
+} frame;
+
+layout (location = 0) out vec3 fragColor;
+
+vec3 DecodeOctahedral( vec2 e )
+{
+    vec3 n = vec3( e, 1.0 - abs( e.x ) - abs( e.y ) );
+    float t = max( -n.z, 0.0 );
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize( n );
+}
+
+void main()
+{
+    // kubus [-0.5, 0.5], proyeksi orthographic (belum ada depth buffer), y file ke atas -> y Vulkan ke bawah
+    vec3 p = inPosition * mesh.positionScale.xyz + mesh.positionBias.xyz;
+    gl_Position = vec4( ( vec2( p.x, -p.y ) * instanceScale + instanceOffset ) * frame.viewScale + frame.viewOffset, 0.5, 1.0 );
+
+    vec3 n = mesh.octahedralNormal != 0 ? DecodeOctahedral( inNormal.xy ) : normalize( inNormal );
+    fragColor = n * 0.5 + 0.5;
+}
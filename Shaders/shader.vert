@@ -1,21 +1,24 @@
 #version 450
 
-vec2 position[] = {
-    { -0.5f, -0.5f },
-    { 0.5f, -0.5f },
-    { 0.0f, 0.5f }
-};
+// per vertex
+layout (location = 0) in vec2 inPosition;
+layout (location = 1) in vec3 inColor;
+// per instance
+layout (location = 2) in vec2 instanceOffset;
+layout (location = 3) in float instanceScale;
 
-vec3 colors[] = {
-    { 1.0f, 0.0f, 0.0f },
-    { 0.0f, 1.0f, 0.0f },
-    { 0.0f, 0.0f, 1.0f }
-};
+// per frame, dari UniformRing (dynamic offset), sama dengan FrameUniforms
+layout (set = 1, binding = 0) uniform Frame
+{
+    vec2 viewScale;
+    vec2 viewOffset;
+    uint frameNumber;
+} frame;
 
 layout (location = 0) out vec3 fragColor;
 
 void main()
 {
-    gl_Position = vec4( position[gl_VertexIndex], 0.0f, 1.0f );
-    fragColor = colors[gl_VertexIndex];
-}
\ No newline at end of file
+    gl_Position = vec4( ( inPosition * instanceScale + instanceOffset ) * frame.viewScale + frame.viewOffset, 0.0f, 1.0f );
+    fragColor = inColor;
+}
@@ -0,0 +1,620 @@
+#include "TextureStreamer.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "CpuTrace.h"
+#include "HostAllocator.h"
+#include "ShaderBlob.h"
+
+namespace
+{
+	constexpr uint32_t MipGenWorkgroupSize = 8;		// sama dengan local_size di Shaders/mipgen.comp
+
+	// layout sampling: dibaca dari shader mana saja (bindless)
+	constexpr VkPipelineStageFlags ShaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+	VkImageMemoryBarrier MipBarrier( VkImage image, uint32_t baseMip, uint32_t mipCount, VkImageLayout oldLayout, VkImageLayout newLayout,
+		VkAccessFlags srcAccess, VkAccessFlags dstAccess )
+	{
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcAccessMask = srcAccess;
+		barrier.dstAccessMask = dstAccess;
+		barrier.oldLayout = oldLayout;
+		barrier.newLayout = newLayout;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = image;
+		barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, baseMip, mipCount, 0, 1 };
+		return barrier;
+	}
+}
+
+void TextureStreamer::Init( VkDevice device, VkPhysicalDevice physicalDevice, VkPipelineCache pipelineCache,
+	DeviceAllocator& allocator, UploadManager& uploads, BindlessDescriptors& bindless, uint32_t framesInFlight,
+	VkDeviceSize budgetBytes, uint32_t decodeThreads, VkDeviceSize uploadBytesPerFrame )
+{
+	this->device = device;
+	this->allocator = &allocator;
+	this->uploads = &uploads;
+	this->bindless = &bindless;
+	this->framesInFlight = framesInFlight;
+	this->uploadBytesPerFrame = uploadBytesPerFrame;
+	stats.budgetBytes = budgetBytes;
+
+	// sisakan satu core untuk main thread
+	if( decodeThreads == 0 )
+		decodeThreads = std::max( 1U, std::thread::hardware_concurrency() - 1 );
+	pool = std::make_unique<ThreadPool>( decodeThreads );
+	shuttingDown = false;
+
+	// Mip generation: blit linear kalau format nya bisa, selain itu compute shader (storage image)
+	// -------------------------------------------------------------------------------------------
+	VkFormatProperties formatProperties;
+	vkGetPhysicalDeviceFormatProperties( physicalDevice, Format, &formatProperties );
+	const VkFormatFeatureFlags features = formatProperties.optimalTilingFeatures;
+	const VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+	blitMips = ( features & blitFeatures ) == blitFeatures;
+	generateMips = blitMips || ( features & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT );
+	if( generateMips && !blitMips )
+	{
+		CreateComputePipeline( pipelineCache );
+		mipGenDescriptors.resize( framesInFlight );
+		for( auto& descriptors : mipGenDescriptors )
+			descriptors.Init( device, 64, { { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 128 } } );
+	}
+	// -------------------------------------------------------------------------------------------
+
+	std::cout << "textures: " << decodeThreads << " decode threads, budget " << ( budgetBytes >> 20 ) << " MiB, mips "
+		<< ( !generateMips ? "disabled (format has no blit/storage support)" : blitMips ? "via blit" : "via compute" ) << std::endl;
+}
+
+void TextureStreamer::CleanUp()
+{
+	// decode yang belum mulai dilewati, yang sedang jalan ditunggu
+	shuttingDown = true;
+	pool.reset();
+
+	for( auto& texture : textures )
+	{
+		DestroyImage( texture.tail );
+		DestroyImage( texture.full );
+	}
+	for( auto& retired : pendingDestroy )
+	{
+		for( VkImageView view : retired.mipViews )
+			vkDestroyImageView( device, view, HostAllocator::Callbacks() );
+		DestroyImage( retired.image );
+	}
+	textures.clear();
+	pendingDestroy.clear();
+	pendingFull.clear();
+	wantsFull.clear();
+	mipGenQueue.clear();
+	completed.clear();
+
+	for( auto& descriptors : mipGenDescriptors )
+		descriptors.CleanUp();
+	mipGenDescriptors.clear();
+	vkDestroyPipeline( device, mipGenPipeline, HostAllocator::Callbacks() );
+	vkDestroyPipelineLayout( device, mipGenPipelineLayout, HostAllocator::Callbacks() );
+	vkDestroyDescriptorSetLayout( device, mipGenSetLayout, HostAllocator::Callbacks() );
+	mipGenPipeline = VK_NULL_HANDLE;
+	mipGenPipelineLayout = VK_NULL_HANDLE;
+	mipGenSetLayout = VK_NULL_HANDLE;
+}
+
+TextureHandle TextureStreamer::Load( const std::string& path )
+{
+	const TextureHandle handle = static_cast<TextureHandle>( textures.size() );
+	textures.push_back( Texture{} );
+	textures.back().path = path;
+	++stats.textureCount;
+	SubmitDecode( handle, true );
+	return handle;
+}
+
+void TextureStreamer::Touch( TextureHandle texture )
+{
+	Texture& t = textures[texture];
+	t.lastUsedFrame = frameCounter;
+	if( t.state == State::TailResident && !t.tailIsComplete && !t.decodePending && !t.wantsFull )
+	{
+		t.wantsFull = true;
+		wantsFull.push_back( texture );
+	}
+}
+
+uint32_t TextureStreamer::GetBindlessIndex( TextureHandle texture ) const
+{
+	const Texture& t = textures[texture];
+	return t.state == State::FullResident ? t.full.bindlessIndex : t.tail.bindlessIndex;
+}
+
+bool TextureStreamer::IsFullyResident( TextureHandle texture ) const
+{
+	const Texture& t = textures[texture];
+	return t.state == State::FullResident || ( t.tailIsComplete && t.state == State::TailResident );
+}
+
+void TextureStreamer::SubmitDecode( TextureHandle texture, bool withTail )
+{
+	textures[texture].decodePending = true;
+	++decodesInFlight;
+	pool->Submit( [this, texture, withTail, path = textures[texture].path]
+		{
+			DecodeResult result;
+			result.texture = texture;
+			if( !shuttingDown )
+			{
+				TRACE_ZONE( "DecodeTexture" );
+				try
+				{
+					result.full = std::make_shared<DecodedImage>( ImageDecoder::Decode( path ) );
+					if( withTail )
+					{
+						// mip pertama yang muat di TailSize, lalu terus sampai 1x1
+						DecodedImage level = *result.full;
+						while( level.width > TailSize || level.height > TailSize )
+							level = ImageDecoder::Downsample( level );
+						result.tail.push_back( std::move( level ) );
+						while( result.tail.back().width > 1 || result.tail.back().height > 1 )
+							result.tail.push_back( ImageDecoder::Downsample( result.tail.back() ) );
+					}
+				}
+				catch( const std::exception& e )
+				{
+					result.full.reset();
+					result.error = e.what();
+				}
+			}
+
+			std::lock_guard<std::mutex> lock( completedMutex );
+			completed.push_back( std::move( result ) );
+		} );
+}
+
+void TextureStreamer::Update( uint32_t frameIndex )
+{
+	TRACE_ZONE( "TextureStreamer::Update" );
+	++frameCounter;
+	this->frameIndex = frameIndex;
+
+	// image yang dibuang framesInFlight frame lalu sudah tidak dibaca GPU
+	while( !pendingDestroy.empty() && pendingDestroy.front().frame + framesInFlight <= frameCounter )
+	{
+		for( VkImageView view : pendingDestroy.front().mipViews )
+			vkDestroyImageView( device, view, HostAllocator::Callbacks() );
+		DestroyImage( pendingDestroy.front().image );
+		pendingDestroy.pop_front();
+	}
+	if( !mipGenDescriptors.empty() )
+		mipGenDescriptors[frameIndex].Reset();
+
+	// Hasil decode: tail langsung di-upload, mip 0 antri (kalau budget nya dapat)
+	// ---------------------------------------------------------------------------
+	std::vector<DecodeResult> results;
+	{
+		std::lock_guard<std::mutex> lock( completedMutex );
+		results.swap( completed );
+	}
+	for( auto& result : results )
+	{
+		--decodesInFlight;
+		Texture& t = textures[result.texture];
+		t.decodePending = false;
+
+		if( !result.full )
+		{
+			if( !shuttingDown )
+				std::cerr << "texture " << t.path << ": " << result.error << std::endl;
+			t.reservedBytes = 0;
+			if( t.state == State::Decoding )
+			{
+				t.state = State::Failed;
+				++stats.failedCount;
+			}
+			continue;
+		}
+
+		if( !result.tail.empty() )
+		{
+			t.extent = { result.full->width, result.full->height };
+			UploadTail( t, result.tail );
+			t.state = State::TailResident;
+			// texture kecil: tail sudah mip chain lengkap, tidak perlu image full
+			t.tailIsComplete = t.extent.width <= TailSize && t.extent.height <= TailSize;
+			if( t.tailIsComplete )
+				continue;
+		}
+
+		// decode pertama: pesan budget sekarang. Decode ulang: budget nya sudah dipesan sebelum submit
+		if( t.reservedBytes == 0 && !Reserve( result.texture, FullBytes( t.extent ) ) )
+			continue;
+		t.state = State::FullUploading;
+		pendingFull.push_back( PendingFull{ result.texture, result.full } );
+	}
+	// ---------------------------------------------------------------------------
+
+	// Mip 0 ke GPU, dibatasi byte per frame supaya satu frame tidak menanggung seluruh texture set
+	// -----------------------------------------------------------------------------------------------
+	VkDeviceSize uploaded = 0;
+	while( !pendingFull.empty() )
+	{
+		const PendingFull& next = pendingFull.front();
+		if( uploaded > 0 && uploaded + next.pixels->ByteSize() > uploadBytesPerFrame )
+			break;
+		uploaded += next.pixels->ByteSize();
+		UploadFull( next.texture, *next.pixels );
+		pendingFull.pop_front();
+	}
+	// -----------------------------------------------------------------------------------------------
+
+	// Texture yang dipakai lagi setelah image full nya dibuang: decode ulang kalau budget nya dapat
+	// -------------------------------------------------------------------------------------------------
+	for( TextureHandle handle : wantsFull )
+	{
+		Texture& t = textures[handle];
+		t.wantsFull = false;
+		if( t.state != State::TailResident || t.decodePending || !Reserve( handle, FullBytes( t.extent ) ) )
+			continue;
+		SubmitDecode( handle, false );
+	}
+	wantsFull.clear();
+	// -------------------------------------------------------------------------------------------------
+}
+
+void TextureStreamer::RecordMipGeneration( VkCommandBuffer commandBuffer )
+{
+	for( TextureHandle handle : mipGenQueue )
+	{
+		Texture& t = textures[handle];
+		if( !generateMips )
+		{
+			// cuma mip 0: transisi ke SHADER_READ_ONLY sudah dilakukan RecordAcquire()
+		}
+		else if( blitMips )
+		{
+			RecordBlitChain( commandBuffer, t );
+			++stats.blitMipChains;
+		}
+		else
+		{
+			RecordComputeChain( commandBuffer, t );
+			++stats.computeMipChains;
+		}
+
+		// draw di command buffer ini (setelah barrier di atas) sudah boleh sampling dari image full
+		t.full.bindlessIndex = bindless->AddTexture( t.full.view );
+		t.state = State::FullResident;
+		++stats.fullyResident;
+	}
+	mipGenQueue.clear();
+}
+
+void TextureStreamer::UploadTail( Texture& texture, const std::vector<DecodedImage>& tail )
+{
+	CreateImage( texture.tail, { tail[0].width, tail[0].height }, static_cast<uint32_t>( tail.size() ),
+		VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT );
+	for( uint32_t mip = 0; mip < tail.size(); ++mip )
+	{
+		uploads->UploadImage( texture.tail.image, { VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, 1 }, { tail[mip].width, tail[mip].height, 1 },
+			tail[mip].pixels.data(), tail[mip].ByteSize(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, ShaderStages, VK_ACCESS_SHADER_READ_BIT );
+		stats.bytesStreamed += tail[mip].ByteSize();
+	}
+	texture.tail.bindlessIndex = bindless->AddTexture( texture.tail.view );
+}
+
+void TextureStreamer::UploadFull( TextureHandle handle, const DecodedImage& pixels )
+{
+	Texture& t = textures[handle];
+
+	VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	if( generateMips )
+		usage |= blitMips ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : VK_IMAGE_USAGE_STORAGE_BIT;
+	CreateImage( t.full, t.extent, generateMips ? MipCount( t.extent ) : 1, usage );
+
+	// pesanan budget diganti ukuran image yang sebenarnya
+	stats.residentBytes += t.full.bytes;
+	t.reservedBytes = 0;
+
+	// mip 0 diserahkan ke graphics queue dalam layout yang dipakai mip generation
+	VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	VkPipelineStageFlags stage = ShaderStages;
+	VkAccessFlags access = VK_ACCESS_SHADER_READ_BIT;
+	if( generateMips && blitMips )
+	{
+		layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		access = VK_ACCESS_TRANSFER_READ_BIT;
+	}
+	else if( generateMips )
+	{
+		layout = VK_IMAGE_LAYOUT_GENERAL;
+		stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	}
+	uploads->UploadImage( t.full.image, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 }, { t.extent.width, t.extent.height, 1 },
+		pixels.pixels.data(), pixels.ByteSize(), layout, stage, access );
+	stats.bytesStreamed += pixels.ByteSize();
+
+	mipGenQueue.push_back( handle );
+}
+
+bool TextureStreamer::Reserve( TextureHandle texture, VkDeviceSize bytes )
+{
+	auto used = [this]
+	{
+		VkDeviceSize reserved = 0;
+		for( const auto& t : textures )
+			reserved += t.reservedBytes;
+		return stats.residentBytes + reserved;
+	};
+
+	while( used() + bytes > stats.budgetBytes )
+	{
+		// LRU: image full yang tidak dipakai frame ini maupun frame sebelumnya
+		TextureHandle victim = InvalidHandle;
+		for( TextureHandle i = 0; i < textures.size(); ++i )
+		{
+			const Texture& t = textures[i];
+			if( i == texture || t.state != State::FullResident || t.lastUsedFrame + 1 >= frameCounter )
+				continue;
+			if( victim == InvalidHandle || t.lastUsedFrame < textures[victim].lastUsedFrame )
+				victim = i;
+		}
+		if( victim == InvalidHandle )
+			return false;
+		Evict( victim );
+	}
+
+	textures[texture].reservedBytes = bytes;
+	return true;
+}
+
+void TextureStreamer::Evict( TextureHandle texture )
+{
+	Texture& t = textures[texture];
+	bindless->RemoveTexture( t.full.bindlessIndex );
+	stats.residentBytes -= t.full.bytes;
+
+	PendingDestroy retired;
+	retired.frame = frameCounter;
+	retired.image = t.full;
+	pendingDestroy.push_back( retired );
+	t.full = GpuImage{};
+
+	t.state = State::TailResident;
+	--stats.fullyResident;
+	++stats.evictionCount;
+}
+
+void TextureStreamer::RecordBlitChain( VkCommandBuffer commandBuffer, Texture& texture )
+{
+	const VkImage image = texture.full.image;
+	const uint32_t mipLevels = texture.full.mipLevels;
+
+	// mip 0 sudah TRANSFER_SRC (RecordAcquire), sisanya belum pernah dipakai
+	VkImageMemoryBarrier barrier = MipBarrier( image, 1, mipLevels - 1, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		0, VK_ACCESS_TRANSFER_WRITE_BIT );
+	vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+
+	int32_t width = static_cast<int32_t>( texture.extent.width );
+	int32_t height = static_cast<int32_t>( texture.extent.height );
+	for( uint32_t mip = 1; mip < mipLevels; ++mip )
+	{
+		const int32_t nextWidth = std::max( 1, width / 2 );
+		const int32_t nextHeight = std::max( 1, height / 2 );
+
+		VkImageBlit blit{};
+		blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mip - 1, 0, 1 };
+		blit.srcOffsets[1] = { width, height, 1 };
+		blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, 1 };
+		blit.dstOffsets[1] = { nextWidth, nextHeight, 1 };
+		vkCmdBlitImage( commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR );
+
+		// mip ini jadi sumber blit berikutnya
+		barrier = MipBarrier( image, mip, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT );
+		vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+
+		width = nextWidth;
+		height = nextHeight;
+	}
+
+	barrier = MipBarrier( image, 0, mipLevels, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT );
+	vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, ShaderStages, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+}
+
+void TextureStreamer::RecordComputeChain( VkCommandBuffer commandBuffer, Texture& texture )
+{
+	const VkImage image = texture.full.image;
+	const uint32_t mipLevels = texture.full.mipLevels;
+
+	// satu view per mip (storage image selalu satu mip), dibuang bareng frame ini
+	PendingDestroy views;
+	views.frame = frameCounter;
+	for( uint32_t mip = 0; mip < mipLevels; ++mip )
+	{
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = Format;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, mip, 1, 0, 1 };
+		VkImageView view;
+		if( vkCreateImageView( device, &viewInfo, HostAllocator::Callbacks(), &view ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create mip view!" );
+		views.mipViews.push_back( view );
+	}
+
+	// mip 0 sudah GENERAL (RecordAcquire), sisanya belum pernah dipakai
+	VkImageMemoryBarrier barrier = MipBarrier( image, 1, mipLevels - 1, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+		0, VK_ACCESS_SHADER_WRITE_BIT );
+	vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+
+	vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mipGenPipeline );
+	uint32_t width = texture.extent.width;
+	uint32_t height = texture.extent.height;
+	for( uint32_t mip = 1; mip < mipLevels; ++mip )
+	{
+		width = std::max( 1U, width / 2 );
+		height = std::max( 1U, height / 2 );
+
+		const VkDescriptorSet set = mipGenDescriptors[frameIndex].Allocate( mipGenSetLayout );
+		VkDescriptorImageInfo imageInfos[2]{};
+		imageInfos[0] = { VK_NULL_HANDLE, views.mipViews[mip - 1], VK_IMAGE_LAYOUT_GENERAL };
+		imageInfos[1] = { VK_NULL_HANDLE, views.mipViews[mip], VK_IMAGE_LAYOUT_GENERAL };
+		VkWriteDescriptorSet writes[2]{};
+		for( uint32_t i = 0; i < 2; ++i )
+		{
+			writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writes[i].dstSet = set;
+			writes[i].dstBinding = i;
+			writes[i].descriptorCount = 1;
+			writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+			writes[i].pImageInfo = &imageInfos[i];
+		}
+		vkUpdateDescriptorSets( device, 2, writes, 0, nullptr );
+
+		vkCmdBindDescriptorSets( commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mipGenPipelineLayout, 0, 1, &set, 0, nullptr );
+		vkCmdDispatch( commandBuffer, ( width + MipGenWorkgroupSize - 1 ) / MipGenWorkgroupSize, ( height + MipGenWorkgroupSize - 1 ) / MipGenWorkgroupSize, 1 );
+
+		barrier = MipBarrier( image, mip, 1, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT );
+		vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+	}
+
+	barrier = MipBarrier( image, 0, mipLevels, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT );
+	vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, ShaderStages, 0, 0, nullptr, 0, nullptr, 1, &barrier );
+
+	pendingDestroy.push_back( std::move( views ) );
+}
+
+void TextureStreamer::CreateImage( GpuImage& image, VkExtent2D extent, uint32_t mipLevels, VkImageUsageFlags usage )
+{
+	VkImageCreateInfo imageInfo{};
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.format = Format;
+	imageInfo.extent = { extent.width, extent.height, 1 };
+	imageInfo.mipLevels = mipLevels;
+	imageInfo.arrayLayers = 1;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.usage = usage;
+	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	if( vkCreateImage( device, &imageInfo, HostAllocator::Callbacks(), &image.image ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create texture image!" );
+	image.memory = allocator->AllocateForImage( image.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+	image.bytes = image.memory.size;
+	image.mipLevels = mipLevels;
+
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = image.image;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewInfo.format = Format;
+	viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, 1 };
+	if( vkCreateImageView( device, &viewInfo, HostAllocator::Callbacks(), &image.view ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create texture image view!" );
+}
+
+void TextureStreamer::DestroyImage( GpuImage& image )
+{
+	if( image.image == VK_NULL_HANDLE )
+		return;
+	vkDestroyImageView( device, image.view, HostAllocator::Callbacks() );
+	vkDestroyImage( device, image.image, HostAllocator::Callbacks() );
+	allocator->Free( image.memory );
+	image = GpuImage{};
+}
+
+void TextureStreamer::CreateComputePipeline( VkPipelineCache pipelineCache )
+{
+	VkDescriptorSetLayoutBinding bindings[2]{};
+	for( uint32_t i = 0; i < 2; ++i )
+	{
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+	VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+	setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	setLayoutInfo.bindingCount = 2;
+	setLayoutInfo.pBindings = bindings;
+	if( vkCreateDescriptorSetLayout( device, &setLayoutInfo, HostAllocator::Callbacks(), &mipGenSetLayout ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create mip generation descriptor set layout!" );
+
+	VkPipelineLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	layoutInfo.setLayoutCount = 1;
+	layoutInfo.pSetLayouts = &mipGenSetLayout;
+	if( vkCreatePipelineLayout( device, &layoutInfo, HostAllocator::Callbacks(), &mipGenPipelineLayout ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create mip generation pipeline layout!" );
+
+	const ShaderBlob blob = ShaderBlob::Load( "mipgen.spv" );
+
+	VkShaderModuleCreateInfo moduleInfo{};
+	moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	moduleInfo.codeSize = blob.Size();
+	moduleInfo.pCode = blob.Code();
+
+	VkShaderModule module;
+	if( vkCreateShaderModule( device, &moduleInfo, HostAllocator::Callbacks(), &module ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create mip generation shader module!" );
+
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	pipelineInfo.stage.module = module;
+	pipelineInfo.stage.pName = "main";
+	pipelineInfo.layout = mipGenPipelineLayout;
+
+	const VkResult result = vkCreateComputePipelines( device, pipelineCache, 1, &pipelineInfo, HostAllocator::Callbacks(), &mipGenPipeline );
+	vkDestroyShaderModule( device, module, HostAllocator::Callbacks() );
+	if( result != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create mip generation pipeline!" );
+}
+
+uint32_t TextureStreamer::MipCount( VkExtent2D extent )
+{
+	uint32_t count = 1;
+	for( uint32_t size = std::max( extent.width, extent.height ); size > 1; size /= 2 )
+		++count;
+	return count;
+}
+
+VkDeviceSize TextureStreamer::FullBytes( VkExtent2D extent )
+{
+	// perkiraan sebelum image nya dibuat (RGBA8, mip chain penuh), alignment driver tidak dihitung
+	VkDeviceSize bytes = 0;
+	for( uint32_t w = extent.width, h = extent.height;; w = std::max( 1U, w / 2 ), h = std::max( 1U, h / 2 ) )
+	{
+		bytes += static_cast<VkDeviceSize>( w ) * h * 4;
+		if( w == 1 && h == 1 )
+			break;
+	}
+	return bytes;
+}
+
+TextureStreamStats TextureStreamer::GetStats() const
+{
+	TextureStreamStats result = stats;
+	result.outstandingRequests = decodesInFlight + static_cast<uint32_t>( pendingFull.size() + mipGenQueue.size() );
+	return result;
+}
+
+void TextureStreamer::PrintStats( std::ostream& out ) const
+{
+	const TextureStreamStats s = GetStats();
+	out << "textures: " << s.textureCount << " loaded (" << s.fullyResident << " full res, " << s.failedCount << " failed), "
+		<< s.bytesStreamed / 1024 << " KiB streamed, " << s.outstandingRequests << " outstanding, resident "
+		<< ( s.residentBytes >> 20 ) << " / " << ( s.budgetBytes >> 20 ) << " MiB, " << s.evictionCount << " evictions, mip chains "
+		<< s.blitMipChains << " blit / " << s.computeMipChains << " compute" << std::endl;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "BindlessDescriptors.h"
+#include "DescriptorAllocator.h"
+#include "DeviceAllocator.h"
+#include "ImageDecoder.h"
+#include "ThreadPool.h"
+#include "UploadManager.h"
+
+using TextureHandle = uint32_t;
+
+struct TextureStreamStats
+{
+	uint64_t bytesStreamed = 0;				// pixel yang sudah di-upload (tail + mip 0 full)
+	uint32_t outstandingRequests = 0;		// decode yang belum selesai + hasil decode yang belum jadi mip chain
+	uint32_t textureCount = 0;
+	uint32_t fullyResident = 0;				// texture dengan mip chain penuh
+	uint32_t failedCount = 0;
+	VkDeviceSize residentBytes = 0;			// memory image full resolusi (tail tidak dihitung ke budget)
+	VkDeviceSize budgetBytes = 0;
+	uint64_t evictionCount = 0;
+	uint64_t blitMipChains = 0;
+	uint64_t computeMipChains = 0;
+};
+
+// Texture streaming:
+//  1. Load() -> file di-decode di worker thread, di sana juga dibuat "tail" (mip <= TailSize) di CPU
+//  2. Update(): tail di-upload dan langsung bisa dipakai (resolusi rendah, selalu resident)
+//  3. mip 0 di-upload (dibatasi byte per frame), RecordMipGeneration() bikin mip sisanya di GPU
+//     (vkCmdBlitImage, atau compute kalau format nya tidak bisa di-blit linear), lalu index bindless
+//     texture pindah ke image full
+// Image full kena budget: kalau penuh, image full yang paling lama tidak di-Touch() dibuang (tail tetap ada),
+// dan di-decode ulang waktu di-Touch() lagi.
+class TextureStreamer
+{
+public:
+	static constexpr TextureHandle InvalidHandle = UINT32_MAX;
+	static constexpr uint32_t TailSize = 64;
+	// UNORM, bukan SRGB: storage image (compute fallback) tidak bisa SRGB
+	static constexpr VkFormat Format = VK_FORMAT_R8G8B8A8_UNORM;
+
+	void Init( VkDevice device, VkPhysicalDevice physicalDevice, VkPipelineCache pipelineCache,
+		DeviceAllocator& allocator, UploadManager& uploads, BindlessDescriptors& bindless, uint32_t framesInFlight,
+		VkDeviceSize budgetBytes, uint32_t decodeThreads = 0, VkDeviceSize uploadBytesPerFrame = 16ULL << 20 );
+	void CleanUp();
+
+	// tidak pernah menunggu, file nya dibaca di worker thread
+	TextureHandle Load( const std::string& path );
+	// texture dipakai frame ini (LRU)
+	void Touch( TextureHandle texture );
+	// BindlessDescriptors::InvalidIndex sampai tail nya resident. Berubah saat full image masuk / dibuang,
+	// jadi ambil ulang tiap frame (jangan disimpan di buffer yang tidak di-update)
+	uint32_t GetBindlessIndex( TextureHandle texture ) const;
+	bool IsFullyResident( TextureHandle texture ) const;
+
+	// sebelum UploadManager::Flush() frame ini, setelah fence frame tsb signaled
+	void Update( uint32_t frameIndex );
+	// di command buffer graphics frame yang sama, setelah UploadManager::RecordAcquire()
+	void RecordMipGeneration( VkCommandBuffer commandBuffer );
+
+	TextureStreamStats GetStats() const;
+	void PrintStats( std::ostream& out ) const;
+
+private:
+	enum class State
+	{
+		Decoding,			// belum ada yang resident
+		TailResident,
+		FullUploading,		// mip 0 sedang di-upload / menunggu mip generation
+		FullResident,
+		Failed
+	};
+
+	struct GpuImage
+	{
+		VkImage image = VK_NULL_HANDLE;
+		VkImageView view = VK_NULL_HANDLE;
+		DeviceAllocation memory;
+		VkDeviceSize bytes = 0;
+		uint32_t mipLevels = 0;
+		uint32_t bindlessIndex = BindlessDescriptors::InvalidIndex;
+	};
+
+	struct Texture
+	{
+		std::string path;
+		State state = State::Decoding;
+		VkExtent2D extent{};				// mip 0, 0 = belum pernah di-decode
+		GpuImage tail;
+		GpuImage full;
+		bool tailIsComplete = false;		// texture kecil: tail = seluruh mip chain
+		bool decodePending = false;
+		bool wantsFull = false;
+		VkDeviceSize reservedBytes = 0;		// budget yang dipesan untuk image full yang sedang dalam perjalanan
+		uint64_t lastUsedFrame = 0;
+	};
+
+	// hasil worker thread
+	struct DecodeResult
+	{
+		TextureHandle texture = InvalidHandle;
+		std::shared_ptr<DecodedImage> full;	// nullptr = gagal
+		std::vector<DecodedImage> tail;		// kosong kalau tail sudah resident (decode ulang)
+		std::string error;
+	};
+
+	struct PendingFull
+	{
+		TextureHandle texture = InvalidHandle;
+		std::shared_ptr<DecodedImage> pixels;
+	};
+
+	// dibuang setelah framesInFlight frame (frame yang masih jalan mungkin masih membaca nya)
+	struct PendingDestroy
+	{
+		uint64_t frame = 0;
+		GpuImage image;
+		std::vector<VkImageView> mipViews;
+	};
+
+	void SubmitDecode( TextureHandle texture, bool withTail );
+	void CreateImage( GpuImage& image, VkExtent2D extent, uint32_t mipLevels, VkImageUsageFlags usage );
+	void DestroyImage( GpuImage& image );
+	void UploadTail( Texture& texture, const std::vector<DecodedImage>& tail );
+	void UploadFull( TextureHandle texture, const DecodedImage& pixels );
+	// pesan budget, kalau perlu buang image full yang paling lama tidak dipakai
+	bool Reserve( TextureHandle texture, VkDeviceSize bytes );
+	void Evict( TextureHandle texture );
+	void RecordBlitChain( VkCommandBuffer commandBuffer, Texture& texture );
+	void RecordComputeChain( VkCommandBuffer commandBuffer, Texture& texture );
+	void CreateComputePipeline( VkPipelineCache pipelineCache );
+	static uint32_t MipCount( VkExtent2D extent );
+	static VkDeviceSize FullBytes( VkExtent2D extent );
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	DeviceAllocator* allocator = nullptr;
+	UploadManager* uploads = nullptr;
+	BindlessDescriptors* bindless = nullptr;
+	uint32_t framesInFlight = 1;
+	VkDeviceSize uploadBytesPerFrame = 0;
+
+	std::unique_ptr<ThreadPool> pool;
+	std::atomic<bool> shuttingDown{ false };
+	std::atomic<uint32_t> decodesInFlight{ 0 };
+	std::mutex completedMutex;
+	std::vector<DecodeResult> completed;
+
+	// --- MAIN THREAD ---
+	std::vector<Texture> textures;
+	std::vector<TextureHandle> wantsFull;
+	std::deque<PendingFull> pendingFull;
+	std::vector<TextureHandle> mipGenQueue;		// mip 0 ikut batch upload frame ini
+	std::deque<PendingDestroy> pendingDestroy;
+	uint64_t frameCounter = 0;
+	uint32_t frameIndex = 0;
+	TextureStreamStats stats;
+	// -------------------
+
+	// --- MIP GENERATION ---
+	bool blitMips = true;						// false = compute (storage image)
+	bool generateMips = true;					// false = format tidak bisa blit maupun storage, full image cuma mip 0
+	VkDescriptorSetLayout mipGenSetLayout = VK_NULL_HANDLE;
+	VkPipelineLayout mipGenPipelineLayout = VK_NULL_HANDLE;
+	VkPipeline mipGenPipeline = VK_NULL_HANDLE;
+	std::vector<DescriptorAllocator> mipGenDescriptors;	// per frame in flight, di-reset di Update()
+	// ----------------------
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <algorithm>
+
+#include "CpuTrace.h"
+
+// Thread pool sederhana: antrian FIFO, Submit() mengembalikan std::future
+class ThreadPool
+{
+public:
+	explicit ThreadPool( size_t threadCount = std::max( 1U, std::thread::hardware_concurrency() ) )
+	{
+		for( size_t i = 0; i < threadCount; ++i )
+			workers.emplace_back( [this] { WorkerLoop(); } );
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			stopping = true;
+		}
+		condition.notify_all();
+		for( auto& worker : workers )
+			worker.join();
+	}
+
+	ThreadPool( const ThreadPool& ) = delete;
+	ThreadPool& operator=( const ThreadPool& ) = delete;
+
+	template<typename F>
+	auto Submit( F&& task ) -> std::future<decltype( task() )>
+	{
+		using Result = decltype( task() );
+		// packaged_task tidak bisa di-copy, jadi dibungkus shared_ptr supaya muat di std::function
+		auto packaged = std::make_shared<std::packaged_task<Result()>>( std::forward<F>( task ) );
+		std::future<Result> future = packaged->get_future();
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			tasks.emplace_back( [packaged] { ( *packaged )(); } );
+		}
+		condition.notify_one();
+		return future;
+	}
+
+	size_t Size() const { return workers.size(); }
+
+private:
+	void WorkerLoop()
+	{
+		if( CpuTrace::IsEnabled() )
+			CpuTrace::SetThreadName( "pool worker" );
+
+		for( ;; )
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock( mutex );
+				condition.wait( lock, [this] { return stopping || !tasks.empty(); } );
+				if( stopping && tasks.empty() )
+					return;
+				task = std::move( tasks.front() );
+				tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+private:
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool stopping = false;
+};
@@ -0,0 +1,305 @@
+#include "TlsfAllocator.h"
+#include <algorithm>
+
+namespace
+{
+	uint32_t MostSignificantBit( uint64_t value )
+	{
+		return 63U - static_cast<uint32_t>( __builtin_clzll( value ) );
+	}
+
+	uint32_t LeastSignificantBit( uint64_t value )
+	{
+		return static_cast<uint32_t>( __builtin_ctzll( value ) );
+	}
+
+	uint64_t AlignUp( uint64_t value, uint64_t alignment )
+	{
+		return ( value + alignment - 1 ) / alignment * alignment;
+	}
+}
+
+void TlsfAllocator::Init( uint64_t capacity )
+{
+	this->capacity = capacity;
+	usedBytes = 0;
+	allocationCount = 0;
+	freeRegionCount = 0;
+	nodes.clear();
+	unusedNodes.clear();
+	flBitmap = 0;
+	std::fill( std::begin( slBitmap ), std::end( slBitmap ), 0U );
+	for( auto& heads : freeHeads )
+		std::fill( std::begin( heads ), std::end( heads ), InvalidHandle );
+
+	// awalnya satu region free sebesar capacity
+	const uint32_t node = NewNode();
+	nodes[node] = { 0, capacity, InvalidHandle, InvalidHandle, InvalidHandle, InvalidHandle, true };
+	InsertFree( node );
+}
+
+bool TlsfAllocator::Allocate( uint64_t size, uint64_t alignment, Range& range )
+{
+	if( size == 0 )
+		size = 1;
+	if( alignment == 0 )
+		alignment = 1;
+
+	// minta sedikit lebih besar supaya offset apapun di block tsb bisa di-align
+	const uint64_t searchSize = size + alignment - 1;
+	if( searchSize > capacity )
+		return false;
+
+	uint32_t fl, sl;
+	MappingSearch( searchSize, fl, sl );
+	const uint32_t node = FindFree( fl, sl );
+	if( node == InvalidHandle )
+		return false;
+
+	RemoveFree( node );
+
+	// Potong bagian depan (padding alignment) jadi region free sendiri
+	// ----------------------------------------------------------------
+	const uint64_t alignedOffset = AlignUp( nodes[node].offset, alignment );
+	const uint64_t padding = alignedOffset - nodes[node].offset;
+	if( padding > 0 )
+	{
+		const uint32_t front = NewNode();
+		nodes[front] = { nodes[node].offset, padding, nodes[node].prevPhys, node, InvalidHandle, InvalidHandle, true };
+		if( nodes[front].prevPhys != InvalidHandle )
+			nodes[nodes[front].prevPhys].nextPhys = front;
+		nodes[node].prevPhys = front;
+		nodes[node].offset = alignedOffset;
+		nodes[node].size -= padding;
+		InsertFree( front );
+	}
+	// ----------------------------------------------------------------
+
+	// Sisa di belakang dikembalikan ke free list
+	// ------------------------------------------
+	if( nodes[node].size > size )
+	{
+		const uint32_t back = NewNode();
+		nodes[back] = { alignedOffset + size, nodes[node].size - size, node, nodes[node].nextPhys, InvalidHandle, InvalidHandle, true };
+		if( nodes[back].nextPhys != InvalidHandle )
+			nodes[nodes[back].nextPhys].prevPhys = back;
+		nodes[node].nextPhys = back;
+		nodes[node].size = size;
+		InsertFree( back );
+	}
+	// ------------------------------------------
+
+	nodes[node].free = false;
+	usedBytes += size;
+	++allocationCount;
+
+	range.offset = alignedOffset;
+	range.size = size;
+	range.handle = node;
+	return true;
+}
+
+void TlsfAllocator::Free( uint32_t handle )
+{
+	uint32_t node = handle;
+	usedBytes -= nodes[node].size;
+	--allocationCount;
+	nodes[node].free = true;
+
+	// gabung dengan tetangga fisik yang free (region free tidak pernah bersebelahan)
+	// ----------------------------------------------------------------------------
+	const uint32_t prev = nodes[node].prevPhys;
+	if( prev != InvalidHandle && nodes[prev].free )
+	{
+		RemoveFree( prev );
+		nodes[prev].size += nodes[node].size;
+		nodes[prev].nextPhys = nodes[node].nextPhys;
+		if( nodes[node].nextPhys != InvalidHandle )
+			nodes[nodes[node].nextPhys].prevPhys = prev;
+		ReleaseNode( node );
+		node = prev;
+	}
+
+	const uint32_t next = nodes[node].nextPhys;
+	if( next != InvalidHandle && nodes[next].free )
+	{
+		RemoveFree( next );
+		nodes[node].size += nodes[next].size;
+		nodes[node].nextPhys = nodes[next].nextPhys;
+		if( nodes[next].nextPhys != InvalidHandle )
+			nodes[nodes[next].nextPhys].prevPhys = node;
+		ReleaseNode( next );
+	}
+	// ----------------------------------------------------------------------------
+
+	InsertFree( node );
+}
+
+uint64_t TlsfAllocator::LargestFreeRegion() const
+{
+	if( flBitmap == 0 )
+		return 0;
+
+	// region terbesar pasti ada di bucket tertinggi yang tidak kosong
+	const uint32_t fl = MostSignificantBit( flBitmap );
+	const uint32_t sl = MostSignificantBit( slBitmap[fl] );
+
+	uint64_t largest = 0;
+	for( uint32_t node = freeHeads[fl][sl]; node != InvalidHandle; node = nodes[node].nextFree )
+		largest = std::max( largest, nodes[node].size );
+	return largest;
+}
+
+bool TlsfAllocator::Validate() const
+{
+	std::vector<bool> unused( nodes.size(), false );
+	for( uint32_t node : unusedNodes )
+		unused[node] = true;
+
+	uint32_t first = InvalidHandle;
+	for( uint32_t i = 0; i < nodes.size(); ++i )
+	{
+		if( !unused[i] && nodes[i].prevPhys == InvalidHandle )
+		{
+			if( first != InvalidHandle )
+				return false;	// dua kepala list fisik
+			first = i;
+		}
+	}
+	if( first == InvalidHandle )
+		return false;
+
+	uint64_t expectedOffset = 0;
+	uint64_t used = 0;
+	uint32_t freeCount = 0;
+	uint32_t allocCount = 0;
+	bool prevFree = false;
+	for( uint32_t node = first; node != InvalidHandle; node = nodes[node].nextPhys )
+	{
+		const Node& n = nodes[node];
+		if( n.offset != expectedOffset || n.size == 0 )
+			return false;
+		if( n.nextPhys != InvalidHandle && nodes[n.nextPhys].prevPhys != node )
+			return false;
+		if( n.free && prevFree )
+			return false;	// harusnya sudah di-merge
+		if( n.free )
+		{
+			uint32_t fl, sl;
+			MappingInsert( n.size, fl, sl );
+			bool listed = false;
+			for( uint32_t f = freeHeads[fl][sl]; f != InvalidHandle; f = nodes[f].nextFree )
+				listed |= f == node;
+			if( !listed )
+				return false;
+			++freeCount;
+		}
+		else
+		{
+			used += n.size;
+			++allocCount;
+		}
+		prevFree = n.free;
+		expectedOffset += n.size;
+	}
+
+	return expectedOffset == capacity && used == usedBytes && allocCount == allocationCount && freeCount == freeRegionCount;
+}
+
+void TlsfAllocator::MappingInsert( uint64_t size, uint32_t& fl, uint32_t& sl )
+{
+	if( size < SmallSize )
+	{
+		fl = 0;
+		sl = static_cast<uint32_t>( size );
+	}
+	else
+	{
+		const uint32_t msb = MostSignificantBit( size );
+		sl = static_cast<uint32_t>( size >> ( msb - SlBits ) ) ^ SlCount;
+		fl = msb - SlBits + 1;
+	}
+}
+
+void TlsfAllocator::MappingSearch( uint64_t size, uint32_t& fl, uint32_t& sl )
+{
+	// bulatkan ke atas ke kelas berikutnya, jadi block apapun di bucket hasil pasti cukup
+	if( size >= SmallSize )
+		size += ( 1ULL << ( MostSignificantBit( size ) - SlBits ) ) - 1;
+	MappingInsert( size, fl, sl );
+}
+
+uint32_t TlsfAllocator::FindFree( uint32_t fl, uint32_t sl ) const
+{
+	if( fl >= FlCount )
+		return InvalidHandle;
+
+	uint32_t slMap = slBitmap[fl] & ( ~0U << sl );
+	if( slMap == 0 )
+	{
+		const uint64_t flMap = fl + 1 < 64 ? flBitmap & ( ~0ULL << ( fl + 1 ) ) : 0;
+		if( flMap == 0 )
+			return InvalidHandle;
+		fl = LeastSignificantBit( flMap );
+		slMap = slBitmap[fl];
+	}
+	sl = LeastSignificantBit( slMap );
+	return freeHeads[fl][sl];
+}
+
+void TlsfAllocator::InsertFree( uint32_t node )
+{
+	uint32_t fl, sl;
+	MappingInsert( nodes[node].size, fl, sl );
+
+	nodes[node].free = true;
+	nodes[node].prevFree = InvalidHandle;
+	nodes[node].nextFree = freeHeads[fl][sl];
+	if( freeHeads[fl][sl] != InvalidHandle )
+		nodes[freeHeads[fl][sl]].prevFree = node;
+	freeHeads[fl][sl] = node;
+
+	flBitmap |= 1ULL << fl;
+	slBitmap[fl] |= 1U << sl;
+	++freeRegionCount;
+}
+
+void TlsfAllocator::RemoveFree( uint32_t node )
+{
+	uint32_t fl, sl;
+	MappingInsert( nodes[node].size, fl, sl );
+
+	if( nodes[node].prevFree != InvalidHandle )
+		nodes[nodes[node].prevFree].nextFree = nodes[node].nextFree;
+	else
+		freeHeads[fl][sl] = nodes[node].nextFree;
+	if( nodes[node].nextFree != InvalidHandle )
+		nodes[nodes[node].nextFree].prevFree = nodes[node].prevFree;
+
+	if( freeHeads[fl][sl] == InvalidHandle )
+	{
+		slBitmap[fl] &= ~( 1U << sl );
+		if( slBitmap[fl] == 0 )
+			flBitmap &= ~( 1ULL << fl );
+	}
+	--freeRegionCount;
+}
+
+uint32_t TlsfAllocator::NewNode()
+{
+	if( !unusedNodes.empty() )
+	{
+		const uint32_t node = unusedNodes.back();
+		unusedNodes.pop_back();
+		return node;
+	}
+	nodes.push_back( {} );
+	return static_cast<uint32_t>( nodes.size() - 1 );
+}
+
+void TlsfAllocator::ReleaseNode( uint32_t node )
+{
+	nodes[node].prevPhys = InvalidHandle;
+	nodes[node].nextPhys = InvalidHandle;
+	unusedNodes.push_back( node );
+}
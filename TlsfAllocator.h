@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Two-Level Segregated Fit, cuma ngurus offset (metadata di luar memory yang di-manage),
+// jadi bisa dipakai buat sub-alokasi VkDeviceMemory. Allocate/Free O(1).
+class TlsfAllocator
+{
+public:
+	static constexpr uint32_t InvalidHandle = ~0U;
+
+	struct Range
+	{
+		uint64_t offset;
+		uint64_t size;
+		uint32_t handle;	// dipakai buat Free()
+	};
+
+public:
+	void Init( uint64_t capacity );
+
+	bool Allocate( uint64_t size, uint64_t alignment, Range& range );
+	void Free( uint32_t handle );
+
+	uint64_t Capacity() const { return capacity; }
+	uint64_t UsedBytes() const { return usedBytes; }
+	uint64_t FreeBytes() const { return capacity - usedBytes; }
+	uint32_t AllocationCount() const { return allocationCount; }
+	uint32_t FreeRegionCount() const { return freeRegionCount; }
+	uint64_t LargestFreeRegion() const;
+	bool IsEmpty() const { return allocationCount == 0; }
+
+	// cek konsistensi list fisik dan free list (buat stress test)
+	bool Validate() const;
+
+private:
+	static constexpr uint32_t SlBits = 5;
+	static constexpr uint32_t SlCount = 1U << SlBits;
+	static constexpr uint32_t FlCount = 64 - SlBits + 1;
+	static constexpr uint64_t SmallSize = 1ULL << SlBits;
+
+	struct Node
+	{
+		uint64_t offset;
+		uint64_t size;
+		uint32_t prevPhys;
+		uint32_t nextPhys;
+		uint32_t prevFree;
+		uint32_t nextFree;
+		bool free;
+	};
+
+	static void MappingInsert( uint64_t size, uint32_t& fl, uint32_t& sl );
+	static void MappingSearch( uint64_t size, uint32_t& fl, uint32_t& sl );
+	uint32_t FindFree( uint32_t fl, uint32_t sl ) const;
+	void InsertFree( uint32_t node );
+	void RemoveFree( uint32_t node );
+	uint32_t NewNode();
+	void ReleaseNode( uint32_t node );
+
+private:
+	uint64_t capacity = 0;
+	uint64_t usedBytes = 0;
+	uint32_t allocationCount = 0;
+	uint32_t freeRegionCount = 0;
+
+	std::vector<Node> nodes;
+	std::vector<uint32_t> unusedNodes;
+
+	uint64_t flBitmap = 0;
+	uint32_t slBitmap[FlCount] = {};
+	uint32_t freeHeads[FlCount][SlCount];
+};
@@ -0,0 +1,342 @@
+// Tool offline: Wavefront .obj -> .mesh (lihat MeshFormat.h)
+// make MeshConverter
+// ./MeshConverter model.obj model.mesh [--no-quantize] [--no-optimize] [--lod-levels N] [--lod-error E]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MeshFormat.h"
+#include "MeshOptimizer.h"
+
+namespace
+{
+	struct ObjMesh
+	{
+	public:
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		bool hasNormals = true;
+	};
+
+	// index obj mulai dari 1, negatif = relatif dari elemen terakhir, 0 = tidak ada
+	int32_t ResolveObjIndex( long index, size_t count, const std::string& path, size_t line )
+	{
+		if( index == 0 )
+			return -1;
+		const long resolved = index > 0 ? index - 1 : static_cast<long>( count ) + index;
+		if( resolved < 0 || resolved >= static_cast<long>( count ) )
+			throw std::runtime_error( path + ":" + std::to_string( line ) + ": face index out of range" );
+		return static_cast<int32_t>( resolved );
+	}
+
+	// v, vt, vn, f (polygon di-triangulasi sebagai fan). Vertex dengan kombinasi v/vt/vn yang sama digabung.
+	ObjMesh LoadObj( const std::string& path )
+	{
+		std::ifstream file( path );
+		if( !file )
+			throw std::runtime_error( "Failed to open " + path );
+
+		std::vector<float> positions;
+		std::vector<float> uvs;
+		std::vector<float> normals;
+		ObjMesh mesh;
+		std::unordered_map<uint64_t, uint32_t> vertexLookup;
+		bool missingNormal = false;
+
+		std::string line;
+		std::vector<uint32_t> polygon;
+		for( size_t lineNumber = 1; std::getline( file, line ); ++lineNumber )
+		{
+			std::istringstream in( line );
+			std::string keyword;
+			in >> keyword;
+
+			if( keyword == "v" )
+			{
+				float x = 0.0f, y = 0.0f, z = 0.0f;
+				in >> x >> y >> z;
+				positions.insert( positions.end(), { x, y, z } );
+			}
+			else if( keyword == "vt" )
+			{
+				float u = 0.0f, v = 0.0f;
+				in >> u >> v;
+				// obj: v ke atas, Vulkan: v ke bawah
+				uvs.insert( uvs.end(), { u, 1.0f - v } );
+			}
+			else if( keyword == "vn" )
+			{
+				float x = 0.0f, y = 0.0f, z = 0.0f;
+				in >> x >> y >> z;
+				normals.insert( normals.end(), { x, y, z } );
+			}
+			else if( keyword == "f" )
+			{
+				polygon.clear();
+				std::string corner;
+				while( in >> corner )
+				{
+					// v, v/vt, v//vn, v/vt/vn
+					long parts[3] = { 0, 0, 0 };
+					const char* cursor = corner.c_str();
+					for( int part = 0; part < 3 && *cursor != '\0'; ++part )
+					{
+						if( *cursor != '/' )
+							parts[part] = std::strtol( cursor, const_cast<char**>( &cursor ), 10 );
+						if( *cursor == '/' )
+							++cursor;
+					}
+
+					const int32_t p = ResolveObjIndex( parts[0], positions.size() / 3, path, lineNumber );
+					const int32_t t = ResolveObjIndex( parts[1], uvs.size() / 2, path, lineNumber );
+					const int32_t n = ResolveObjIndex( parts[2], normals.size() / 3, path, lineNumber );
+					if( p < 0 )
+						throw std::runtime_error( path + ":" + std::to_string( lineNumber ) + ": face corner without position" );
+					missingNormal = missingNormal || n < 0;
+
+					// key 21 bit per komponen (+1 supaya -1 = 0)
+					if( p >= ( 1 << 21 ) || t + 1 >= ( 1 << 21 ) || n + 1 >= ( 1 << 21 ) )
+						throw std::runtime_error( path + ": too many vertices (max 2M positions / uvs / normals)" );
+					const uint64_t key = ( static_cast<uint64_t>( p ) << 42 ) | ( static_cast<uint64_t>( t + 1 ) << 21 ) | static_cast<uint64_t>( n + 1 );
+					auto found = vertexLookup.find( key );
+					if( found == vertexLookup.end() )
+					{
+						MeshVertex vertex{};
+						std::memcpy( vertex.position, &positions[p * 3], sizeof( vertex.position ) );
+						if( t >= 0 )
+							std::memcpy( vertex.uv, &uvs[t * 2], sizeof( vertex.uv ) );
+						if( n >= 0 )
+							std::memcpy( vertex.normal, &normals[n * 3], sizeof( vertex.normal ) );
+						found = vertexLookup.emplace( key, static_cast<uint32_t>( mesh.vertices.size() ) ).first;
+						mesh.vertices.push_back( vertex );
+					}
+					polygon.push_back( found->second );
+				}
+
+				for( size_t i = 2; i < polygon.size(); ++i )
+					mesh.indices.insert( mesh.indices.end(), { polygon[0], polygon[i - 1], polygon[i] } );
+			}
+		}
+
+		mesh.hasNormals = !missingNormal;
+		return mesh;
+	}
+
+	// normal per vertex dari rata-rata normal segitiga (dibobot luas), kalau obj nya tidak punya vn
+	void GenerateNormals( ObjMesh& mesh )
+	{
+		for( auto& vertex : mesh.vertices )
+			vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
+
+		for( size_t i = 0; i + 2 < mesh.indices.size(); i += 3 )
+		{
+			MeshVertex* v[3] = { &mesh.vertices[mesh.indices[i]], &mesh.vertices[mesh.indices[i + 1]], &mesh.vertices[mesh.indices[i + 2]] };
+			float e1[3], e2[3];
+			for( int k = 0; k < 3; ++k )
+			{
+				e1[k] = v[1]->position[k] - v[0]->position[k];
+				e2[k] = v[2]->position[k] - v[0]->position[k];
+			}
+			const float cross[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			for( MeshVertex* vertex : v )
+				for( int k = 0; k < 3; ++k )
+					vertex->normal[k] += cross[k];
+		}
+
+		for( auto& vertex : mesh.vertices )
+		{
+			const float length = std::sqrt( vertex.normal[0] * vertex.normal[0] + vertex.normal[1] * vertex.normal[1] + vertex.normal[2] * vertex.normal[2] );
+			for( int k = 0; k < 3; ++k )
+				vertex.normal[k] = length > 0.0f ? vertex.normal[k] / length : ( k == 2 ? 1.0f : 0.0f );
+		}
+	}
+
+	uint64_t Align( uint64_t value )
+	{
+		return ( value + MeshFileAlignment - 1 ) & ~( MeshFileAlignment - 1 );
+	}
+
+	void WritePadding( std::ofstream& out, uint64_t offset )
+	{
+		static const char zeros[MeshFileAlignment] = {};
+		const uint64_t current = static_cast<uint64_t>( out.tellp() );
+		out.write( zeros, static_cast<std::streamsize>( offset - current ) );
+	}
+
+	void Usage()
+	{
+		std::cerr << "usage: MeshConverter input.obj output.mesh [--no-quantize] [--no-optimize] [--lod-levels N] [--lod-error E]" << std::endl;
+	}
+}
+
+int main( int argc, char** argv )
+{
+	std::string inputPath;
+	std::string outputPath;
+	bool quantize = true;
+	bool optimize = true;
+	uint32_t lodLevels = 4;
+	float lodError = 0.05f;		// relatif ke sisi terpanjang bounds
+	for( int i = 1; i < argc; ++i )
+	{
+		if( std::strcmp( argv[i], "--no-quantize" ) == 0 )
+			quantize = false;
+		else if( std::strcmp( argv[i], "--no-optimize" ) == 0 )
+			optimize = false;
+		else if( std::strcmp( argv[i], "--lod-levels" ) == 0 && i + 1 < argc )
+			lodLevels = static_cast<uint32_t>( std::clamp( std::atoi( argv[++i] ), 1, 5 ) );
+		else if( std::strcmp( argv[i], "--lod-error" ) == 0 && i + 1 < argc )
+			lodError = std::max( 0.0f, static_cast<float>( std::atof( argv[++i] ) ) );
+		else if( inputPath.empty() )
+			inputPath = argv[i];
+		else if( outputPath.empty() )
+			outputPath = argv[i];
+		else
+		{
+			Usage();
+			return EXIT_FAILURE;
+		}
+	}
+	if( outputPath.empty() )
+	{
+		Usage();
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		const auto parseStart = std::chrono::steady_clock::now();
+		ObjMesh mesh = LoadObj( inputPath );
+		const std::chrono::duration<double, std::milli> parseTime = std::chrono::steady_clock::now() - parseStart;
+		if( mesh.indices.empty() )
+			throw std::runtime_error( inputPath + " has no faces" );
+		if( !mesh.hasNormals )
+			GenerateNormals( mesh );
+
+		std::cout << inputPath << ": " << mesh.vertices.size() << " vertices, " << mesh.indices.size() / 3 << " triangles, text parse "
+			<< parseTime.count() << " ms" << std::endl;
+
+		MeshFileHeader header;
+		MeshOptimizer::ComputeBounds( mesh.vertices, header.boundsMin, header.boundsMax );
+
+		// LOD: tiap level disederhanakan dari level sebelumnya sampai ~setengah segitiga nya.
+		// Error nya dijumlah, berhenti kalau total error melewati --lod-error atau segitiga nya tidak berkurang lagi.
+		// ------------------------------------------------------------------------------------------------------------
+		std::vector<std::vector<uint32_t>> lodIndices = { mesh.indices };
+		std::vector<float> lodErrors = { 0.0f };
+		{
+			float extent = 0.0f;
+			for( int i = 0; i < 3; ++i )
+				extent = std::max( extent, header.boundsMax[i] - header.boundsMin[i] );
+			const float maxError = lodError * extent;
+
+			const auto simplifyStart = std::chrono::steady_clock::now();
+			while( lodIndices.size() < lodLevels )
+			{
+				const std::vector<uint32_t>& previous = lodIndices.back();
+				const size_t target = previous.size() / 6 * 3;
+				float error = 0.0f;
+				std::vector<uint32_t> simplified = MeshOptimizer::Simplify( mesh.vertices, previous, target, maxError - lodErrors.back(), error );
+				if( simplified.empty() || simplified.size() * 10 > previous.size() * 9 )
+					break;
+				lodErrors.push_back( lodErrors.back() + error );
+				lodIndices.push_back( std::move( simplified ) );
+			}
+			const std::chrono::duration<double, std::milli> simplifyTime = std::chrono::steady_clock::now() - simplifyStart;
+
+			for( size_t level = 0; level < lodIndices.size(); ++level )
+			{
+				std::cout << "LOD " << level << ": " << lodIndices[level].size() / 3 << " triangles, error " << lodErrors[level]
+					<< " (" << ( extent > 0.0f ? lodErrors[level] / extent * 100.0f : 0.0f ) << "% of extent)" << std::endl;
+			}
+			std::cout << "simplification " << simplifyTime.count() << " ms" << std::endl;
+		}
+		// ------------------------------------------------------------------------------------------------------------
+
+		// Urutan segitiga dulu (vertex cache, per LOD), baru vertex nya mengikuti urutan index (fetch).
+		// LOD 0 di depan, jadi vertex yang dipakai LOD kasar (subset LOD 0) tetap berurutan di awal buffer.
+		// ------------------------------------------------------------------------------------
+		if( optimize )
+		{
+			const float acmrBefore = MeshOptimizer::AverageCacheMissRatio( lodIndices[0], mesh.vertices.size() );
+			for( auto& indices : lodIndices )
+				MeshOptimizer::OptimizeVertexCache( indices, mesh.vertices.size() );
+			const float acmrAfter = MeshOptimizer::AverageCacheMissRatio( lodIndices[0], mesh.vertices.size() );
+			std::cout << "vertex cache (32 entry FIFO): LOD 0 ACMR " << acmrBefore << " -> " << acmrAfter << std::endl;
+		}
+
+		std::vector<MeshLod> lods( lodIndices.size() );
+		mesh.indices.clear();
+		for( size_t level = 0; level < lodIndices.size(); ++level )
+		{
+			lods[level].firstIndex = static_cast<uint32_t>( mesh.indices.size() );
+			lods[level].indexCount = static_cast<uint32_t>( lodIndices[level].size() );
+			lods[level].error = lodErrors[level];
+			mesh.indices.insert( mesh.indices.end(), lodIndices[level].begin(), lodIndices[level].end() );
+		}
+		if( optimize )
+			MeshOptimizer::OptimizeVertexFetch( mesh.vertices, mesh.indices );
+		// ------------------------------------------------------------------------------------
+
+		header.vertexCount = static_cast<uint32_t>( mesh.vertices.size() );
+		header.indexCount = static_cast<uint32_t>( mesh.indices.size() );
+		header.lodCount = static_cast<uint32_t>( lods.size() );
+		header.indexSize = mesh.vertices.size() <= 65536 ? 2 : 4;
+		header.flags = quantize ? static_cast<uint32_t>( MeshFileQuantized ) : 0;
+		header.vertexStride = quantize ? sizeof( QuantizedMeshVertex ) : sizeof( MeshVertex );
+
+		const uint64_t vertexBytes = static_cast<uint64_t>( header.vertexCount ) * header.vertexStride;
+		const uint64_t indexBytes = static_cast<uint64_t>( header.indexCount ) * header.indexSize;
+		header.vertexOffset = Align( sizeof( MeshFileHeader ) + lods.size() * sizeof( MeshLod ) );
+		header.indexOffset = Align( header.vertexOffset + vertexBytes );
+		header.fileSize = header.indexOffset + indexBytes;
+
+		std::ofstream out( outputPath, std::ios::binary | std::ios::trunc );
+		if( !out )
+			throw std::runtime_error( "Failed to create " + outputPath );
+		out.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+		out.write( reinterpret_cast<const char*>( lods.data() ), static_cast<std::streamsize>( lods.size() * sizeof( MeshLod ) ) );
+
+		WritePadding( out, header.vertexOffset );
+		if( quantize )
+		{
+			const auto quantized = MeshOptimizer::Quantize( mesh.vertices, header.boundsMin, header.boundsMax );
+			out.write( reinterpret_cast<const char*>( quantized.data() ), static_cast<std::streamsize>( vertexBytes ) );
+		}
+		else
+			out.write( reinterpret_cast<const char*>( mesh.vertices.data() ), static_cast<std::streamsize>( vertexBytes ) );
+
+		WritePadding( out, header.indexOffset );
+		if( header.indexSize == 2 )
+		{
+			const std::vector<uint16_t> indices16( mesh.indices.begin(), mesh.indices.end() );
+			out.write( reinterpret_cast<const char*>( indices16.data() ), static_cast<std::streamsize>( indexBytes ) );
+		}
+		else
+			out.write( reinterpret_cast<const char*>( mesh.indices.data() ), static_cast<std::streamsize>( indexBytes ) );
+
+		if( !out )
+			throw std::runtime_error( "Failed to write " + outputPath );
+
+		const uint64_t unquantizedBytes = static_cast<uint64_t>( header.vertexCount ) * sizeof( MeshVertex );
+		std::cout << "vertex buffer " << header.vertexStride << " B/vertex = " << vertexBytes / 1024 << " KiB (unquantized "
+			<< sizeof( MeshVertex ) << " B/vertex = " << unquantizedBytes / 1024 << " KiB), index buffer " << indexBytes / 1024
+			<< " KiB (" << header.indexSize * 8 << "-bit)" << std::endl;
+		std::cout << "wrote " << outputPath << " (" << header.fileSize / 1024 << " KiB)" << std::endl;
+	}
+	catch( const std::exception& e )
+	{
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
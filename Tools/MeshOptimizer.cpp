@@ -0,0 +1,487 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace
+{
+	// parameter dari paper Forsyth, cache nya dimodelkan LRU 32 entry
+	constexpr uint32_t CacheSize = 32;
+	constexpr float CacheDecayPower = 1.5f;
+	constexpr float LastTriangleScore = 0.75f;
+	constexpr float ValenceBoostScale = 2.0f;
+	constexpr float ValenceBoostPower = 0.5f;
+
+	float VertexScore( int32_t cachePosition, uint32_t remainingValence )
+	{
+		// tidak dipakai lagi oleh segitiga yang tersisa
+		if( remainingValence == 0 )
+			return -1.0f;
+
+		float score = 0.0f;
+		if( cachePosition >= 0 )
+		{
+			// 3 vertex segitiga terakhir sengaja dapat score tetap, supaya hasilnya tidak jadi strip panjang
+			if( cachePosition < 3 )
+				score = LastTriangleScore;
+			else
+				score = std::pow( 1.0f - static_cast<float>( cachePosition - 3 ) / static_cast<float>( CacheSize - 3 ), CacheDecayPower );
+		}
+		// vertex yang tinggal sedikit segitiganya didahulukan, supaya tidak tertinggal sendirian
+		return score + ValenceBoostScale * std::pow( static_cast<float>( remainingValence ), -ValenceBoostPower );
+	}
+}
+
+void MeshOptimizer::OptimizeVertexCache( std::vector<uint32_t>& indices, size_t vertexCount )
+{
+	const size_t triangleCount = indices.size() / 3;
+	if( triangleCount == 0 )
+		return;
+
+	// Adjacency: segitiga yang belum di-emit per vertex, valence = jumlahnya
+	// ---------------------------------------------------------------------
+	std::vector<uint32_t> valence( vertexCount, 0 );
+	for( uint32_t index : indices )
+		++valence[index];
+
+	std::vector<uint32_t> adjacencyOffset( vertexCount + 1, 0 );
+	for( size_t v = 0; v < vertexCount; ++v )
+		adjacencyOffset[v + 1] = adjacencyOffset[v] + valence[v];
+
+	std::vector<uint32_t> adjacency( indices.size() );
+	{
+		std::vector<uint32_t> fill( adjacencyOffset.begin(), adjacencyOffset.end() - 1 );
+		for( size_t i = 0; i < indices.size(); ++i )
+			adjacency[fill[indices[i]]++] = static_cast<uint32_t>( i / 3 );
+	}
+	// ---------------------------------------------------------------------
+
+	std::vector<int32_t> cachePosition( vertexCount, -1 );
+	std::vector<float> vertexScore( vertexCount );
+	for( size_t v = 0; v < vertexCount; ++v )
+		vertexScore[v] = VertexScore( -1, valence[v] );
+
+	std::vector<float> triangleScore( triangleCount );
+	for( size_t t = 0; t < triangleCount; ++t )
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+	std::vector<bool> emitted( triangleCount, false );
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> newCache;
+	std::vector<uint32_t> output;
+	output.reserve( indices.size() );
+	size_t scanCursor = 0;
+	int64_t best = -1;
+
+	for( size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount )
+	{
+		// tidak ada kandidat di cache: lanjut dari segitiga pertama yang belum di-emit
+		if( best < 0 )
+		{
+			while( emitted[scanCursor] )
+				++scanCursor;
+			best = static_cast<int64_t>( scanCursor );
+		}
+
+		const uint32_t triangle[3] = { indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2] };
+		emitted[best] = true;
+		output.insert( output.end(), triangle, triangle + 3 );
+
+		for( uint32_t v : triangle )
+		{
+			uint32_t* begin = &adjacency[adjacencyOffset[v]];
+			uint32_t* end = begin + valence[v];
+			std::iter_swap( std::find( begin, end, static_cast<uint32_t>( best ) ), end - 1 );
+			--valence[v];
+		}
+
+		// cache baru: vertex segitiga ini di depan, sisanya bergeser, yang lewat CacheSize keluar
+		newCache.assign( triangle, triangle + 3 );
+		for( uint32_t v : cache )
+		{
+			if( v != triangle[0] && v != triangle[1] && v != triangle[2] )
+				newCache.push_back( v );
+		}
+
+		// score vertex yang posisinya berubah, selisihnya diteruskan ke segitiga yang tersisa
+		for( size_t i = 0; i < newCache.size(); ++i )
+		{
+			const uint32_t v = newCache[i];
+			cachePosition[v] = i < CacheSize ? static_cast<int32_t>( i ) : -1;
+			const float score = VertexScore( cachePosition[v], valence[v] );
+			const float delta = score - vertexScore[v];
+			vertexScore[v] = score;
+			for( uint32_t a = 0; a < valence[v]; ++a )
+				triangleScore[adjacency[adjacencyOffset[v] + a]] += delta;
+		}
+		if( newCache.size() > CacheSize )
+			newCache.resize( CacheSize );
+		cache.swap( newCache );
+
+		// kandidat berikutnya cuma dari segitiga yang menyentuh cache
+		best = -1;
+		float bestScore = -std::numeric_limits<float>::max();
+		for( uint32_t v : cache )
+		{
+			for( uint32_t a = 0; a < valence[v]; ++a )
+			{
+				const uint32_t t = adjacency[adjacencyOffset[v] + a];
+				if( triangleScore[t] > bestScore )
+				{
+					bestScore = triangleScore[t];
+					best = t;
+				}
+			}
+		}
+	}
+
+	indices.swap( output );
+}
+
+namespace
+{
+	// plane quadric Garland-Heckbert, matrix 4x4 simetris: a00 a01 a02 a03 a11 a12 a13 a22 a23 a33
+	struct Quadric
+	{
+	public:
+		double a[10] = {};
+
+		void AddPlane( double nx, double ny, double nz, double d )
+		{
+			const double p[4] = { nx, ny, nz, d };
+			int k = 0;
+			for( int i = 0; i < 4; ++i )
+				for( int j = i; j < 4; ++j )
+					a[k++] += p[i] * p[j];
+		}
+		void Add( const Quadric& other )
+		{
+			for( int k = 0; k < 10; ++k )
+				a[k] += other.a[k];
+		}
+		// jumlah kuadrat jarak titik ke semua plane di quadric ini
+		double Evaluate( const float position[3] ) const
+		{
+			const double v[4] = { position[0], position[1], position[2], 1.0 };
+			double result = 0.0;
+			int k = 0;
+			for( int i = 0; i < 4; ++i )
+				for( int j = i; j < 4; ++j )
+					result += ( i == j ? 1.0 : 2.0 ) * a[k++] * v[i] * v[j];
+			return std::max( result, 0.0 );
+		}
+	};
+
+	void TriangleNormal( const float* p0, const float* p1, const float* p2, double normal[3] )
+	{
+		const double e1[3] = { double( p1[0] ) - p0[0], double( p1[1] ) - p0[1], double( p1[2] ) - p0[2] };
+		const double e2[3] = { double( p2[0] ) - p0[0], double( p2[1] ) - p0[1], double( p2[2] ) - p0[2] };
+		normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+		normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+		normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+	}
+}
+
+std::vector<uint32_t> MeshOptimizer::Simplify( const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+	size_t targetIndexCount, float maxError, float& resultError )
+{
+	const size_t vertexCount = vertices.size();
+	std::vector<uint32_t> result = indices;
+	double maxCost = 0.0;
+
+	// Edge yang cuma dipakai satu segitiga = tepi terbuka atau seam (vertex nya di-split karena uv/normal beda).
+	// Vertex nya dikunci, kalau tidak permukaan nya sobek.
+	// ---------------------------------------------------------------------------------------------------------
+	std::vector<bool> locked( vertexCount, false );
+	{
+		std::unordered_map<uint64_t, uint32_t> edgeUse;
+		for( size_t i = 0; i < result.size(); i += 3 )
+		{
+			for( int k = 0; k < 3; ++k )
+			{
+				const uint32_t a = result[i + k];
+				const uint32_t b = result[i + ( k + 1 ) % 3];
+				++edgeUse[( static_cast<uint64_t>( std::min( a, b ) ) << 32 ) | std::max( a, b )];
+			}
+		}
+		for( const auto& edge : edgeUse )
+		{
+			if( edge.second == 1 )
+			{
+				locked[edge.first >> 32] = true;
+				locked[edge.first & 0xffffffff] = true;
+			}
+		}
+	}
+	// ---------------------------------------------------------------------------------------------------------
+
+	// quadric tidak dibobot luas: Evaluate() = jumlah kuadrat jarak ke plane, sqrt nya >= jarak terjauh (batas atas error)
+	std::vector<Quadric> quadrics( vertexCount );
+	for( size_t i = 0; i < result.size(); i += 3 )
+	{
+		double normal[3];
+		TriangleNormal( vertices[result[i]].position, vertices[result[i + 1]].position, vertices[result[i + 2]].position, normal );
+		const double length = std::sqrt( normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2] );
+		if( length == 0.0 )
+			continue;
+		for( double& n : normal )
+			n /= length;
+		const float* p = vertices[result[i]].position;
+		const double d = -( normal[0] * p[0] + normal[1] * p[1] + normal[2] * p[2] );
+		for( int k = 0; k < 3; ++k )
+			quadrics[result[i + k]].AddPlane( normal[0], normal[1], normal[2], d );
+	}
+
+	struct Collapse
+	{
+		uint32_t from;
+		uint32_t to;
+		double cost;
+	};
+	std::vector<Collapse> collapses;
+	std::vector<uint32_t> adjacencyOffset;
+	std::vector<uint32_t> adjacency;
+	std::vector<uint32_t> collapseTo( vertexCount );
+	std::vector<bool> touched( vertexCount );
+	const double maxAllowedCost = static_cast<double>( maxError ) * maxError;
+
+	// Per pass: semua edge di-sort dari yang paling murah, lalu collapse yang tidak saling bersentuhan
+	while( result.size() > targetIndexCount )
+	{
+		collapses.clear();
+		for( size_t i = 0; i < result.size(); i += 3 )
+		{
+			for( int k = 0; k < 3; ++k )
+			{
+				const uint32_t a = result[i + k];
+				const uint32_t b = result[i + ( k + 1 ) % 3];
+				Quadric merged = quadrics[a];
+				merged.Add( quadrics[b] );
+				if( !locked[a] )
+					collapses.push_back( { a, b, merged.Evaluate( vertices[b].position ) } );
+				if( !locked[b] )
+					collapses.push_back( { b, a, merged.Evaluate( vertices[a].position ) } );
+			}
+		}
+		std::sort( collapses.begin(), collapses.end(), []( const Collapse& l, const Collapse& r ) { return l.cost < r.cost; } );
+
+		// vertex -> segitiga, buat cek segitiga yang terbalik setelah collapse
+		adjacencyOffset.assign( vertexCount + 1, 0 );
+		for( uint32_t index : result )
+			++adjacencyOffset[index + 1];
+		for( size_t v = 0; v < vertexCount; ++v )
+			adjacencyOffset[v + 1] += adjacencyOffset[v];
+		adjacency.resize( result.size() );
+		{
+			std::vector<uint32_t> fill( adjacencyOffset.begin(), adjacencyOffset.end() - 1 );
+			for( size_t i = 0; i < result.size(); ++i )
+				adjacency[fill[result[i]]++] = static_cast<uint32_t>( i / 3 );
+		}
+
+		for( size_t v = 0; v < vertexCount; ++v )
+			collapseTo[v] = static_cast<uint32_t>( v );
+		std::fill( touched.begin(), touched.end(), false );
+		const size_t trianglesToRemove = ( result.size() - targetIndexCount + 2 ) / 3;
+		size_t trianglesRemoved = 0;
+
+		for( const Collapse& collapse : collapses )
+		{
+			if( collapse.cost > maxAllowedCost || trianglesRemoved >= trianglesToRemove )
+				break;
+			if( touched[collapse.from] || touched[collapse.to] )
+				continue;
+
+			// segitiga di sekitar "from" yang tidak ikut hilang tidak boleh terbalik / jadi terlalu miring
+			bool flips = false;
+			size_t removed = 0;
+			for( uint32_t a = adjacencyOffset[collapse.from]; a < adjacencyOffset[collapse.from + 1] && !flips; ++a )
+			{
+				const uint32_t* triangle = &result[adjacency[a] * 3];
+				if( triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to )
+				{
+					++removed;
+					continue;
+				}
+				const float* before[3];
+				const float* after[3];
+				for( int k = 0; k < 3; ++k )
+				{
+					before[k] = vertices[triangle[k]].position;
+					after[k] = triangle[k] == collapse.from ? vertices[collapse.to].position : before[k];
+				}
+				double n0[3], n1[3];
+				TriangleNormal( before[0], before[1], before[2], n0 );
+				TriangleNormal( after[0], after[1], after[2], n1 );
+				const double dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+				const double length0 = std::sqrt( n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2] );
+				const double length1 = std::sqrt( n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2] );
+				// segitiga yang dari awal degenerate tidak punya arah, dilewati
+				flips = length0 > 0.0 && dot <= 0.25 * length0 * length1;
+			}
+			if( flips )
+				continue;
+
+			collapseTo[collapse.from] = collapse.to;
+			quadrics[collapse.to].Add( quadrics[collapse.from] );
+			maxCost = std::max( maxCost, collapse.cost );
+			trianglesRemoved += removed;
+
+			// segitiga di sekitar "from" sudah berubah, tetangga nya tidak boleh collapse lagi di pass ini
+			for( uint32_t a = adjacencyOffset[collapse.from]; a < adjacencyOffset[collapse.from + 1]; ++a )
+				for( int k = 0; k < 3; ++k )
+					touched[result[adjacency[a] * 3 + k]] = true;
+		}
+
+		if( trianglesRemoved == 0 )
+			break;
+
+		// tulis ulang index, segitiga yang dua vertex nya jadi sama dibuang
+		size_t write = 0;
+		for( size_t i = 0; i < result.size(); i += 3 )
+		{
+			const uint32_t a = collapseTo[result[i]];
+			const uint32_t b = collapseTo[result[i + 1]];
+			const uint32_t c = collapseTo[result[i + 2]];
+			if( a == b || b == c || a == c )
+				continue;
+			result[write++] = a;
+			result[write++] = b;
+			result[write++] = c;
+		}
+		result.resize( write );
+	}
+
+	resultError = static_cast<float>( std::sqrt( maxCost ) );
+	return result;
+}
+
+void MeshOptimizer::OptimizeVertexFetch( std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices )
+{
+	std::vector<uint32_t> remap( vertices.size(), std::numeric_limits<uint32_t>::max() );
+	std::vector<MeshVertex> reordered;
+	reordered.reserve( vertices.size() );
+
+	for( uint32_t& index : indices )
+	{
+		if( remap[index] == std::numeric_limits<uint32_t>::max() )
+		{
+			remap[index] = static_cast<uint32_t>( reordered.size() );
+			reordered.push_back( vertices[index] );
+		}
+		index = remap[index];
+	}
+	vertices.swap( reordered );
+}
+
+float MeshOptimizer::AverageCacheMissRatio( const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize )
+{
+	if( indices.size() < 3 )
+		return 0.0f;
+
+	// FIFO: vertex masih di cache kalau dimasukkan dalam cacheSize miss terakhir
+	std::vector<int64_t> insertedAt( vertexCount, std::numeric_limits<int64_t>::min() / 2 );
+	int64_t misses = 0;
+	for( uint32_t index : indices )
+	{
+		if( misses - insertedAt[index] >= cacheSize )
+			insertedAt[index] = misses++;
+	}
+	return static_cast<float>( misses ) / static_cast<float>( indices.size() / 3 );
+}
+
+void MeshOptimizer::ComputeBounds( const std::vector<MeshVertex>& vertices, float boundsMin[3], float boundsMax[3] )
+{
+	for( int i = 0; i < 3; ++i )
+	{
+		boundsMin[i] = vertices.empty() ? 0.0f : std::numeric_limits<float>::max();
+		boundsMax[i] = vertices.empty() ? 0.0f : -std::numeric_limits<float>::max();
+	}
+	for( const auto& vertex : vertices )
+	{
+		for( int i = 0; i < 3; ++i )
+		{
+			boundsMin[i] = std::min( boundsMin[i], vertex.position[i] );
+			boundsMax[i] = std::max( boundsMax[i], vertex.position[i] );
+		}
+	}
+}
+
+std::vector<QuantizedMeshVertex> MeshOptimizer::Quantize( const std::vector<MeshVertex>& vertices, const float boundsMin[3], const float boundsMax[3] )
+{
+	auto toUnorm16 = []( float value ) { return static_cast<uint16_t>( std::lround( std::clamp( value, 0.0f, 1.0f ) * 65535.0f ) ); };
+	auto toSnorm16 = []( float value ) { return static_cast<int16_t>( std::lround( std::clamp( value, -1.0f, 1.0f ) * 32767.0f ) ); };
+
+	std::vector<QuantizedMeshVertex> result( vertices.size() );
+	for( size_t v = 0; v < vertices.size(); ++v )
+	{
+		const MeshVertex& in = vertices[v];
+		QuantizedMeshVertex& out = result[v];
+
+		// posisi: 0..1 di dalam bounds (sumbu yang datar -> 0)
+		for( int i = 0; i < 3; ++i )
+		{
+			const float extent = boundsMax[i] - boundsMin[i];
+			out.position[i] = toUnorm16( extent > 0.0f ? ( in.position[i] - boundsMin[i] ) / extent : 0.0f );
+		}
+		out.position[3] = 0;
+
+		// normal: proyeksi octahedral, belahan z < 0 dilipat ke luar diamond
+		const float l1 = std::fabs( in.normal[0] ) + std::fabs( in.normal[1] ) + std::fabs( in.normal[2] );
+		float x = l1 > 0.0f ? in.normal[0] / l1 : 0.0f;
+		float y = l1 > 0.0f ? in.normal[1] / l1 : 0.0f;
+		if( l1 > 0.0f && in.normal[2] < 0.0f )
+		{
+			const float foldedX = ( 1.0f - std::fabs( y ) ) * ( x >= 0.0f ? 1.0f : -1.0f );
+			const float foldedY = ( 1.0f - std::fabs( x ) ) * ( y >= 0.0f ? 1.0f : -1.0f );
+			x = foldedX;
+			y = foldedY;
+		}
+		out.normal[0] = toSnorm16( x );
+		out.normal[1] = toSnorm16( y );
+
+		out.uv[0] = FloatToHalf( in.uv[0] );
+		out.uv[1] = FloatToHalf( in.uv[1] );
+	}
+	return result;
+}
+
+uint16_t MeshOptimizer::FloatToHalf( float value )
+{
+	uint32_t bits;
+	std::memcpy( &bits, &value, sizeof( bits ) );
+
+	const uint16_t sign = static_cast<uint16_t>( ( bits >> 16 ) & 0x8000 );
+	const uint32_t floatExponent = ( bits >> 23 ) & 0xff;
+	uint32_t mantissa = bits & 0x7fffff;
+
+	// inf / NaN
+	if( floatExponent == 0xff )
+		return sign | 0x7c00 | ( mantissa != 0 ? 0x200 : 0 );
+
+	const int32_t exponent = static_cast<int32_t>( floatExponent ) - 127 + 15;
+	if( exponent >= 31 )
+		return sign | 0x7c00;
+
+	// round to nearest even, carry dari mantissa boleh naik ke exponent
+	auto roundShift = []( uint32_t value, uint32_t shift )
+	{
+		uint32_t result = value >> shift;
+		const uint32_t remainder = value & ( ( 1u << shift ) - 1 );
+		const uint32_t halfway = 1u << ( shift - 1 );
+		if( remainder > halfway || ( remainder == halfway && ( result & 1 ) ) )
+			++result;
+		return result;
+	};
+
+	// denormal half (atau 0 kalau terlalu kecil)
+	if( exponent <= 0 )
+	{
+		if( exponent < -10 )
+			return sign;
+		mantissa |= 0x800000;
+		return sign | static_cast<uint16_t>( roundShift( mantissa, static_cast<uint32_t>( 14 - exponent ) ) );
+	}
+	return sign | static_cast<uint16_t>( roundShift( ( static_cast<uint32_t>( exponent ) << 23 ) | mantissa, 13 ) );
+}
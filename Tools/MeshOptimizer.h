@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MeshFormat.h"
+
+// Optimasi offline buat Tools/MeshConverter (tidak di-link ke VulkanTest)
+class MeshOptimizer
+{
+public:
+	// urutan segitiga untuk post-transform vertex cache (Forsyth, "Linear-speed vertex cache optimisation")
+	static void OptimizeVertexCache( std::vector<uint32_t>& indices, size_t vertexCount );
+	// vertex diurutkan sesuai pemakaian pertama di index buffer (fetch berurutan), vertex yang tidak dipakai dibuang
+	static void OptimizeVertexFetch( std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices );
+	// edge collapse (quadric error) sampai index nya <= targetIndexCount atau collapse berikutnya melewati maxError.
+	// Vertex tidak dibuat/dipindah (collapse ke vertex tetangga), jadi hasilnya tetap pakai vertex buffer yang sama.
+	// resultError = batas atas jarak permukaan hasil ke permukaan input (satuan posisi mesh).
+	static std::vector<uint32_t> Simplify( const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+		size_t targetIndexCount, float maxError, float& resultError );
+	// average cache miss ratio: vertex shader invocation per segitiga, simulasi FIFO cache
+	static float AverageCacheMissRatio( const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = 32 );
+
+	static void ComputeBounds( const std::vector<MeshVertex>& vertices, float boundsMin[3], float boundsMax[3] );
+	static std::vector<QuantizedMeshVertex> Quantize( const std::vector<MeshVertex>& vertices, const float boundsMin[3], const float boundsMax[3] );
+	static uint16_t FloatToHalf( float value );
+};
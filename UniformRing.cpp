@@ -0,0 +1,130 @@
+#include "UniformRing.h"
+#include <algorithm>
+#include <stdexcept>
+
+#include "HostAllocator.h"
+
+namespace
+{
+	VkDeviceSize AlignUp( VkDeviceSize value, VkDeviceSize alignment )
+	{
+		return ( value + alignment - 1 ) / alignment * alignment;
+	}
+}
+
+void UniformRing::Init( VkDevice device, const VkPhysicalDeviceLimits& limits, DeviceAllocator& allocator, uint32_t framesInFlight, VkDeviceSize bytesPerFrame )
+{
+	this->device = device;
+
+	// satu alignment untuk dua binding, slice yang sama boleh dibaca sebagai uniform maupun storage
+	alignment = std::max<VkDeviceSize>( { 16, limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment } );
+	this->bytesPerFrame = AlignUp( bytesPerFrame, alignment );
+	uniformRange = std::min<VkDeviceSize>( { limits.maxUniformBufferRange, 65536, this->bytesPerFrame } );
+	storageRange = std::min<VkDeviceSize>( limits.maxStorageBufferRange, this->bytesPerFrame );
+
+	// dynamic offset + range descriptor harus tetap di dalam buffer, jadi ada ekor seukuran range terbesar
+	const VkDeviceSize tailBytes = std::max( uniformRange, storageRange );
+	if( this->bytesPerFrame * framesInFlight + tailBytes > UINT32_MAX )
+		throw std::runtime_error( "Uniform ring is too large for 32-bit dynamic offsets" );
+	pool.Init( device, allocator, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, framesInFlight, this->bytesPerFrame, tailBytes );
+	const VkBuffer buffer = pool.GetBuffer();
+
+	// Descriptor set: dibuat dan ditulis sekali, offset per draw lewat vkCmdBindDescriptorSets
+	// ------------------------------------------------------------------------------------------
+	VkDescriptorSetLayoutBinding bindings[2]{};
+	bindings[0].binding = UniformBinding;
+	bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	bindings[0].descriptorCount = 1;
+	bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+	bindings[1].binding = StorageBinding;
+	bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+	bindings[1].descriptorCount = 1;
+	bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = 2;
+	layoutInfo.pBindings = bindings;
+	if( vkCreateDescriptorSetLayout( device, &layoutInfo, HostAllocator::Callbacks(), &layout ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create uniform ring descriptor set layout!" );
+
+	descriptors.Init( device, 1, { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 }, { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1 } } );
+	set = descriptors.Allocate( layout );
+
+	const VkDescriptorBufferInfo uniformInfo{ buffer, 0, uniformRange };
+	const VkDescriptorBufferInfo storageInfo{ buffer, 0, storageRange };
+	VkWriteDescriptorSet writes[2]{};
+	for( uint32_t i = 0; i < 2; ++i )
+	{
+		writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[i].dstSet = set;
+		writes[i].dstBinding = bindings[i].binding;
+		writes[i].descriptorCount = 1;
+		writes[i].descriptorType = bindings[i].descriptorType;
+	}
+	writes[0].pBufferInfo = &uniformInfo;
+	writes[1].pBufferInfo = &storageInfo;
+	vkUpdateDescriptorSets( device, 2, writes, 0, nullptr );
+	// ------------------------------------------------------------------------------------------
+
+	stats = UniformRingStats();
+	stats.bytesPerFrame = this->bytesPerFrame;
+}
+
+void UniformRing::CleanUp()
+{
+	descriptors.CleanUp();
+	vkDestroyDescriptorSetLayout( device, layout, HostAllocator::Callbacks() );
+	pool.CleanUp();
+}
+
+void UniformRing::BeginFrame( uint32_t frameIndex )
+{
+	// angka frame yang sebelumnya ditulis (region lain), baru region frame ini di-reset
+	const VkDeviceSize used = pool.FrameBytesUsed();
+	const uint64_t overflowCount = overflows.exchange( 0, std::memory_order_relaxed );
+	stats.lastFrameBytes = used;
+	stats.peakFrameBytes = std::max( stats.peakFrameBytes, used );
+	stats.lastFrameAllocations = allocations.exchange( 0, std::memory_order_relaxed );
+	stats.overflowEvents += overflowCount;
+	stats.framesWithOverflow += overflowCount > 0 ? 1 : 0;
+
+	pool.BeginFrame( frameIndex );
+}
+
+UniformSlice UniformRing::Allocate( VkDeviceSize size )
+{
+	const FrameAllocation allocation = pool.Allocate( std::max<VkDeviceSize>( size, 1 ), alignment );
+	if( allocation.mapped == nullptr )
+	{
+		overflows.fetch_add( 1, std::memory_order_relaxed );
+		return UniformSlice();
+	}
+	allocations.fetch_add( 1, std::memory_order_relaxed );
+
+	UniformSlice slice;
+	slice.offset = static_cast<uint32_t>( allocation.offset );
+	slice.data = allocation.mapped;
+	slice.size = size;
+	return slice;
+}
+
+void UniformRing::Bind( VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t firstSet,
+	uint32_t uniformOffset, uint32_t storageOffset ) const
+{
+	// urutan dynamic offset = urutan binding
+	const uint32_t offsets[] = { uniformOffset, storageOffset };
+	vkCmdBindDescriptorSets( commandBuffer, bindPoint, pipelineLayout, firstSet, 1, &set, 2, offsets );
+}
+
+UniformRingStats UniformRing::GetStats() const
+{
+	return stats;
+}
+
+void UniformRing::PrintStats( std::ostream& out ) const
+{
+	out << "uniform ring: " << stats.lastFrameBytes << " B written last frame (" << stats.lastFrameAllocations << " slices), peak "
+		<< stats.peakFrameBytes << " / " << stats.bytesPerFrame << " B per frame, " << stats.overflowEvents << " overflows in "
+		<< stats.framesWithOverflow << " frames" << std::endl;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+#include "DescriptorAllocator.h"
+#include "DeviceAllocator.h"
+
+struct UniformRingStats
+{
+	VkDeviceSize bytesPerFrame = 0;			// kapasitas satu region frame
+	VkDeviceSize lastFrameBytes = 0;		// ditulis di frame yang terakhir selesai di-reset
+	VkDeviceSize peakFrameBytes = 0;
+	uint64_t lastFrameAllocations = 0;
+	uint64_t overflowEvents = 0;			// Allocate() yang gagal karena region frame penuh
+	uint64_t framesWithOverflow = 0;
+};
+
+// Satu allocation di ring: ditulis langsung lewat data, di-bind dengan offset sebagai dynamic offset
+struct UniformSlice
+{
+public:
+	void* data = nullptr;					// nullptr = region frame penuh (overflow), draw nya dilewati caller
+	uint32_t offset = 0;
+	VkDeviceSize size = 0;
+};
+
+// Uniform / storage buffer per frame in flight, di atas LinearFramePool (satu VkBuffer HOST_VISIBLE | HOST_COHERENT
+// yang di-map terus, dibagi framesInFlight region). Caller bump-allocate slice (align minUniform/minStorageBufferOffsetAlignment),
+// tulis isinya langsung, lalu Bind() dengan dynamic offset: satu descriptor set untuk semua frame dan semua draw,
+// tidak ada vkUpdateDescriptorSets atau buffer per object. Region frame dipakai lagi di BeginFrame() frame itu
+// (setelah fence nya ditunggu, GPU sudah selesai membaca isinya).
+//   binding 0 = UNIFORM_BUFFER_DYNAMIC (range UniformRange())
+//   binding 1 = STORAGE_BUFFER_DYNAMIC (range StorageRange())
+class UniformRing
+{
+public:
+	static constexpr uint32_t UniformBinding = 0;
+	static constexpr uint32_t StorageBinding = 1;
+
+	void Init( VkDevice device, const VkPhysicalDeviceLimits& limits, DeviceAllocator& allocator, uint32_t framesInFlight, VkDeviceSize bytesPerFrame );
+	void CleanUp();
+
+	// setelah fence frame ini ditunggu
+	void BeginFrame( uint32_t frameIndex );
+	// aman dipanggil dari beberapa thread recording sekaligus (bump atomic)
+	UniformSlice Allocate( VkDeviceSize size );
+	template<typename T>
+	UniformSlice Push( const T& value )
+	{
+		UniformSlice slice = Allocate( sizeof( T ) );
+		if( slice.data != nullptr )
+			std::memcpy( slice.data, &value, sizeof( T ) );
+		return slice;
+	}
+
+	VkDescriptorSetLayout GetLayout() const { return layout; }
+	// offset = UniformSlice::offset untuk binding 0 dan 1 (slice yang tidak dipakai shader boleh 0)
+	void Bind( VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t firstSet,
+		uint32_t uniformOffset, uint32_t storageOffset = 0 ) const;
+
+	VkDeviceSize UniformRange() const { return uniformRange; }
+	VkDeviceSize StorageRange() const { return storageRange; }
+
+	UniformRingStats GetStats() const;
+	void PrintStats( std::ostream& out ) const;
+
+private:
+	VkDevice device = VK_NULL_HANDLE;
+	VkDeviceSize alignment = 256;
+	VkDeviceSize bytesPerFrame = 0;
+	VkDeviceSize uniformRange = 0;
+	VkDeviceSize storageRange = 0;
+
+	LinearFramePool pool;
+
+	VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+	DescriptorAllocator descriptors;
+	VkDescriptorSet set = VK_NULL_HANDLE;
+
+	std::atomic<uint64_t> allocations{ 0 };
+	std::atomic<uint64_t> overflows{ 0 };
+	UniformRingStats stats;
+};
@@ -0,0 +1,340 @@
+#include "UploadManager.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "HostAllocator.h"
+
+namespace
+{
+	uint64_t AlignUp( uint64_t value, uint64_t alignment )
+	{
+		return ( value + alignment - 1 ) / alignment * alignment;
+	}
+}
+
+void UploadManager::Init( VkDevice device, DeviceAllocator& allocator, GpuQueues& queues, VkDeviceSize ringSize )
+{
+	this->device = device;
+	this->allocator = &allocator;
+	this->queues = &queues;
+	this->ringSize = ringSize;
+
+	// Staging ring, host-visible dan di-map sekali oleh allocator
+	// -----------------------------------------------------------
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = ringSize;
+	bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	if( vkCreateBuffer( device, &bufferInfo, HostAllocator::Callbacks(), &ringBuffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create staging ring buffer!" );
+
+	ringAllocation = allocator.AllocateForBuffer( ringBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+	// -----------------------------------------------------------
+
+	VkCommandPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	poolInfo.queueFamilyIndex = queues.GetFamily( QueueType::Transfer );
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+	if( vkCreateCommandPool( device, &poolInfo, HostAllocator::Callbacks(), &commandPool ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create upload command pool!" );
+
+	VkSemaphoreCreateInfo semaphoreInfo{};
+	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	VkFenceCreateInfo fenceInfo{};
+	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+	for( auto& slot : slots )
+	{
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = commandPool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = 1;
+
+		if( vkAllocateCommandBuffers( device, &allocInfo, &slot.commandBuffer ) != VK_SUCCESS ||
+			vkCreateFence( device, &fenceInfo, HostAllocator::Callbacks(), &slot.fence ) != VK_SUCCESS ||
+			vkCreateSemaphore( device, &semaphoreInfo, HostAllocator::Callbacks(), &slot.semaphore ) != VK_SUCCESS )
+			throw std::runtime_error( "Failed to create upload batch objects!" );
+	}
+}
+
+void UploadManager::CleanUp()
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	while( !inFlightSlots.empty() )
+		Reclaim( true );
+
+	for( auto& slot : slots )
+	{
+		for( auto& staging : slot.oversized )
+		{
+			vkDestroyBuffer( device, staging.buffer, HostAllocator::Callbacks() );
+			allocator->Free( staging.allocation );
+		}
+		slot.oversized.clear();
+		vkDestroySemaphore( device, slot.semaphore, HostAllocator::Callbacks() );
+		vkDestroyFence( device, slot.fence, HostAllocator::Callbacks() );
+	}
+	vkDestroyCommandPool( device, commandPool, HostAllocator::Callbacks() );
+
+	vkDestroyBuffer( device, ringBuffer, HostAllocator::Callbacks() );
+	allocator->Free( ringAllocation );
+}
+
+void UploadManager::UploadBuffer( VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size,
+	VkPipelineStageFlags dstStage, VkAccessFlags dstAccess )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	VkCommandBuffer commandBuffer = OpenBatch();
+
+	VkBuffer srcBuffer;
+	VkDeviceSize srcOffset;
+	std::memcpy( Stage( size, 16, srcBuffer, srcOffset ), data, static_cast<size_t>( size ) );
+
+	VkBufferCopy region{};
+	region.srcOffset = srcOffset;
+	region.dstOffset = dstOffset;
+	region.size = size;
+	vkCmdCopyBuffer( commandBuffer, srcBuffer, dst, 1, &region );
+
+	BufferHandoff handoff;
+	handoff.buffer = dst;
+	handoff.offset = dstOffset;
+	handoff.size = size;
+	handoff.src = QueueType::Transfer;
+	handoff.dst = QueueType::Graphics;
+	handoff.dstStage = dstStage;
+	handoff.dstAccess = dstAccess;
+	queues->Release( commandBuffer, handoff );
+
+	pending.buffers.push_back( handoff );
+	pending.waitStage |= dstStage;
+	pendingBytes += size;
+	++pendingCopies;
+}
+
+void UploadManager::UploadImage( VkImage dst, const VkImageSubresourceLayers& subresource, VkExtent3D extent, const void* data, VkDeviceSize size,
+	VkImageLayout finalLayout, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	VkCommandBuffer commandBuffer = OpenBatch();
+
+	VkBuffer srcBuffer;
+	VkDeviceSize srcOffset;
+	std::memcpy( Stage( size, 16, srcBuffer, srcOffset ), data, static_cast<size_t>( size ) );
+
+	const VkImageSubresourceRange range{ subresource.aspectMask, subresource.mipLevel, 1, subresource.baseArrayLayer, subresource.layerCount };
+
+	// isi lama tidak dipakai, jadi boleh dari UNDEFINED
+	VkImageMemoryBarrier toTransfer{};
+	toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	toTransfer.srcAccessMask = 0;
+	toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	toTransfer.image = dst;
+	toTransfer.subresourceRange = range;
+	vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0, 0, nullptr, 0, nullptr, 1, &toTransfer );
+
+	VkBufferImageCopy region{};
+	region.bufferOffset = srcOffset;
+	region.imageSubresource = subresource;
+	region.imageOffset = { 0, 0, 0 };
+	region.imageExtent = extent;
+	vkCmdCopyBufferToImage( commandBuffer, srcBuffer, dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region );
+
+	ImageHandoff handoff;
+	handoff.image = dst;
+	handoff.range = range;
+	handoff.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	handoff.newLayout = finalLayout;
+	handoff.src = QueueType::Transfer;
+	handoff.dst = QueueType::Graphics;
+	handoff.dstStage = dstStage;
+	handoff.dstAccess = dstAccess;
+	queues->Release( commandBuffer, handoff );
+
+	pending.images.push_back( handoff );
+	pending.waitStage |= dstStage;
+	pendingBytes += size;
+	++pendingCopies;
+}
+
+UploadBatch UploadManager::Flush()
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	stats.frameBytes = pendingBytes;
+	stats.frameCopies = pendingCopies;
+	stats.peakFrameBytes = std::max( stats.peakFrameBytes, pendingBytes );
+	stats.totalBytes += pendingBytes;
+	pendingBytes = 0;
+	pendingCopies = 0;
+
+	Reclaim( false );
+
+	if( openSlot < 0 )
+		return UploadBatch{};
+
+	BatchSlot& slot = slots[openSlot];
+	if( vkEndCommandBuffer( slot.commandBuffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to record upload command buffer!" );
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &slot.commandBuffer;
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores = &slot.semaphore;
+
+	vkResetFences( device, 1, &slot.fence );
+	queues->Submit( QueueType::Transfer, submitInfo, slot.fence );
+
+	slot.ringEnd = ringHead;
+	slot.inFlight = true;
+	inFlightSlots.push_back( static_cast<uint32_t>( openSlot ) );
+	openSlot = -1;
+	++stats.batchCount;
+
+	UploadBatch batch = std::move( pending );
+	batch.semaphore = slot.semaphore;
+	pending = UploadBatch{};
+	return batch;
+}
+
+void UploadManager::RecordAcquire( VkCommandBuffer commandBuffer, const UploadBatch& batch ) const
+{
+	for( const auto& handoff : batch.buffers )
+		queues->Acquire( commandBuffer, handoff );
+	for( const auto& handoff : batch.images )
+		queues->Acquire( commandBuffer, handoff );
+}
+
+UploadStats UploadManager::GetStats()
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	return stats;
+}
+
+void UploadManager::PrintStats( std::ostream& out )
+{
+	const UploadStats s = GetStats();
+	out << "uploads: " << s.totalBytes / 1024 << " KiB in " << s.batchCount << " batches, last frame "
+		<< s.frameBytes / 1024 << " KiB / " << s.frameCopies << " copies (peak " << s.peakFrameBytes / 1024 << " KiB), "
+		<< s.stallCount << " stalls, " << s.oversizedCount << " oversized" << std::endl;
+}
+
+void* UploadManager::Stage( VkDeviceSize size, VkDeviceSize alignment, VkBuffer& srcBuffer, VkDeviceSize& srcOffset )
+{
+	// Lewat ring
+	// ----------
+	if( size <= ringSize / 4 )
+	{
+		bool waited = false;
+		for( ;; )
+		{
+			uint64_t position = AlignUp( ringHead, alignment );
+			// tidak boleh nyambung melewati ujung ring, loncat ke awal
+			if( position % ringSize + size > ringSize )
+				position = AlignUp( position, ringSize );
+
+			if( position + size - ringTail <= ringSize )
+			{
+				ringHead = position + size;
+				srcBuffer = ringBuffer;
+				srcOffset = position % ringSize;
+				return static_cast<char*>( ringAllocation.mapped ) + srcOffset;
+			}
+
+			// ring penuh: ambil dulu yang sudah selesai, kalau belum ada baru tunggu batch paling lama
+			if( inFlightSlots.empty() )
+				break;	// sisanya dipegang batch yang sedang di-record
+			Reclaim( waited );
+			waited = true;
+		}
+	}
+	// ----------
+
+	// Terlalu besar (atau ring penuh oleh batch ini sendiri): staging buffer sendiri
+	// -------------------------------------------------------------------------------
+	StagingBuffer staging;
+
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = size;
+	bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	if( vkCreateBuffer( device, &bufferInfo, HostAllocator::Callbacks(), &staging.buffer ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to create oversized staging buffer!" );
+	staging.allocation = allocator->AllocateForBuffer( staging.buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+
+	slots[openSlot].oversized.push_back( staging );
+	++stats.oversizedCount;
+
+	srcBuffer = staging.buffer;
+	srcOffset = 0;
+	return staging.allocation.mapped;
+	// -------------------------------------------------------------------------------
+}
+
+VkCommandBuffer UploadManager::OpenBatch()
+{
+	if( openSlot >= 0 )
+		return slots[openSlot].commandBuffer;
+
+	// slot dipakai bergiliran, jadi slot berikutnya selalu batch paling lama yang masih in flight
+	while( slots[nextSlot].inFlight )
+		Reclaim( true );
+
+	openSlot = static_cast<int32_t>( nextSlot );
+	nextSlot = ( nextSlot + 1 ) % BatchSlotCount;
+
+	BatchSlot& slot = slots[openSlot];
+	vkResetCommandBuffer( slot.commandBuffer, 0 );
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	if( vkBeginCommandBuffer( slot.commandBuffer, &beginInfo ) != VK_SUCCESS )
+		throw std::runtime_error( "Failed to begin upload command buffer!" );
+
+	return slot.commandBuffer;
+}
+
+void UploadManager::Reclaim( bool waitOldest )
+{
+	while( !inFlightSlots.empty() )
+	{
+		BatchSlot& slot = slots[inFlightSlots.front()];
+		if( waitOldest )
+		{
+			vkWaitForFences( device, 1, &slot.fence, VK_TRUE, UINT64_MAX );
+			++stats.stallCount;
+			waitOldest = false;
+		}
+		else if( vkGetFenceStatus( device, slot.fence ) != VK_SUCCESS )
+			break;
+
+		ringTail = slot.ringEnd;
+		for( auto& staging : slot.oversized )
+		{
+			vkDestroyBuffer( device, staging.buffer, HostAllocator::Callbacks() );
+			allocator->Free( staging.allocation );
+		}
+		slot.oversized.clear();
+		slot.inFlight = false;
+		inFlightSlots.pop_front();
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "DeviceAllocator.h"
+#include "GpuQueues.h"
+
+// Hasil Flush(): submit graphics berikutnya harus menunggu semaphore ini di waitStage
+// dan me-record RecordAcquire() sebelum resource nya dipakai.
+struct UploadBatch
+{
+	VkSemaphore semaphore = VK_NULL_HANDLE;		// VK_NULL_HANDLE = tidak ada upload
+	VkPipelineStageFlags waitStage = 0;
+	std::vector<BufferHandoff> buffers;
+	std::vector<ImageHandoff> images;
+};
+
+struct UploadStats
+{
+	uint64_t frameBytes = 0;				// byte yang di-upload di frame terakhir yang di-flush
+	uint64_t peakFrameBytes = 0;
+	uint64_t totalBytes = 0;
+	uint32_t frameCopies = 0;
+	uint64_t batchCount = 0;
+	uint64_t stallCount = 0;				// berapa kali CPU harus menunggu fence transfer
+	uint64_t oversizedCount = 0;			// upload yang tidak lewat ring (dedicated staging buffer)
+};
+
+// Streaming upload lewat satu staging ring buffer yang persistently mapped.
+// Semua copy dalam satu frame masuk ke satu command buffer di transfer queue,
+// space ring dikembalikan begitu fence batch tsb signaled.
+class UploadManager
+{
+public:
+	void Init( VkDevice device, DeviceAllocator& allocator, GpuQueues& queues, VkDeviceSize ringSize = 32ULL << 20 );
+	void CleanUp();
+
+	// data di-copy ke ring saat itu juga, pointer boleh langsung dibuang setelah return
+	void UploadBuffer( VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size,
+		VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+		VkAccessFlags dstAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT );
+	// isi seluruh subresource (mip/layer) sekaligus, layout lama nya dibuang
+	void UploadImage( VkImage dst, const VkImageSubresourceLayers& subresource, VkExtent3D extent, const void* data, VkDeviceSize size,
+		VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		VkAccessFlags dstAccess = VK_ACCESS_SHADER_READ_BIT );
+
+	// submit semua copy yang terkumpul (sekali per frame)
+	UploadBatch Flush();
+	void RecordAcquire( VkCommandBuffer commandBuffer, const UploadBatch& batch ) const;
+
+	UploadStats GetStats();
+	void PrintStats( std::ostream& out );
+
+private:
+	struct StagingBuffer
+	{
+		VkBuffer buffer = VK_NULL_HANDLE;
+		DeviceAllocation allocation;
+	};
+
+	struct BatchSlot
+	{
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE;
+		VkSemaphore semaphore = VK_NULL_HANDLE;
+		uint64_t ringEnd = 0;					// posisi head ring saat batch ini di-submit
+		std::vector<StagingBuffer> oversized;	// dibuang setelah fence signaled
+		bool inFlight = false;
+	};
+
+	// return pointer mapped + buffer/offset sumber copy
+	void* Stage( VkDeviceSize size, VkDeviceSize alignment, VkBuffer& srcBuffer, VkDeviceSize& srcOffset );
+	VkCommandBuffer OpenBatch();
+	void Reclaim( bool waitOldest );
+
+private:
+	static constexpr uint32_t BatchSlotCount = 4;
+
+	VkDevice device = VK_NULL_HANDLE;
+	DeviceAllocator* allocator = nullptr;
+	GpuQueues* queues = nullptr;
+
+	std::mutex mutex;
+
+	// --- RING ---
+	// head/tail naik terus (tidak di-modulo), posisi fisik = pos % ringSize
+	VkBuffer ringBuffer = VK_NULL_HANDLE;
+	DeviceAllocation ringAllocation;
+	VkDeviceSize ringSize = 0;
+	uint64_t ringHead = 0;
+	uint64_t ringTail = 0;
+	// ------------
+
+	VkCommandPool commandPool = VK_NULL_HANDLE;
+	BatchSlot slots[BatchSlotCount];
+	uint32_t nextSlot = 0;
+	int32_t openSlot = -1;
+	std::deque<uint32_t> inFlightSlots;		// urut sesuai submit
+	UploadBatch pending;
+	uint64_t pendingBytes = 0;
+	uint32_t pendingCopies = 0;
+
+	UploadStats stats;
+};
@@ -0,0 +1,251 @@
+#include "ValidationSink.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "CpuTrace.h"
+
+namespace
+{
+	const char* SeverityName( VkDebugUtilsMessageSeverityFlagBitsEXT severity )
+	{
+		switch( severity )
+		{
+		case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT: return "error";
+		case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT: return "warning";
+		case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT: return "info";
+		default: return "verbose";
+		}
+	}
+
+	const char* TypeName( VkDebugUtilsMessageTypeFlagsEXT types )
+	{
+		if( types & VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT )
+			return "validation";
+		if( types & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT )
+			return "performance";
+		return "general";
+	}
+
+	// strncpy yang selalu null-terminated, true = dipotong
+	bool CopyText( char* destination, size_t capacity, const char* source )
+	{
+		if( source == nullptr )
+		{
+			destination[0] = '\0';
+			return false;
+		}
+		const size_t length = std::strlen( source );
+		const size_t copied = std::min( length, capacity - 1 );
+		std::memcpy( destination, source, copied );
+		destination[copied] = '\0';
+		return copied < length;
+	}
+
+	template<typename Flags>
+	Flags ParseFlagList( const std::string& list, const char* option, const std::vector<std::pair<const char*, Flags>>& names )
+	{
+		Flags flags = 0;
+		std::istringstream in( list );
+		std::string name;
+		while( std::getline( in, name, ',' ) )
+		{
+			const auto found = std::find_if( names.begin(), names.end(), [&name]( const auto& entry ) { return name == entry.first; } );
+			if( found == names.end() )
+				throw std::runtime_error( std::string( "Unknown value for " ) + option + ": " + name );
+			flags |= found->second;
+		}
+		return flags;
+	}
+}
+
+ValidationSink::~ValidationSink()
+{
+	CleanUp();
+}
+
+void ValidationSink::Init( VkDebugUtilsMessageSeverityFlagsEXT severities, VkDebugUtilsMessageTypeFlagsEXT types, uint32_t repeatLimit )
+{
+	this->severities = severities;
+	this->types = types;
+	this->repeatLimit = repeatLimit;
+
+	slots = std::make_unique<Slot[]>( SlotCount );
+	for( uint32_t i = 0; i < SlotCount; ++i )
+		slots[i].sequence.store( i, std::memory_order_relaxed );
+	writeCursor.store( 0, std::memory_order_relaxed );
+	readCursor = 0;
+	dropped.store( 0, std::memory_order_relaxed );
+	stopping.store( false, std::memory_order_relaxed );
+	state = State();
+	writer = std::thread( [this] { WriterLoop(); } );
+}
+
+void ValidationSink::PopulateCreateInfo( VkDebugUtilsMessengerCreateInfoEXT& createInfo )
+{
+	createInfo = {};
+	createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+	createInfo.messageSeverity = severities;
+	createInfo.messageType = types;
+	createInfo.pfnUserCallback = Callback;
+	createInfo.pUserData = this;
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL ValidationSink::Callback(
+	VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+	VkDebugUtilsMessageTypeFlagsEXT types,
+	const VkDebugUtilsMessengerCallbackDataEXT* callbackData,
+	void* userData )
+{
+	static_cast<ValidationSink*>( userData )->Push( severity, types, *callbackData );
+	// VK_FALSE: call Vulkan yang memicu pesan tetap dijalankan
+	return VK_FALSE;
+}
+
+void ValidationSink::Push( VkDebugUtilsMessageSeverityFlagBitsEXT severity, VkDebugUtilsMessageTypeFlagsEXT types, const VkDebugUtilsMessengerCallbackDataEXT& data )
+{
+	// klaim slot: sequence == cursor berarti slot kosong untuk putaran ini
+	uint64_t cursor = writeCursor.load( std::memory_order_relaxed );
+	Slot* slot = nullptr;
+	for( ;; )
+	{
+		slot = &slots[cursor & ( SlotCount - 1 )];
+		const uint64_t sequence = slot->sequence.load( std::memory_order_acquire );
+		if( sequence == cursor )
+		{
+			if( writeCursor.compare_exchange_weak( cursor, cursor + 1, std::memory_order_relaxed ) )
+				break;
+		}
+		else if( sequence < cursor )
+		{
+			// writer thread belum membaca slot ini dari putaran sebelumnya: ring penuh
+			dropped.fetch_add( 1, std::memory_order_relaxed );
+			return;
+		}
+		else
+			cursor = writeCursor.load( std::memory_order_relaxed );
+	}
+
+	slot->severity = severity;
+	slot->types = types;
+	slot->messageId = data.messageIdNumber;
+	CopyText( slot->idName, MaxIdNameLength, data.pMessageIdName );
+	slot->truncated = CopyText( slot->message, MaxMessageLength, data.pMessage );
+	slot->sequence.store( cursor + 1, std::memory_order_release );
+}
+
+void ValidationSink::WriterLoop()
+{
+	if( CpuTrace::IsEnabled() )
+		CpuTrace::SetThreadName( "validation sink" );
+
+	std::string line;
+	for( ;; )
+	{
+		// stopping dibaca sebelum drain: semua pesan sebelum CleanUp() pasti sudah ada di ring
+		const bool stop = stopping.load( std::memory_order_acquire );
+		bool wrote = false;
+		for( ;; )
+		{
+			Slot& slot = slots[readCursor & ( SlotCount - 1 )];
+			if( slot.sequence.load( std::memory_order_acquire ) != readCursor + 1 )
+				break;
+
+			++state.received;
+			state.truncated += slot.truncated ? 1 : 0;
+			std::string key = std::to_string( slot.messageId ) + slot.idName;
+			auto& entry = state.messages[key];
+			if( entry.count == 0 )
+			{
+				entry.idName = slot.idName;
+				entry.severity = slot.severity;
+				entry.types = slot.types;
+			}
+			++entry.count;
+
+			if( entry.count <= repeatLimit )
+			{
+				line = "validation layer [";
+				line += SeverityName( slot.severity );
+				line += " ";
+				line += TypeName( slot.types );
+				line += "]: ";
+				line += slot.message;
+				if( slot.truncated )
+					line += " [...]";
+				if( entry.count == repeatLimit )
+					line += "\n  (repeated messages with this id are only counted from now on, see the summary at exit)";
+				line += '\n';
+				std::cerr << line;
+				++state.written;
+				wrote = true;
+			}
+
+			// slot kosong lagi untuk putaran berikutnya
+			slot.sequence.store( readCursor + SlotCount, std::memory_order_release );
+			++readCursor;
+		}
+		// satu flush per batch, bukan std::endl per pesan
+		if( wrote )
+			std::cerr.flush();
+		if( stop )
+			break;
+		std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+	}
+}
+
+void ValidationSink::CleanUp()
+{
+	if( !writer.joinable() )
+		return;
+	stopping.store( true, std::memory_order_release );
+	writer.join();
+
+	const uint64_t droppedCount = dropped.load( std::memory_order_relaxed );
+	if( state.received == 0 && droppedCount == 0 )
+		return;
+
+	std::vector<const State::Entry*> sorted;
+	sorted.reserve( state.messages.size() );
+	for( const auto& message : state.messages )
+		sorted.push_back( &message.second );
+	std::sort( sorted.begin(), sorted.end(), []( const State::Entry* a, const State::Entry* b ) { return a->count > b->count; } );
+
+	std::cerr << "validation layer summary: " << state.received << " messages, " << sorted.size() << " unique, "
+		<< state.received - state.written << " suppressed as repeats, " << droppedCount << " dropped (ring full), "
+		<< state.truncated << " truncated" << std::endl;
+	constexpr size_t MaxListed = 20;
+	for( size_t i = 0; i < std::min( sorted.size(), MaxListed ); ++i )
+	{
+		std::cerr << "  " << sorted[i]->count << "x [" << SeverityName( sorted[i]->severity ) << " " << TypeName( sorted[i]->types ) << "] "
+			<< ( sorted[i]->idName.empty() ? "(no id)" : sorted[i]->idName ) << std::endl;
+	}
+	if( sorted.size() > MaxListed )
+		std::cerr << "  ... " << sorted.size() - MaxListed << " more" << std::endl;
+
+	slots.reset();
+	state = State();
+}
+
+VkDebugUtilsMessageSeverityFlagsEXT ParseValidationSeverities( const std::string& list )
+{
+	return ParseFlagList<VkDebugUtilsMessageSeverityFlagsEXT>( list, "--validation-severity", {
+		{ "error", VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT },
+		{ "warning", VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT },
+		{ "info", VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT },
+		{ "verbose", VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT }
+	} );
+}
+
+VkDebugUtilsMessageTypeFlagsEXT ParseValidationTypes( const std::string& list )
+{
+	return ParseFlagList<VkDebugUtilsMessageTypeFlagsEXT>( list, "--validation-types", {
+		{ "general", VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT },
+		{ "validation", VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT },
+		{ "performance", VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT }
+	} );
+}
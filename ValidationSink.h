@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Sink pesan validation layer. Callback nya (bisa dari thread mana saja, di tengah vkCmd* / vkQueueSubmit)
+// cuma copy pesan ke ring MPSC fixed-size tanpa lock lalu return; thread background yang memformat,
+// de-dup per messageIdNumber dan menulis ke std::cerr. Ring penuh = pesan dibuang (dihitung), callback tidak pernah menunggu.
+// Filter severity / type dipasang di VkDebugUtilsMessengerCreateInfoEXT, jadi yang tidak diminta tidak memanggil callback sama sekali.
+class ValidationSink
+{
+public:
+	ValidationSink() = default;
+	ValidationSink( const ValidationSink& ) = delete;
+	ValidationSink& operator=( const ValidationSink& ) = delete;
+	// kalau CleanUp() tidak sempat dipanggil (exception saat init), thread nya tetap di-join
+	~ValidationSink();
+
+	// repeatLimit = pesan dengan messageIdNumber yang sama ditulis sekian kali, sisanya cuma dihitung (lihat summary)
+	void Init( VkDebugUtilsMessageSeverityFlagsEXT severities, VkDebugUtilsMessageTypeFlagsEXT types, uint32_t repeatLimit );
+	// dipakai buat vkCreateInstance (pNext) dan messenger nya, pUserData = sink ini
+	void PopulateCreateInfo( VkDebugUtilsMessengerCreateInfoEXT& createInfo );
+	// setelah messenger dan instance di-destroy: sisa ring ditulis, thread berhenti, summary di-print
+	void CleanUp();
+
+private:
+	static VKAPI_ATTR VkBool32 VKAPI_CALL Callback(
+		VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+		VkDebugUtilsMessageTypeFlagsEXT types,
+		const VkDebugUtilsMessengerCallbackDataEXT* callbackData,
+		void* userData
+	);
+	void Push( VkDebugUtilsMessageSeverityFlagBitsEXT severity, VkDebugUtilsMessageTypeFlagsEXT types, const VkDebugUtilsMessengerCallbackDataEXT& data );
+	void WriterLoop();
+
+private:
+	static constexpr uint32_t SlotCount = 512;		// pangkat 2
+	static constexpr size_t MaxIdNameLength = 96;
+	static constexpr size_t MaxMessageLength = 2048;	// lebih panjang dipotong
+
+	// ring bounded Vyukov: sequence per slot menandai slot kosong / sudah diisi
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence{ 0 };
+		VkDebugUtilsMessageSeverityFlagBitsEXT severity;
+		VkDebugUtilsMessageTypeFlagsEXT types;
+		int32_t messageId;
+		bool truncated;
+		char idName[MaxIdNameLength];
+		char message[MaxMessageLength];
+	};
+
+	// cuma disentuh writer thread (dan CleanUp setelah join).
+	// messageIdNumber tidak unik untuk pesan general loader (sering 0), jadi key nya id + nama
+	struct State
+	{
+	public:
+		struct Entry
+		{
+		public:
+			std::string idName;
+			VkDebugUtilsMessageSeverityFlagBitsEXT severity;
+			VkDebugUtilsMessageTypeFlagsEXT types;
+			uint64_t count = 0;
+		};
+		std::unordered_map<std::string, Entry> messages;
+		uint64_t received = 0;
+		uint64_t written = 0;
+		uint64_t truncated = 0;
+	};
+
+	VkDebugUtilsMessageSeverityFlagsEXT severities = 0;
+	VkDebugUtilsMessageTypeFlagsEXT types = 0;
+	uint32_t repeatLimit = 1;
+
+	std::unique_ptr<Slot[]> slots;
+	alignas( 64 ) std::atomic<uint64_t> writeCursor{ 0 };		// producer (thread mana saja)
+	alignas( 64 ) uint64_t readCursor = 0;						// cuma writer thread
+	std::atomic<uint64_t> dropped{ 0 };
+	std::atomic<bool> stopping{ false };
+	State state;
+	std::thread writer;
+};
+
+// "error,warning,info,verbose" -> VkDebugUtilsMessageSeverityFlagsEXT
+VkDebugUtilsMessageSeverityFlagsEXT ParseValidationSeverities( const std::string& list );
+// "general,validation,performance" -> VkDebugUtilsMessageTypeFlagsEXT
+VkDebugUtilsMessageTypeFlagsEXT ParseValidationTypes( const std::string& list );
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <vector>
+
+// binding 0: per vertex, binding 1: per instance (lihat Shaders/shader.vert, --mesh: Shaders/mesh.vert + MeshFile)
+struct Vertex
+{
+public:
+	float position[2];
+	float color[3];
+};
+
+struct InstanceData
+{
+public:
+	float offset[2];
+	float scale;
+};
+
+struct VertexLayout
+{
+public:
+	static std::vector<VkVertexInputBindingDescription> Bindings()
+	{
+		return {
+			{ 0, sizeof( Vertex ), VK_VERTEX_INPUT_RATE_VERTEX },
+			{ 1, sizeof( InstanceData ), VK_VERTEX_INPUT_RATE_INSTANCE }
+		};
+	}
+	static std::vector<VkVertexInputAttributeDescription> Attributes()
+	{
+		std::vector<VkVertexInputAttributeDescription> attributes = {
+			{ 0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof( Vertex, position ) },
+			{ 1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof( Vertex, color ) }
+		};
+		const auto instance = InstanceAttributes( 2 );
+		attributes.insert( attributes.end(), instance.begin(), instance.end() );
+		return attributes;
+	}
+	// binding 1, mulai dari location firstLocation (mesh dari file punya lebih banyak attribute per vertex)
+	static std::vector<VkVertexInputAttributeDescription> InstanceAttributes( uint32_t firstLocation )
+	{
+		return {
+			{ firstLocation, 1, VK_FORMAT_R32G32_SFLOAT, offsetof( InstanceData, offset ) },
+			{ firstLocation + 1, 1, VK_FORMAT_R32_SFLOAT, offsetof( InstanceData, scale ) }
+		};
+	}
+};